@@ -25,6 +25,11 @@
 #include <mpi.h>
 #endif
 
+// include OpenMP
+#ifdef HAVE_OPENMP
+#include <omp.h>
+#endif
+
 // Python includes.  Must come first to avoid _POSIX_C_SOURCE warning.
 #ifdef HAVE_PYTHON
 // #undef _POSIX_C_SOURCE
@@ -173,6 +178,22 @@ void readPython(std::string& inFileName,
  */
 bool showInfoArgs(PolyswiftCmdLineArgs& cla);
 
+/**
+ * Set attributes, build and then initialize or restore one domain
+ *
+ * @param dom the domain
+ * @param attribs the attribute set for the domain
+ * @param restoreDump dump to restore from, 0 to initialize
+ * @param runName output file prefix for the domain
+ * @return PS_OK or the error to quit with
+ */
+PS_ERR setupDomain(PsDomainBase* dom, const TxHierAttribSetIntDbl& attribs,
+                   int restoreDump, const std::string& runName);
+
+/** Check for an <Updater> of the given kind in any <EffHamil> block */
+bool hasUpdaterKind(const TxHierAttribSetIntDbl& attribs,
+                    const std::string& kind);
+
 /** Parse info needed for internal txpp */
 // Need:  myRank, execFullPath global
 void runInternalTxpp(PolyswiftCmdLineArgs& cla, std::string& fileName);
@@ -200,12 +221,25 @@ int main(int argc, char** argv) {
   int numRanks = 1;
 
 #ifdef HAVE_MPI
-  MPI_Init(&argc, &argv);
+  // Threaded FFTs and field loops only call MPI from the main thread
+  int mpiThreadLevel = MPI_THREAD_SINGLE;
+  MPI_Init_thread(&argc, &argv, MPI_THREAD_FUNNELED, &mpiThreadLevel);
   MPI_Comm_rank(MPI_COMM_WORLD, &myRank);
   MPI_Comm_size(MPI_COMM_WORLD, &numRanks);
   if (myRank == 0) {
     std::cout << "Using MPI" << std::endl;
     std::cout << "Called MPI_INIT and MPI_Comm_rank" << std::endl;
+    if (mpiThreadLevel < MPI_THREAD_FUNNELED) {
+      std::cout << "MPI library does not support MPI_THREAD_FUNNELED,";
+      std::cout << " use one thread per rank" << std::endl;
+    }
+  }
+#endif
+
+#ifdef HAVE_OPENMP
+  if (myRank == 0) {
+    std::cout << "Using OpenMP with " << omp_get_max_threads();
+    std::cout << " threads per rank" << std::endl;
   }
 #endif
 
@@ -453,84 +487,75 @@ int main(int argc, char** argv) {
     }
   }
 
+// Number of independent replicas run by this process. They share
+// the singleton lists of polymers and boundaries, so particles
+// would see each other across replicas
+  size_t numReplicas = 1;
+  if (tha.hasOption("numReplicas")) {
+    int nrep = tha.getOption("numReplicas");
+    if (nrep > 1) numReplicas = (size_t)nrep;
+  }
+  if ( (numReplicas > 1) && (tha.getNamesOfType("Boundary").size() > 0) ) {
+    if (myRank == 0) {
+      std::cout << "\n numReplicas > 1 cannot be used with Boundary blocks"
+                << std::endl;
+    }
+    return quitPolyswift(PS_INPUT_ERR);
+  }
+
 /* ************************************** */
 /*    Begin accessing domain methods      */
 /* ************************************** */
 
-// Set domain attributes
+// Replicas are independent copies of the run stepped together in
+// this process, each with its own seed and output prefix. They use
+// the FFT objects of the first replica, so the plans, buffers and
+// k-space lists are made once. Box relaxation changes the cell sizes
+// of each replica, then every replica keeps its own FFT objects.
+  bool shareFFTs = (numReplicas > 1) && !hasUpdaterKind(tha, "boxRelax");
+  std::vector<PsDomainBase*> replicas;
+  replicas.push_back(domainPtr);
   try {
-    domainPtr->setAttrib(tha, restoreDump, outName);
-  } catch (TxDebugExcept& txde) {
+    for (size_t r=1; r<numReplicas; ++r) {
+      replicas.push_back(TxMakerMap<PsDomainBase>::getNew(domainKind));
+      if (shareFFTs) replicas[r]->shareFFTs(domainPtr);
+    }
+  } catch (TxDebugExcept& tde) {
     if (myRank == 0) {
-      std::cout << "\n setAttrib exception: " << std::endl;
-      std::cout << txde << std::endl;
+      std::cerr << "\n Unable to create replica domain. Exception was: " <<
+           tde << std::endl;
     }
     return quitPolyswift(PS_INPUT_ERR);
   }
 
-// Build steps
-  try {
-    domainPtr->buildData();
-  } catch (TxDebugExcept& txde) {
-    if (myRank == 0) {
-      std::cout << "\n buildData exception: " << std::endl;
-      std::cout << txde << std::endl;
+  for (size_t r=0; r<numReplicas; ++r) {
+
+    std::string runName = outName;
+    TxHierAttribSetIntDbl rtha = tha;
+    if (numReplicas > 1) {
+      std::ostringstream rstr;
+      rstr << outName << "_r" << r;
+      runName = rstr.str();
+      if (rtha.hasOption("randomSeed")) {
+        rtha.setOption("randomSeed", tha.getOption("randomSeed") + (int)r);
+      } else {
+        rtha.appendOption("randomSeed", (int)r);
+      }
     }
-    return quitPolyswift(PS_INPUT_ERR);
-  }
 
-  try {
-    domainPtr->buildSolvers();
-  } catch (TxDebugExcept& txde) {
-    if (myRank == 0) {
-      std::cout << "\n buildSolvers exception: " << std::endl;
-      std::cout << txde << std::endl;
+    PS_ERR setupErr = setupDomain(replicas[r], rtha, restoreDump, runName);
+    if (setupErr != PS_OK) {
+      return quitPolyswift(setupErr);
     }
-    return quitPolyswift(PS_INPUT_ERR);
   }
 
-// Initialize domain OR restore from last dump if necessary
   size_t timeStep = 0;
   if (restoreDump > 0) {
-
-// Restore the domain
-    try {
-      domainPtr->restore();
-    } catch (TxDebugExcept& txde) {
-      if (myRank == 0) {
-        std::cout << "Restore exception: \n " << std::endl;
-        std::cout << txde << std::endl;
-      }
-      delete domainPtr;
-      return quitPolyswift(PS_INPUT_ERR);
-    }
-
     timeStep = restoreDump;
-    std::cout << "check the timeStep = restoreDump " << std::endl;
-
     if (myRank == 0) {
       std::cout << "\n Restored all from dump "
                 << restoreDump << "\n" << std::endl;
     }
-  } else {    // if (restoreDump > 0)
-
-    if (myRank == 0) {
-      std::cout << "\n Initializing at start \n" << std::endl;
-    }
-
-// Initialize the domain
-    timeStep = 0;
-    try {
-      domainPtr->initialize();
-    } catch (TxDebugExcept& txde) {
-      if (myRank == 0) {
-        std::cout << "Initialize exception: \n" << std::endl;
-        std::cout << txde << std::endl;
-      }
-      delete domainPtr;
-      return quitPolyswift(PS_INPUT_ERR);
-    }
-
   }
 // *************************************************************************
 
@@ -541,51 +566,124 @@ int main(int argc, char** argv) {
   double totUpdateTime = 0.0;
   tmr.reset();
 
-  for (int i=0; i<nsteps; ++i) {
+// Parameter sweep: with one replica each point runs up to nsteps
+// from the fields of the previous point. With replicas, replica r
+// takes sweep point r and all points run together
+  size_t numSweepPoints = domainPtr->getNumSweepPoints();
+  size_t numRuns = 1;
+  if (numSweepPoints > 0) {
+    if (numReplicas == 1) {
+      numRuns = numSweepPoints;
+    } else if (numSweepPoints != numReplicas) {
+      if (myRank == 0) {
+        std::cout << "\n Number of sweep points " << numSweepPoints
+                  << " not equal to numReplicas " << numReplicas
+                  << std::endl;
+      }
+      return quitPolyswift(PS_INPUT_ERR);
+    }
+  }
 
-#ifdef HAVE_SECURITY
-    if (psObsLicStatusBad) {
-      if (!licenseErrorMessage.empty()) {
-        std::cerr << "Error with licensing. This run could not be validated.\n"
-           << licenseErrorMessage;
+// Each sweep point and each replica ends with a dump
+  bool finalDump = (numSweepPoints > 0) || (numReplicas > 1);
+  std::vector<bool> replicaDone(numReplicas, false);
+  std::vector<bool> lastDumped(numReplicas, false);
+
+  for (size_t ip=0; ip<numRuns; ++ip) {
+
+    if (numSweepPoints > 0) {
+      try {
+        for (size_t r=0; r<numReplicas; ++r) {
+          replicas[r]->setSweepPoint( (numReplicas > 1) ? r : ip );
+        }
+      } catch (TxDebugExcept& txde) {
+        if (myRank == 0) {
+          std::cout << "\n Sweep exception: \n" << txde << std::endl;
+        }
+        for (size_t r=numReplicas; r>0; --r) delete replicas[r-1];
+        return quitPolyswift(PS_INPUT_ERR);
       }
-      return quitPolyswift(PS_LICENSE_ERR);
     }
+    replicaDone.assign(numReplicas, false);
+    lastDumped.assign(numReplicas, false);
+    size_t numDone = 0;
+
+    for (int i=0; i<nsteps; ++i) {
+
+#ifdef HAVE_SECURITY
+      if (psObsLicStatusBad) {
+        if (!licenseErrorMessage.empty()) {
+          std::cerr << "Error with licensing. This run could not be validated.\n"
+             << licenseErrorMessage;
+        }
+        return quitPolyswift(PS_LICENSE_ERR);
+      }
 #endif
 
-    timeStep += 1;
+      timeStep += 1;
 
 // Print time step (1-10)-->prtPeriod
-    int prtTst = timeStep % prtPeriodicity;
+      int prtTst = timeStep % prtPeriodicity;
 // Check and dump the domain
-    int dmpTst = timeStep % dumpPeriodicity;
-    if ( (timeStep <= 10) && (myRank ==0) ) {
-      std::cout << "timeStep = " << timeStep << std::endl;
-    }
-    if ( (timeStep > 10) && (prtTst ==  0 ) && (myRank ==  0 ) ) {
-      std::cout << "timeStep = " << timeStep << std::endl;
-    }
+      int dmpTst = timeStep % dumpPeriodicity;
+      if ( (timeStep <= 10) && (myRank ==0) ) {
+        std::cout << "timeStep = " << timeStep << std::endl;
+      }
+      if ( (timeStep > 10) && (prtTst ==  0 ) && (myRank ==  0 ) ) {
+        std::cout << "timeStep = " << timeStep << std::endl;
+      }
+
+      for (size_t r=0; r<numReplicas; ++r) {
+
+        if (replicaDone[r]) continue;
 
 // Update the domain
-    try {
-      tmr.reset(); tmr.start();
-      domainPtr->update((double) timeStep);
-      tmr.stop();
-      totUpdateTime = totUpdateTime + tmr.getElapsedWallSec();
-    } catch (TxDebugExcept& txde) {
-      if (myRank == 0) {
-        std::cout << "\n Update exception: \n" << txde << std::endl;
-      }
-      delete domainPtr;
-      return quitPolyswift(PS_RUN_ERR);
-    }
+        try {
+          tmr.reset(); tmr.start();
+          replicas[r]->update((double) timeStep);
+          tmr.stop();
+          totUpdateTime = totUpdateTime + tmr.getElapsedWallSec();
+        } catch (TxDebugExcept& txde) {
+          if (myRank == 0) {
+            std::cout << "\n Update exception: \n" << txde << std::endl;
+          }
+          for (size_t n=numReplicas; n>0; --n) delete replicas[n-1];
+          return quitPolyswift(PS_RUN_ERR);
+        }
 
 // Dump data files
-    if (dmpTst == 0) {
-      domainPtr->dump();
+        if (dmpTst == 0) {
+          replicas[r]->dump();
+        }
+        lastDumped[r] = (dmpTst == 0);
+
+// Stop once self-consistent, final dump if not just taken
+        if (replicas[r]->isConverged()) {
+          if (myRank == 0) {
+            std::cout << "\n Converged at timeStep = " << timeStep;
+            if (numReplicas > 1) std::cout << " for replica " << r;
+            std::cout << " with residual = " << replicas[r]->getResidual()
+                      << std::endl;
+          }
+          if (dmpTst != 0) replicas[r]->dump();
+          lastDumped[r] = true;
+          replicaDone[r] = true;
+          ++numDone;
+        }
+
+      } // replicas Loop
+
+      if (numDone == numReplicas) break;
+
+    } // nsteps Loop
+
+    if (finalDump) {
+      for (size_t r=0; r<numReplicas; ++r) {
+        if (!lastDumped[r]) replicas[r]->dump();
+      }
     }
 
-  } // nsteps Loop
+  } // sweep points Loop
 // *****************************************************************
 
 // Gather timing data
@@ -604,6 +702,92 @@ int main(int argc, char** argv) {
   return quitPolyswift(PS_OK);
 }
 
+bool hasUpdaterKind(const TxHierAttribSetIntDbl& attribs,
+                    const std::string& kind) {
+
+  std::vector<std::string> ehNames = attribs.getNamesOfType("EffHamil");
+  for (size_t i=0; i<ehNames.size(); ++i) {
+    TxHierAttribSetIntDbl ehAttribs = attribs.getAttrib(ehNames[i]);
+    std::vector<std::string> updNames = ehAttribs.getNamesOfType("Updater");
+    for (size_t j=0; j<updNames.size(); ++j) {
+      TxHierAttribSetIntDbl updAttribs = ehAttribs.getAttrib(updNames[j]);
+      if (updAttribs.hasString("kind") &&
+          (updAttribs.getString("kind") == kind)) return true;
+    }
+  }
+  return false;
+}
+
+PS_ERR setupDomain(PsDomainBase* dom, const TxHierAttribSetIntDbl& attribs,
+                   int restoreDump, const std::string& runName) {
+
+// Set domain attributes
+  try {
+    dom->setAttrib(attribs, restoreDump, runName);
+  } catch (TxDebugExcept& txde) {
+    if (myRank == 0) {
+      std::cout << "\n setAttrib exception: " << std::endl;
+      std::cout << txde << std::endl;
+    }
+    return PS_INPUT_ERR;
+  }
+
+// Build steps
+  try {
+    dom->buildData();
+  } catch (TxDebugExcept& txde) {
+    if (myRank == 0) {
+      std::cout << "\n buildData exception: " << std::endl;
+      std::cout << txde << std::endl;
+    }
+    return PS_INPUT_ERR;
+  }
+
+  try {
+    dom->buildSolvers();
+  } catch (TxDebugExcept& txde) {
+    if (myRank == 0) {
+      std::cout << "\n buildSolvers exception: " << std::endl;
+      std::cout << txde << std::endl;
+    }
+    return PS_INPUT_ERR;
+  }
+
+// Initialize domain OR restore from last dump if necessary
+  if (restoreDump > 0) {
+
+// Restore the domain
+    try {
+      dom->restore();
+    } catch (TxDebugExcept& txde) {
+      if (myRank == 0) {
+        std::cout << "Restore exception: \n " << std::endl;
+        std::cout << txde << std::endl;
+      }
+      return PS_INPUT_ERR;
+    }
+  } else {    // if (restoreDump > 0)
+
+    if (myRank == 0) {
+      std::cout << "\n Initializing at start \n" << std::endl;
+    }
+
+// Initialize the domain
+    try {
+      dom->initialize();
+    } catch (TxDebugExcept& txde) {
+      if (myRank == 0) {
+        std::cout << "Initialize exception: \n" << std::endl;
+        std::cout << txde << std::endl;
+      }
+      return PS_INPUT_ERR;
+    }
+
+  }
+
+  return PS_OK;
+}
+
 void runInternalTxpp(PolyswiftCmdLineArgs& cla, std::string& fileName) {
 
 // Debug info flag
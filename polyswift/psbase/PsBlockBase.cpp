@@ -19,6 +19,7 @@
 #include <PsPolymer.h>
 
 #include <math.h>
+#include <typeinfo>
 
 // Constructor
 template <class FLOATTYPE, size_t NDIM>
@@ -45,6 +46,13 @@ PsBlockBase<FLOATTYPE, NDIM>::PsBlockBase() {
   qTailFinalSet   = 0;
 
   polymerObjPtr = NULL;
+
+  // Solved on the simulation grid unless set by container
+  groupGridPtr = NULL;
+  groupCommPtr = NULL;
+  groupWData = NULL;
+  groupWallVol = 0.0;
+  remote = false;
 }
 
 // Destructor
@@ -330,6 +338,15 @@ void PsBlockBase<FLOATTYPE, NDIM>::reset() {
 
   this->dbprt("PsBlockBase::reset() ");
 
+  // Remote block has nothing to solve here
+  if (remote) {
+    qHeadInitialSet = 1;
+    qTailInitialSet = 1;
+    qHeadFinalSet   = 1;
+    qTailFinalSet   = 1;
+    return;
+  }
+
   // Reset head/tail q values
   qHeadInitialSet = 0;
   qTailInitialSet = 0;
@@ -419,6 +436,37 @@ bool PsBlockBase<FLOATTYPE, NDIM>::isBlockUpdated() {
   return updated;
 }
 
+//
+// Propagators only depend on the model (derived type), the
+// contour discretization and the fields the block sees
+//
+template <class FLOATTYPE, size_t NDIM>
+bool PsBlockBase<FLOATTYPE, NDIM>::hasSameSolver(PsBlockBase<FLOATTYPE, NDIM>* mb) {
+
+  if (typeid(*this) != typeid(*mb)) return false;
+  if (ds != mb->ds) return false;
+
+  if (this->scfieldName != mb->scfieldName) return false;
+  if (this->hasChargeField != mb->hasChargeField) return false;
+  if (this->hasChargeField &&
+      this->chargefieldName != mb->chargefieldName) return false;
+
+  return true;
+}
+
+//
+// Same solver and same length
+//
+template <class FLOATTYPE, size_t NDIM>
+bool PsBlockBase<FLOATTYPE, NDIM>::isEquivalentTo(PsBlockBase<FLOATTYPE, NDIM>* mb) {
+
+  if (!hasSameSolver(mb)) return false;
+  if (blockSteps != mb->blockSteps) return false;
+  if (fabs(lengthFrac - mb->lengthFrac) > 1.0e-6) return false;
+
+  return true;
+}
+
 template <class FLOATTYPE, size_t NDIM>
 void PsBlockBase<FLOATTYPE, NDIM>::buildNameMap(std::vector<std::string> blockNames) {
   size_t numNames = blockNames.size();
@@ -116,6 +116,170 @@ class PsBlockBase : public virtual PsFunctionalQ<FLOATTYPE, NDIM> {
  */
     virtual void solveQ(BlockEndType solveFromEnd) = 0;
 
+/**
+ * Check if block can update forward/backward propagators
+ * together in one pass (see solveQPair)
+ *
+ * @return true if pair solve is available and requested
+ */
+    virtual bool canSolveQPair() {
+      return false;
+    }
+
+/**
+ * Update forward/backward propagators together, starting
+ * from both ends. Needs initial q set at head and tail.
+ * Default is separate solves from each end.
+ */
+    virtual void solveQPair() {
+      solveQ(HEAD);
+      solveQ(TAIL);
+    }
+
+/**
+ * Get the shared object (eg. FFT workspace) solveQ works in.
+ * Blocks returning the same pointer are never solved at the same
+ * time by the threaded block scheduler. Default is the block itself.
+ *
+ * @return pointer identifying the solve workspace
+ */
+    virtual const void* getSolveResource() {
+      return this;
+    }
+
+/**
+ * Give the block its own solve workspace so it can be solved
+ * concurrently with blocks sharing its solve resource. Default
+ * has nothing shared to separate.
+ *
+ * @return true if the block can be solved concurrently
+ */
+    virtual bool buildSolveWorkspace() {
+      return true;
+    }
+
+/**
+ * Check if block mb advances propagators the same way as this
+ * block: same model, contour step and fields, any length. Then
+ * propagators from the same initial q agree over the shorter length
+ *
+ * @param mb pointer to other block
+ * @return true if the blocks have the same contour solver
+ */
+    virtual bool hasSameSolver(PsBlockBase<FLOATTYPE, NDIM>* mb);
+
+/**
+ * Check if this block is equivalent to block mb: same solver
+ * (see hasSameSolver) and length, so propagators solved on either
+ * block from the same initial q are the same (mirror blocks,
+ * duplicate arms)
+ *
+ * @param mb pointer to other block
+ * @return true if the blocks are equivalent
+ */
+    virtual bool isEquivalentTo(PsBlockBase<FLOATTYPE, NDIM>* mb);
+
+/**
+ * Serve the tail-solved propagator of this block from the
+ * head-solved propagator of mirror block mb (NULL to unset).
+ * Default is not supported.
+ *
+ * @param mb pointer to mirror block
+ * @return true if mirror is set
+ */
+    virtual bool setMirror(PsBlockBase<FLOATTYPE, NDIM>* mb) {
+      return false;
+    }
+
+/**
+ * Set final q at head from the mirror block in place of solveQ(TAIL).
+ * Only called if setMirror succeeded.
+ */
+    virtual void setMirrorFinalQ() {
+      TxDebugExcept tde("PsBlockBase::setMirrorFinalQ: mirror not supported");
+      tde << " in <Block " << this->getName() << " >";
+      throw tde;
+    }
+
+/**
+ * Make this block a duplicate of the equivalent arm rb so it is
+ * never solved. Default is not supported.
+ *
+ * @param rb       pointer to representative block
+ * @param flipEnds true if this block's HEAD corresponds to rb's TAIL
+ * @return true if duplicate is set
+ */
+    virtual bool setDuplicateOf(PsBlockBase<FLOATTYPE, NDIM>* rb,
+                                bool flipEnds) {
+      return false;
+    }
+
+/**
+ * Set final q at end from the representative block.
+ * Only called if setDuplicateOf succeeded.
+ *
+ * @param end endtype of this block to set
+ */
+    virtual void copyDuplicateFinalQ(BlockEndType end) {
+      TxDebugExcept tde("PsBlockBase::copyDuplicateFinalQ: not supported");
+      tde << " in <Block " << this->getName() << " >";
+      throw tde;
+    }
+
+/**
+ * Make this block read its propagators off the longer block lb,
+ * which sees the same initial q at both ends, so this block is
+ * never solved. Default is not supported.
+ *
+ * @param lb pointer to longer block
+ * @return true if prefix is set
+ */
+    virtual bool setPrefixOf(PsBlockBase<FLOATTYPE, NDIM>* lb) {
+      return false;
+    }
+
+/**
+ * Set final q at both ends from the longer block's propagators.
+ * Only called if setPrefixOf succeeded.
+ */
+    virtual void setPrefixFinalQ() {
+      TxDebugExcept tde("PsBlockBase::setPrefixFinalQ: not supported");
+      tde << " in <Block " << this->getName() << " >";
+      throw tde;
+    }
+
+/**
+ * Also accumulate the box-length derivatives of log(bigQ) in
+ * setCalcQQTIntegral (see getStress). Default is not supported.
+ *
+ * @param cs true to accumulate
+ * @return true if supported by block model
+ */
+    virtual bool setCalcStress(bool cs) {
+      return false;
+    }
+
+/**
+ * Get this block's part of L_i d(log bigQ)/dL_i for each direction i
+ * of the box, from the last setCalcQQTIntegral with setCalcStress on
+ *
+ * @return vector of derivatives, one per grid direction
+ */
+    virtual std::vector<FLOATTYPE> getStress() {
+      TxDebugExcept tde("PsBlockBase::getStress: not supported");
+      tde << " in <Block " << this->getName() << " >";
+      throw tde;
+    }
+
+/**
+ * Rebuild k-space operators after the grid cell sizes changed
+ */
+    virtual void rebuildKSpace() {
+      TxDebugExcept tde("PsBlockBase::rebuildKSpace: not supported");
+      tde << " in <Block " << this->getName() << " >";
+      throw tde;
+    }
+
 /**
  * Integrate [ q(X,s)*qt(X,s) ds ] and set the
  * QTYPE qqtIntegral data member
@@ -137,6 +301,88 @@ class PsBlockBase : public virtual PsFunctionalQ<FLOATTYPE, NDIM> {
  */
     virtual void setPhysFields() = 0;
 
+/**
+ * Calculate the scaled monomer density of this block on its
+ * own grid from the qqtIntegral result
+ *
+ * @return density data
+ */
+    virtual const FLOATTYPE* calcDensity() = 0;
+
+/**
+ * Add a block density on the simulation grid to the held
+ * PhysFields, for blocks solved on a group grid whose densities
+ * are combined by the containing polymer (see setGroupGrid)
+ *
+ * @param densData local part of the block density
+ */
+    virtual void addDensity(const FLOATTYPE* densData) = 0;
+
+/**
+ * Solve this block on a grid replicated on the ranks of a group
+ * communicator instead of the simulation grid. Set by containers
+ * that split their blocks over groups of ranks, before buildData
+ *
+ * @param gridPtr replicated grid
+ * @param commPtr communicator of the group
+ */
+    virtual void setGroupGrid(PsGridBase<FLOATTYPE, NDIM>* gridPtr,
+                              PsCommBase<FLOATTYPE, NDIM>* commPtr) {
+      groupGridPtr = gridPtr;
+      groupCommPtr = commPtr;
+    }
+
+/**
+ * Set the whole-grid w-field and constraint volume for a block
+ * on a group grid, before each reset
+ *
+ * @param wData   conjugate field data of the monomer PhysField
+ * @param wallVol volume of the constraint field
+ */
+    void setGroupFields(const FLOATTYPE* wData, FLOATTYPE wallVol) {
+      groupWData = wData;
+      groupWallVol = wallVol;
+    }
+
+/**
+ * Get the grid the block is solved on
+ *
+ * @return group grid if set, else simulation grid
+ */
+    virtual PsGridBase<FLOATTYPE, NDIM>& getGridBase() {
+      if (groupGridPtr) return *groupGridPtr;
+      return PsDynObj<FLOATTYPE, NDIM>::getGridBase();
+    }
+
+/**
+ * Get the communicator the block sums over
+ *
+ * @return group communicator if set, else simulation communicator
+ */
+    virtual PsCommBase<FLOATTYPE, NDIM>& getCommBase() {
+      if (groupCommPtr) return *groupCommPtr;
+      return PsDynObj<FLOATTYPE, NDIM>::getCommBase();
+    }
+
+/**
+ * Mark a block solved by another group of ranks. A remote
+ * block has no propagator storage and counts as updated
+ *
+ * @param rem true if solved elsewhere
+ */
+    void setRemote(bool rem) {
+      remote = rem;
+    }
+
+/**
+ * Check if block is solved by another group of ranks
+ *
+ * @return true if remote
+ */
+    bool isRemote() {
+      return remote;
+    }
+
 /**
  * Set the name of the polymer in which this block is contained
  *
@@ -368,6 +614,41 @@ class PsBlockBase : public virtual PsFunctionalQ<FLOATTYPE, NDIM> {
     /** Polymer container object pointer */
     PsPolymer<FLOATTYPE, NDIM>* polymerObjPtr;
 
+/**
+ * Get the w-field data the block is solved in
+ *
+ * @return group w-field if set, else the monomer PhysField's
+ */
+    const FLOATTYPE* getConjgData() {
+      if (groupWData) return groupWData;
+      return this->monoDensPhysFldPtr->getConjgField().getConstDataPtr();
+    }
+
+/**
+ * Get the constraint volume on this rank for normalizations
+ *
+ * @return volume of the constraint field
+ */
+    FLOATTYPE getWallVolume() {
+      if (groupGridPtr) return groupWallVol;
+      return this->constraintFieldPtr->calcLocalVolume();
+    }
+
+    /** Replicated grid of the group solving this block (if set) */
+    PsGridBase<FLOATTYPE, NDIM>* groupGridPtr;
+
+    /** Communicator of the group solving this block (if set) */
+    PsCommBase<FLOATTYPE, NDIM>* groupCommPtr;
+
+    /** Whole-grid w-field for a block on a group grid */
+    const FLOATTYPE* groupWData;
+
+    /** Whole-grid constraint volume for a block on a group grid */
+    FLOATTYPE groupWallVol;
+
+    /** Flag for a block solved by another group of ranks */
+    bool remote;
+
 /**
  * Set the connected block head/tail lists and junction switches
  * This sets the length of the map junction switches. The derived
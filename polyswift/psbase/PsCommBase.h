@@ -127,6 +127,17 @@ class PsCommBase : public virtual PsDynObj<FLOATTYPE, NDIM> {
  */
     virtual size_t getComm() const = 0;
 
+/**
+ * Make a communicator for the ranks of this one that pass the
+ * same color, eg. for groups of ranks that work on independent
+ * parts of a calculation and combine results with this one.
+ * Ranks keep their relative order in the new communicator.
+ *
+ * @param color group of this rank
+ * @return new communicator (owned by caller)
+ */
+    virtual PsCommBase<FLOATTYPE, NDIM>* split(size_t color) const = 0;
+
 /**
  * Wait for all processes to check in.
  *
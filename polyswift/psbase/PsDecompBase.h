@@ -99,6 +99,26 @@ class PsDecompBase : public virtual PsDynObj<FLOATTYPE, NDIM> {
  */
     virtual bool hasPosition(PsTinyVector<int, NDIM> globalPos) = 0;
 
+/**
+ * Check if the local domain is the transposed (y-slab) layout
+ * of transposed-order FFT results
+ *
+ * @return true if transposed
+ */
+    virtual bool isTransposed() {
+      return false;
+    }
+
+/**
+ * Check if every rank holds the whole grid, for work split over
+ * groups of ranks that each solve on a full copy of the grid
+ *
+ * @return true if replicated
+ */
+    virtual bool isReplicated() {
+      return false;
+    }
+
   protected:
 
   private:
@@ -103,6 +103,19 @@ class PsDynObj : public PsDynObjBase , public PsNamedObject {
  */
     virtual void update(double time) {};
 
+/**
+ * Set a parameter between the points of a parameter sweep,
+ * objects without parameters that can be swept throw
+ *
+ * @param paramName name of the parameter in the input block
+ * @param val the new value
+ */
+    virtual void setSweepParam(const std::string& paramName, FLOATTYPE val) {
+      TxDebugExcept tde("PsDynObj::setSweepParam: ");
+      tde << paramName << " cannot be swept in <" << this->getName() << " >";
+      throw tde;
+    }
+
 /**
  * assigment
  *
@@ -58,4 +58,5 @@ void PsDynObjBase::setAttrib(const TxHierAttribSetIntDbl& tas) {
 //
 size_t PsDynObjBase::currDomainStep;
 size_t PsDynObjBase::totNumDomainStep;
+size_t PsDynObjBase::restoreRefine = 1;
 
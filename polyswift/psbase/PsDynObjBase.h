@@ -141,6 +141,20 @@ class PsDynObjBase {
       currDomainStep = currDomainStep + 1;
     }
 
+/**
+ * Get grid refinement factor of restore data (1 for same grid)
+ */
+    static size_t getRestoreRefine() {
+      return restoreRefine;
+    }
+
+/**
+ * Set grid refinement factor of restore data
+ */
+    static void setRestoreRefine(size_t rf) {
+      restoreRefine = rf;
+    }
+
   protected:
 
   private:
@@ -154,6 +168,9 @@ class PsDynObjBase {
 /// The total number of update steps for the domain during this sim
     static size_t totNumDomainStep;
 
+/// Ratio of domain cells to cells in the restore data, per direction
+    static size_t restoreRefine;
+
 /// The settings for this object
     TxHierAttribSetIntDbl settings;
 
@@ -78,6 +78,18 @@ class PsEffHamilBase : public PsDynObj<FLOATTYPE, NDIM> {
  */
     virtual void dump() = 0;
 
+/**
+ * Get largest residual of the held updaters from the last update
+ */
+    virtual FLOATTYPE getResidual() {
+      return 0.0;
+    }
+
+/**
+ * Forget the iterates of the held updaters
+ */
+    virtual void resetHistory() {}
+
   protected:
 
   private:
@@ -41,6 +41,244 @@ void PsFFTBase<FLOATTYPE, NDIM>::setAttrib(const TxHierAttribSetIntDbl& tas) {
 
 }
 
+//
+// Map entries are never moved, so the pointers stay valid
+//
+template <class FLOATTYPE, size_t NDIM>
+FLOATTYPE* PsFFTBase<FLOATTYPE, NDIM>::getKTable(const std::string& key,
+    bool& isNew) {
+
+  typename std::map< std::string, std::vector<FLOATTYPE> >::iterator it =
+    kTables.find(key);
+  isNew = (it == kTables.end());
+  if (isNew) {
+    it = kTables.insert(std::make_pair(key,
+        std::vector<FLOATTYPE>(getSpecSize(), 0.0))).first;
+  }
+  return &(it->second)[0];
+}
+
+//
+// Polarization, |A+B|^2 - |A-B|^2 = 4 Re[conj(A) B]
+//
+template <class FLOATTYPE, size_t NDIM>
+void PsFFTBase<FLOATTYPE, NDIM>::crossSpectrumRe(const FLOATTYPE* data1,
+    const FLOATTYPE* data2, FLOATTYPE* resPtr) {
+
+  size_t fsize = getFFTSize();
+  size_t ssize = getSpecSize();
+  std::vector<FLOATTYPE> sumDiff(fsize);
+  std::vector<FLOATTYPE> absDiff(ssize);
+
+  for (size_t n=0; n<fsize; ++n) sumDiff[n] = data1[n] + data2[n];
+  forwardFFTAbs(&sumDiff[0], resPtr);
+
+  for (size_t n=0; n<fsize; ++n) sumDiff[n] = data1[n] - data2[n];
+  forwardFFTAbs(&sumDiff[0], &absDiff[0]);
+
+  for (size_t n=0; n<ssize; ++n)
+    resPtr[n] = 0.25*(resPtr[n] - absDiff[n]);
+}
+
+//
+// Default batch methods, one transform at a time
+//
+template <class FLOATTYPE, size_t NDIM>
+void PsFFTBase<FLOATTYPE, NDIM>::scaledFFTPairMany(
+    const std::vector<const FLOATTYPE*>& data,
+    const std::vector<const FLOATTYPE*>& kdata,
+    const std::vector<FLOATTYPE*>& resPtrs) {
+
+  size_t nf = resPtrs.size();
+  checkManySize("PsFFTBase::scaledFFTPairMany", data.size(), nf);
+  checkManySize("PsFFTBase::scaledFFTPairMany", kdata.size(), nf);
+
+  for (size_t f=0; f<nf; ++f) {
+    scaledFFTPair(data[manyIndex(data.size(), f)],
+        kdata[manyIndex(kdata.size(), f)], resPtrs[f]);
+  }
+}
+
+template <class FLOATTYPE, size_t NDIM>
+void PsFFTBase<FLOATTYPE, NDIM>::scaledFFTPairImMany(
+    const std::vector<const FLOATTYPE*>& data,
+    const std::vector<const FLOATTYPE*>& kdata,
+    const std::vector<FLOATTYPE*>& resPtrs) {
+
+  size_t nf = resPtrs.size();
+  checkManySize("PsFFTBase::scaledFFTPairImMany", data.size(), nf);
+  checkManySize("PsFFTBase::scaledFFTPairImMany", kdata.size(), nf);
+
+  for (size_t f=0; f<nf; ++f) {
+    scaledFFTPairIm(data[manyIndex(data.size(), f)],
+        kdata[manyIndex(kdata.size(), f)], resPtrs[f]);
+  }
+}
+
+template <class FLOATTYPE, size_t NDIM>
+void PsFFTBase<FLOATTYPE, NDIM>::convolveReMany(
+    const std::vector<const FLOATTYPE*>& data1,
+    const std::vector<const FLOATTYPE*>& data2,
+    const std::vector<FLOATTYPE*>& resPtrs) {
+
+  size_t nf = resPtrs.size();
+  checkManySize("PsFFTBase::convolveReMany", data1.size(), nf);
+  checkManySize("PsFFTBase::convolveReMany", data2.size(), nf);
+
+  for (size_t f=0; f<nf; ++f) {
+    convolveRe(data1[manyIndex(data1.size(), f)],
+        data2[manyIndex(data2.size(), f)], resPtrs[f]);
+  }
+}
+
+template <class FLOATTYPE, size_t NDIM>
+void PsFFTBase<FLOATTYPE, NDIM>::calcForwardFFTMany(
+    const std::vector<const FLOATTYPE*>& data,
+    const std::vector<FLOATTYPE*>& resPtrs) {
+
+  size_t nf = resPtrs.size();
+  checkManySize("PsFFTBase::calcForwardFFTMany", data.size(), nf);
+
+  for (size_t f=0; f<nf; ++f) {
+    calcForwardFFT(data[manyIndex(data.size(), f)], resPtrs[f]);
+  }
+}
+
+//
+// Default kernel cache only saves the copy of the kernel,
+// both data sets are transformed on each convolution
+//
+template <class FLOATTYPE, size_t NDIM>
+size_t PsFFTBase<FLOATTYPE, NDIM>::addKernel(const FLOATTYPE* kdata) {
+
+  size_t fsize = getFFTSize();
+  kernelCopies.push_back(std::vector<FLOATTYPE>(kdata, kdata + fsize));
+  return kernelCopies.size() - 1;
+}
+
+template <class FLOATTYPE, size_t NDIM>
+void PsFFTBase<FLOATTYPE, NDIM>::convolveKernel(const FLOATTYPE* data,
+    size_t kernel, FLOATTYPE* resPtr) {
+
+  checkKernel("PsFFTBase::convolveKernel", kernel, kernelCopies.size());
+  convolveRe(data, &kernelCopies[kernel][0], resPtr);
+}
+
+template <class FLOATTYPE, size_t NDIM>
+void PsFFTBase<FLOATTYPE, NDIM>::convolveKernelMany(
+    const std::vector<const FLOATTYPE*>& data,
+    const std::vector<size_t>& kernels,
+    const std::vector<FLOATTYPE*>& resPtrs) {
+
+  size_t nf = resPtrs.size();
+  checkManySize("PsFFTBase::convolveKernelMany", data.size(), nf);
+  checkManySize("PsFFTBase::convolveKernelMany", kernels.size(), nf);
+
+  for (size_t f=0; f<nf; ++f) {
+    convolveKernel(data[manyIndex(data.size(), f)],
+        kernels[manyIndex(kernels.size(), f)], resPtrs[f]);
+  }
+}
+
+//
+// Default resident spectra keep the data and the product of the
+// scalings, transforms are done when the spectra are used
+//
+template <class FLOATTYPE, size_t NDIM>
+void PsFFTBase<FLOATTYPE, NDIM>::forwardSpectra(
+    const std::vector<const FLOATTYPE*>& data) {
+
+  size_t fsize = getFFTSize();
+  specCopies.clear();
+  specScales.clear();
+  for (size_t s=0; s<data.size(); ++s) {
+    specCopies.push_back(std::vector<FLOATTYPE>(data[s], data[s] + fsize));
+    specScales.push_back(std::vector<FLOATTYPE>(getSpecSize(), 1.0));
+  }
+}
+
+template <class FLOATTYPE, size_t NDIM>
+void PsFFTBase<FLOATTYPE, NDIM>::getSpectrumAbs(size_t spec,
+    FLOATTYPE* resPtr) {
+
+  checkSpectrum("PsFFTBase::getSpectrumAbs", spec, specCopies.size());
+  forwardFFTAbs(&specCopies[spec][0], resPtr);
+
+  // Earlier scalings of this spectrum
+  std::vector<FLOATTYPE>& scales = specScales[spec];
+  for (size_t n=0; n<scales.size(); ++n) {
+    resPtr[n] *= scales[n]*scales[n];
+  }
+}
+
+template <class FLOATTYPE, size_t NDIM>
+void PsFFTBase<FLOATTYPE, NDIM>::scaleSpectrum(size_t spec,
+    const FLOATTYPE* kdata) {
+
+  checkSpectrum("PsFFTBase::scaleSpectrum", spec, specCopies.size());
+  std::vector<FLOATTYPE>& scales = specScales[spec];
+  for (size_t n=0; n<scales.size(); ++n) scales[n] *= kdata[n];
+}
+
+template <class FLOATTYPE, size_t NDIM>
+void PsFFTBase<FLOATTYPE, NDIM>::backwardSpectra(
+    const std::vector<FLOATTYPE*>& resPtrs) {
+
+  if (resPtrs.size() != specCopies.size()) {
+    TxDebugExcept tde("PsFFTBase::backwardSpectra: ");
+    tde << resPtrs.size() << " results for " << specCopies.size();
+    tde << " spectra in <FFT " << this->getName() << " >";
+    throw tde;
+  }
+
+  std::vector<const FLOATTYPE*> data;
+  std::vector<const FLOATTYPE*> kdata;
+  for (size_t s=0; s<specCopies.size(); ++s) {
+    data.push_back(&specCopies[s][0]);
+    kdata.push_back(&specScales[s][0]);
+  }
+  scaledFFTPairMany(data, kdata, resPtrs);
+
+  specCopies.clear();
+  specScales.clear();
+}
+
+template <class FLOATTYPE, size_t NDIM>
+void PsFFTBase<FLOATTYPE, NDIM>::checkSpectrum(const std::string& method,
+    size_t spec, size_t nSpec) {
+
+  if (spec < nSpec) return;
+
+  TxDebugExcept tde(method);
+  tde << ": spectrum " << spec << " not resident, " << nSpec;
+  tde << " spectra in <FFT " << this->getName() << " >";
+  throw tde;
+}
+
+template <class FLOATTYPE, size_t NDIM>
+void PsFFTBase<FLOATTYPE, NDIM>::checkKernel(const std::string& method,
+    size_t kernel, size_t nKernels) {
+
+  if (kernel < nKernels) return;
+
+  TxDebugExcept tde(method);
+  tde << ": kernel " << kernel << " not registered, " << nKernels;
+  tde << " kernels in <FFT " << this->getName() << " >";
+  throw tde;
+}
+
+template <class FLOATTYPE, size_t NDIM>
+void PsFFTBase<FLOATTYPE, NDIM>::checkManySize(const std::string& method,
+    size_t nData, size_t nFields) {
+
+  if ( (nData == 1) || (nData == nFields) ) return;
+
+  TxDebugExcept tde(method);
+  tde << ": " << nData << " data pointers for " << nFields;
+  tde << " transforms in <FFT " << this->getName() << " >";
+  throw tde;
+}
+
 template class PsFFTBase<float, 1>;
 template class PsFFTBase<float, 2>;
 template class PsFFTBase<float, 3>;
@@ -15,6 +15,7 @@
 // std includes
 #include <string>
 #include <set>
+#include <map>
 #include <vector>
 
 // configure stuff
@@ -74,6 +75,33 @@ class PsFFTBase : public virtual PsDynObj<FLOATTYPE, NDIM> {
  */
   virtual size_t getFFTSize() = 0;
 
+/**
+ * Get number of local k-space elements expected for kdata
+ * arguments. Complex-to-complex transforms store the full spectrum
+ * so this defaults to the size of the data transform.
+ */
+  virtual size_t getSpecSize() {
+    return getFFTSize();
+  }
+
+/**
+ * Check if transform stores only the Hermitian half-spectrum,
+ * ie. last dimension of k-space is (n/2 + 1) long
+ */
+  virtual bool hasHalfSpectrum() {
+    return false;
+  }
+
+/**
+ * Check if the spectrum is in transposed order, ie. the first two
+ * k-space dimensions swapped and the local k-space the y-slab of
+ * the FFT grid. kdata arguments must be built in the same order,
+ * objects building k-space lists pick their layout from this.
+ */
+  virtual bool isTransposedOrder() {
+    return false;
+  }
+
 /**
  * Forward transform real input data and return |a+bi| elementwise
  *
@@ -83,6 +111,20 @@ class PsFFTBase : public virtual PsDynObj<FLOATTYPE, NDIM> {
   virtual void forwardFFTAbs(const FLOATTYPE* data1,
       FLOATTYPE* resPtr) = 0;
 
+/**
+ * Forward transform two REAL data sets and return Re[conj(a) b]
+ * elementwise in k-space, so sum_k f(k) Re[conj(a) b] is the
+ * overlap sum_r b F^-1[f F[a]] (unnormalized) without a backward
+ * transform. Default is (|F[a+b]|^2 - |F[a-b]|^2)/4 from
+ * forwardFFTAbs, two forward transforms.
+ *
+ * @param data1  pointer to first REAL data to transform
+ * @param data2  pointer to second REAL data to transform
+ * @param resPtr pointer to result in k-space (also supplied by caller)
+ */
+  virtual void crossSpectrumRe(const FLOATTYPE* data1,
+      const FLOATTYPE* data2, FLOATTYPE* resPtr);
+
 /**
  * Forward transform real input data, multiply elementwise and
  * backward transform
@@ -105,6 +147,90 @@ class PsFFTBase : public virtual PsDynObj<FLOATTYPE, NDIM> {
   virtual void scaledFFTPair(const FLOATTYPE* data,
       const FLOATTYPE* kdata, FLOATTYPE* resPtr) = 0;
 
+/**
+ * Perform multi-dimensional FFT pair on two REAL data sets at once,
+ * scaling both by kdata in-between transform pair. The kdata must be
+ * real and even in k (eg. the k2 operator) so the two results stay
+ * separable. Default is two separate calls to scaledFFTPair.
+ *
+ * @param data1   pointer to first REAL data to transform
+ * @param data2   pointer to second REAL data to transform
+ * @param kdata   pointer to data to scale transform
+ * @param resPtr1 pointer to first Re[result] (also supplied by caller)
+ * @param resPtr2 pointer to second Re[result] (also supplied by caller)
+ */
+  virtual void scaledFFTPairTwo(const FLOATTYPE* data1,
+      const FLOATTYPE* data2, const FLOATTYPE* kdata,
+      FLOATTYPE* resPtr1, FLOATTYPE* resPtr2) {
+    scaledFFTPair(data1, kdata, resPtr1);
+    scaledFFTPair(data2, kdata, resPtr2);
+  }
+
+/**
+ * Check if callers can transform concurrently in their own
+ * workspaces (see addWorkspace). Distributed transforms are
+ * collective and have no workspaces.
+ */
+  virtual bool hasWorkspaces() {
+    return false;
+  }
+
+/**
+ * Add a transform workspace, ie. in/out buffers sharing the plans of
+ * this object, for one concurrent caller. Workspace 0 is the buffers
+ * used by the methods without a workspace argument.
+ *
+ * @return index of workspace, 0 if workspaces not supported
+ */
+  virtual size_t addWorkspace() {
+    return 0;
+  }
+
+/**
+ * Perform scaledFFTPair in a transform workspace from addWorkspace.
+ * Default ignores the workspace.
+ *
+ * @param ws     index of workspace
+ * @param data   pointer to REAL data to transform
+ * @param kdata  pointer to data to scale transform
+ * @param resPtr pointer to Re[result] (also supplied by caller)
+ */
+  virtual void scaledFFTPairWs(size_t ws, const FLOATTYPE* data,
+      const FLOATTYPE* kdata, FLOATTYPE* resPtr) {
+    scaledFFTPair(data, kdata, resPtr);
+  }
+
+/**
+ * Perform scaledFFTPairTwo in a transform workspace from
+ * addWorkspace. Default ignores the workspace.
+ *
+ * @param ws      index of workspace
+ * @param data1   pointer to first REAL data to transform
+ * @param data2   pointer to second REAL data to transform
+ * @param kdata   pointer to data to scale transform
+ * @param resPtr1 pointer to first Re[result] (also supplied by caller)
+ * @param resPtr2 pointer to second Re[result] (also supplied by caller)
+ */
+  virtual void scaledFFTPairTwoWs(size_t ws, const FLOATTYPE* data1,
+      const FLOATTYPE* data2, const FLOATTYPE* kdata,
+      FLOATTYPE* resPtr1, FLOATTYPE* resPtr2) {
+    scaledFFTPairTwo(data1, data2, kdata, resPtr1, resPtr2);
+  }
+
+/**
+ * Perform crossSpectrumRe in a transform workspace from
+ * addWorkspace. Default ignores the workspace.
+ *
+ * @param ws     index of workspace
+ * @param data1  pointer to first REAL data to transform
+ * @param data2  pointer to second REAL data to transform
+ * @param resPtr pointer to result in k-space (also supplied by caller)
+ */
+  virtual void crossSpectrumReWs(size_t ws, const FLOATTYPE* data1,
+      const FLOATTYPE* data2, FLOATTYPE* resPtr) {
+    crossSpectrumRe(data1, data2, resPtr);
+  }
+
 /**
  * Perform multi-dimensional FFT pair, scaling the
  * result by kdata in-between transform pair
@@ -134,10 +260,194 @@ class PsFFTBase : public virtual PsDynObj<FLOATTYPE, NDIM> {
    virtual void calcBackwardFFT(const FLOATTYPE* data,
        FLOATTYPE* resPtr) = 0;
 
+/**
+ * Perform multi-dimensional FFT pairs on several REAL data sets,
+ * scaling each by its kdata in-between transform pair. The number
+ * of transforms is the length of resPtrs, data and kdata hold either
+ * one entry (used for all transforms) or one entry per transform.
+ * Default is one scaledFFTPair call per transform.
+ *
+ * @param data    pointers to REAL data to transform
+ * @param kdata   pointers to data to scale transforms
+ * @param resPtrs pointers to Re[result] (also supplied by caller)
+ */
+  virtual void scaledFFTPairMany(const std::vector<const FLOATTYPE*>& data,
+      const std::vector<const FLOATTYPE*>& kdata,
+      const std::vector<FLOATTYPE*>& resPtrs);
+
+/**
+ * Perform multi-dimensional FFT pairs on several IMAGINARY data
+ * sets, as scaledFFTPairMany. Default is one scaledFFTPairIm call
+ * per transform.
+ *
+ * @param data    pointers to IMAGINARY data to transform
+ * @param kdata   pointers to data to scale transforms
+ * @param resPtrs pointers to Re[result] (also supplied by caller)
+ */
+  virtual void scaledFFTPairImMany(const std::vector<const FLOATTYPE*>& data,
+      const std::vector<const FLOATTYPE*>& kdata,
+      const std::vector<FLOATTYPE*>& resPtrs);
+
+/**
+ * Convolve several pairs of REAL data sets. The number of
+ * convolutions is the length of resPtrs, data1 and data2 hold either
+ * one entry (used for all convolutions) or one entry per convolution.
+ * Default is one convolveRe call per convolution.
+ *
+ * @param data1   pointers to REAL data to transform
+ * @param data2   pointers to REAL data to scale transforms
+ * @param resPtrs pointers to Re[result] (also supplied by caller)
+ */
+  virtual void convolveReMany(const std::vector<const FLOATTYPE*>& data1,
+      const std::vector<const FLOATTYPE*>& data2,
+      const std::vector<FLOATTYPE*>& resPtrs);
+
+/**
+ * Perform forward multi-dimensional FFT on several REAL data sets.
+ * Default is one calcForwardFFT call per data set.
+ *
+ * @param data    pointers to REAL data to transform
+ * @param resPtrs pointers to Re[result] (also supplied by caller)
+ */
+  virtual void calcForwardFFTMany(const std::vector<const FLOATTYPE*>& data,
+      const std::vector<FLOATTYPE*>& resPtrs);
+
+/**
+ * Register a REAL kernel for repeated convolutions. The kernel
+ * transform is kept by the FFT object so each convolveKernel call
+ * only transforms the data. Default keeps a copy of the kernel
+ * for convolveRe.
+ *
+ * @param kdata pointer to REAL kernel data
+ * @return index of kernel for convolveKernel calls
+ */
+  virtual size_t addKernel(const FLOATTYPE* kdata);
+
+/**
+ * Convolve REAL data with a kernel registered by addKernel
+ *
+ * @param data   pointer to REAL data to transform
+ * @param kernel index of kernel from addKernel
+ * @param resPtr pointer to Re[result] (also supplied by caller)
+ */
+  virtual void convolveKernel(const FLOATTYPE* data, size_t kernel,
+      FLOATTYPE* resPtr);
+
+/**
+ * Convolve REAL data sets with kernels registered by addKernel. The
+ * number of convolutions is the length of resPtrs, data holds either
+ * one entry (used for all convolutions) or one entry per convolution.
+ * Default is one convolveKernel call per convolution.
+ *
+ * @param data    pointers to REAL data to transform
+ * @param kernels indices of kernels from addKernel, one per convolution
+ * @param resPtrs pointers to Re[result] (also supplied by caller)
+ */
+  virtual void convolveKernelMany(const std::vector<const FLOATTYPE*>& data,
+      const std::vector<size_t>& kernels,
+      const std::vector<FLOATTYPE*>& resPtrs);
+
+/**
+ * Forward transform REAL data sets and keep their spectra resident
+ * in this object, spectrum s is the transform of data[s]. The spectra
+ * can be inspected and scaled before backwardSpectra, so a filter
+ * needs one transform each way. Default keeps copies of the data.
+ *
+ * @param data pointers to REAL data to transform
+ */
+  virtual void forwardSpectra(const std::vector<const FLOATTYPE*>& data);
+
+/**
+ * Get |a+bi| elementwise of a resident spectrum (as forwardFFTAbs)
+ *
+ * @param spec   index of spectrum from forwardSpectra
+ * @param resPtr pointer to result in k-space (also supplied by caller)
+ */
+  virtual void getSpectrumAbs(size_t spec, FLOATTYPE* resPtr);
+
+/**
+ * Scale a resident spectrum elementwise (both Re/Im)
+ *
+ * @param spec  index of spectrum from forwardSpectra
+ * @param kdata pointer to data to scale spectrum
+ */
+  virtual void scaleSpectrum(size_t spec, const FLOATTYPE* kdata);
+
+/**
+ * Backward transform all resident spectra, which are released
+ *
+ * @param resPtrs pointers to Re[result], one per spectrum
+ */
+  virtual void backwardSpectra(const std::vector<FLOATTYPE*>& resPtrs);
+
+/**
+ * Get a k-space table of getSpecSize() values shared by all users
+ * of this object, eg. blocks with the same Laplacian factor, also
+ * across replica domains (see PsFFTHldr::shareFFTs). The table is
+ * owned by this object and filled by the caller.
+ *
+ * @param key   name of table, callers with the same key share it
+ * @param isNew set true if the table was just made and must be filled
+ * @return pointer to table
+ */
+  FLOATTYPE* getKTable(const std::string& key, bool& isNew);
+
   protected:
 
+/**
+ * Check index of a resident spectrum, throws if out of range
+ *
+ * @param method name of calling method for error message
+ * @param spec   index of spectrum
+ * @param nSpec  number of resident spectra
+ */
+  void checkSpectrum(const std::string& method, size_t spec, size_t nSpec);
+
+/**
+ * Check index of a registered kernel, throws if out of range
+ *
+ * @param method   name of calling method for error message
+ * @param kernel   index of kernel
+ * @param nKernels number of registered kernels
+ */
+  void checkKernel(const std::string& method, size_t kernel,
+      size_t nKernels);
+
+/**
+ * Check the number of entries in an argument list of a batch
+ * method, throws unless one entry or one per transform
+ *
+ * @param method  name of calling method for error message
+ * @param nData   number of entries in argument list
+ * @param nFields number of transforms
+ */
+  void checkManySize(const std::string& method, size_t nData,
+      size_t nFields);
+
+/**
+ * Index into a batch argument list for transform f
+ *
+ * @param nData number of entries in argument list
+ * @param f     index of transform
+ */
+  size_t manyIndex(size_t nData, size_t f) {
+    return (nData == 1) ? 0 : f;
+  }
+
   private:
 
+    /** Copies of registered kernels for default convolveKernel */
+    std::vector< std::vector<FLOATTYPE> > kernelCopies;
+
+    /** Copies of data for default resident spectra */
+    std::vector< std::vector<FLOATTYPE> > specCopies;
+
+    /** Accumulated scaling for default resident spectra */
+    std::vector< std::vector<FLOATTYPE> > specScales;
+
+    /** Shared k-space tables by key */
+    std::map< std::string, std::vector<FLOATTYPE> > kTables;
+
     /** Make private to prevent use */
     PsFFTBase(const PsFFTBase<FLOATTYPE, NDIM>& vphh);
 
@@ -80,6 +80,16 @@ class PsFunctionalQ : public virtual PsDynObj<FLOATTYPE, NDIM> {
  */
     virtual void update(double t);
 
+/**
+ * Get the self-consistent PhysField for the monomer density
+ * (set in buildSolvers)
+ *
+ * @return pointer to monomer PhysField
+ */
+    PsPhysField<FLOATTYPE, NDIM>* getMonoDensPhysField() {
+      return monoDensPhysFldPtr;
+    }
+
 /**
  * Get the overall volume fraction for this component
  *
@@ -182,6 +182,14 @@ class PsGridBase : public virtual PsDynObj<FLOATTYPE, NDIM>, public PsGridBaseIt
  */
     virtual std::vector<FLOATTYPE> getCellSizes() = 0;
 
+/**
+ * Set size of cells in each dimension, eg. for variable-cell
+ * relaxation. Objects holding k-space data must rebuild it
+ *
+ * @param cs vector of cell sizes
+ */
+    virtual void setCellSizes(const std::vector<FLOATTYPE>& cs) = 0;
+
 /**
  * Get global real lengths for each dimension of uniform Cartesian
  *
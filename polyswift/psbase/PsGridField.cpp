@@ -103,6 +103,36 @@ void PsGridField<FLOATTYPE, NRANK>::calck2() {
   } // loop for k2
 }
 
+//
+template <class FLOATTYPE, size_t NRANK>
+void PsGridField<FLOATTYPE, NRANK>::calckDir2(size_t dir) {
+
+  std::vector<size_t> globalSize = gridPtr->getNumCellsGlobal();
+  if (dir >= globalSize.size()) {
+    TxDebugExcept tde("PsGridField::calckDir2: direction out of range");
+    throw tde;
+  }
+
+  // Only the index along dir matters
+  FLOATTYPE n2 = (FLOATTYPE) globalSize[dir] / 2.0;
+  FLOATTYPE dr = gridPtr->getCellSizes()[dir];
+  size_t indx[3];
+  for (indx[0] = 0; indx[0] < globalSize[0]; ++indx[0]) {
+    for (indx[1] = 0; indx[1] < globalSize[1]; ++indx[1]) {
+      for (indx[2] = 0; indx[2] < globalSize[2]; ++indx[2]) {
+        PsTinyVector<int, NRANK> posVec(indx[0], indx[1], indx[2]);
+
+        FLOATTYPE nk = n2 - std::abs(FLOATTYPE(indx[dir]) - n2);
+        FLOATTYPE kval = mksConsts.twopi*nk/FLOATTYPE(globalSize[dir]);
+        kval = kval/dr;
+
+        FLOATTYPE k2val = kval*kval;
+        this->mapToLocalField(posVec, k2val, "set");
+      }
+    }
+  } // loop for k2
+}
+
 //
 template <class FLOATTYPE, size_t NRANK>
 void PsGridField<FLOATTYPE, NRANK>::mapToLocalField(
@@ -230,8 +260,13 @@ void PsGridField<FLOATTYPE, NRANK>::calckVec() {
 
 template <class FLOATTYPE, size_t NRANK>
 void PsGridField<FLOATTYPE, NRANK>::reset(double val) {
-  for (size_t i=0; i<getSize(); ++i)
-    operator()(i) = val;
+
+  FLOATTYPE* dataPtr = getDataPtr();
+  size_t dataPtrSize = getSize();
+
+#pragma omp parallel for
+  for (size_t i=0; i<dataPtrSize; ++i)
+    dataPtr[i] = val;
 }
 
 /*
@@ -249,10 +284,13 @@ void PsGridField<FLOATTYPE, NRANK>::add(FLOATTYPE val) {
 template <class FLOATTYPE, size_t NRANK>
 void PsGridField<FLOATTYPE, NRANK>::scale(double val) {
 
-  double tmp;
-  for (size_t i=0; i<getSize(); ++i) {
-    tmp = val*operator()(i);
-    operator()(i) = tmp;
+  FLOATTYPE* dataPtr = getDataPtr();
+  size_t dataPtrSize = getSize();
+
+#pragma omp parallel for
+  for (size_t i=0; i<dataPtrSize; ++i) {
+    double tmp = val*dataPtr[i];
+    dataPtr[i] = tmp;
   }
 }
 
@@ -300,12 +338,14 @@ FLOATTYPE PsGridField<FLOATTYPE, NRANK>::maxVal() {
 template <class FLOATTYPE, size_t NRANK>
 FLOATTYPE PsGridField<FLOATTYPE, NRANK>::getSumAll() {
 
+  const FLOATTYPE* dataPtr = getDataPtr();
+  size_t dataPtrSize = getSize();
+
   FLOATTYPE tot = 0.0;
-  FLOATTYPE val = 0.0;
 
-  for (size_t i=0; i<getSize(); ++i) {
-    val = operator()(i);
-    tot = tot + val;
+#pragma omp parallel for reduction(+:tot)
+  for (size_t i=0; i<dataPtrSize; ++i) {
+    tot = tot + dataPtr[i];
   }
   return tot;
 }
@@ -313,16 +353,13 @@ FLOATTYPE PsGridField<FLOATTYPE, NRANK>::getSumAll() {
 template <class FLOATTYPE, size_t NRANK>
 void PsGridField<FLOATTYPE, NRANK>::apply_exp() {
 
-  double tmp;
-  FLOATTYPE tmp1;
-
   FLOATTYPE* dataPtr = getDataPtr();
   size_t dataPtrSize = getSize();
 
+#pragma omp parallel for
   for (size_t i=0; i<dataPtrSize; ++i) {
-    tmp = (double) dataPtr[i];
-    tmp1 = (FLOATTYPE) std::exp(tmp);
-    dataPtr[i] = tmp1;
+    double tmp = (double) dataPtr[i];
+    dataPtr[i] = (FLOATTYPE) std::exp(tmp);
   }
 
 }
@@ -434,6 +471,7 @@ void PsGridField<FLOATTYPE, NRANK>::operator+=(FLOATTYPE c) {
   FLOATTYPE* dataPtr = getDataPtr();
   size_t dataPtrSize = getSize();
 
+#pragma omp parallel for
   for (size_t i=0; i<dataPtrSize; ++i) {
     dataPtr[i] = dataPtr[i] + c;
   }
@@ -448,6 +486,7 @@ void PsGridField<FLOATTYPE, NRANK>::operator-=(FLOATTYPE c) {
   FLOATTYPE* dataPtr = getDataPtr();
   size_t dataPtrSize = getSize();
 
+#pragma omp parallel for
   for (size_t i=0; i<dataPtrSize; ++i) {
     dataPtr[i] = dataPtr[i] - c;
   }
@@ -462,6 +501,7 @@ void PsGridField<FLOATTYPE, NRANK>::operator*=(FLOATTYPE c) {
   FLOATTYPE* dataPtr = getDataPtr();
   size_t dataPtrSize = getSize();
 
+#pragma omp parallel for
   for (size_t i=0; i<dataPtrSize; ++i) {
     dataPtr[i] = c*dataPtr[i];
   }
@@ -489,6 +529,7 @@ void PsGridField<FLOATTYPE, NRANK>::operator+=(PsFieldBase<FLOATTYPE>& psf) {
     throw tde;
   }
 
+#pragma omp parallel for
   for (size_t i=0; i<dataPtrSize; ++i) {
     dataPtr[i] = dataPtr[i] + psfPtr[i];
   }
@@ -514,6 +555,7 @@ void PsGridField<FLOATTYPE, NRANK>::operator-=(PsFieldBase<FLOATTYPE>& psf) {
     throw tde;
   }
 
+#pragma omp parallel for
   for (size_t i=0; i<dataPtrSize; ++i) {
     dataPtr[i] = dataPtr[i] - psfPtr[i];
   }
@@ -537,6 +579,7 @@ void PsGridField<FLOATTYPE, NRANK>::operator*=(PsFieldBase<FLOATTYPE>& psf) {
     throw tde;
   }
 
+#pragma omp parallel for
   for (size_t i=0; i<dataPtrSize; ++i) {
     dataPtr[i] = dataPtr[i] * psfPtr[i];
   }
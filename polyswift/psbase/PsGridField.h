@@ -129,6 +129,14 @@ class PsGridField : public PsTensor<FLOATTYPE, NRANK+1>,
  */
     virtual void calck2();
 
+/**
+ * Square of one k vector component associated with grid,
+ * the calck2 result is the sum over directions
+ *
+ * @param dir direction index
+ */
+    virtual void calckDir2(size_t dir);
+
 /**
  * k vectors associated with grid field
  */
@@ -13,6 +13,9 @@
 #include <config.h>
 #endif
 
+// std includes
+#include <algorithm>
+
 // psbase includes
 #include <PsPolymer.h>
 
@@ -103,6 +106,27 @@ void PsPolymer<FLOATTYPE, NDIM>::update(double t) {
 
 }
 
+//
+// Volume fractions of all components must still sum to 1,
+// this is checked by the PhysField holder at the next update
+//
+template <class FLOATTYPE, size_t NDIM>
+void PsPolymer<FLOATTYPE, NDIM>::setSweepParam(const std::string& paramName,
+    FLOATTYPE val) {
+
+  if (paramName != "volfrac") {
+    PsDynObj<FLOATTYPE, NDIM>::setSweepParam(paramName, val);
+  }
+  if (hasVfSTFunc) {
+    TxDebugExcept tde("PsPolymer::setSweepParam: volfrac cannot be swept");
+    tde << " with an STFunc for volfrac in <Polymer " << this->getName() << " >";
+    throw tde;
+  }
+
+  volfrac = val;
+  this->dbprt("polymer volume frac = ", volfrac);
+}
+
 template <class FLOATTYPE, size_t NDIM>
 std::vector<std::string> PsPolymer<FLOATTYPE, NDIM>::getPolymerNames() {
   return allPolymerNames;
@@ -120,7 +144,11 @@ void PsPolymer<FLOATTYPE, NDIM>::setScaleLength(size_t scalelen) {
 
 template <class FLOATTYPE, size_t NDIM>
 void PsPolymer<FLOATTYPE, NDIM>::setPolymerName(std::string pName) {
-  allPolymerNames.push_back(pName);
+  // Replicas in one process register the same names
+  if (std::find(allPolymerNames.begin(), allPolymerNames.end(), pName) ==
+      allPolymerNames.end()) {
+    allPolymerNames.push_back(pName);
+  }
 }
 
 //
@@ -78,6 +78,14 @@ class PsPolymer : public virtual PsDynObj<FLOATTYPE, NDIM> {
  */
     virtual void update(double t);
 
+/**
+ * Set volfrac for a parameter sweep
+ *
+ * @param paramName name of the parameter (volfrac)
+ * @param val the new value
+ */
+    virtual void setSweepParam(const std::string& paramName, FLOATTYPE val);
+
 /**
  * Get the natural-log of the single-chain partition function
  * normalization value
@@ -122,6 +130,39 @@ class PsPolymer : public virtual PsDynObj<FLOATTYPE, NDIM> {
       return lengthRatio;
     }
 
+/**
+ * Turn on/off the box-length derivatives of log(bigQ)
+ * in the propagator solves
+ *
+ * @param cs true to calculate
+ */
+    virtual void setCalcStress(bool cs) {
+      TxDebugExcept tde("PsPolymer::setCalcStress not implemented");
+      tde << " for <Polymer " << this->getName() << " >";
+      throw tde;
+    }
+
+/**
+ * Get L_i d(log bigQ)/dL_i for each direction i of the box
+ * from the last update
+ *
+ * @return vector of derivatives, one per grid direction
+ */
+    virtual std::vector<FLOATTYPE> getStress() {
+      TxDebugExcept tde("PsPolymer::getStress not implemented");
+      tde << " for <Polymer " << this->getName() << " >";
+      throw tde;
+    }
+
+/**
+ * Rebuild k-space operators after the grid cell sizes changed
+ */
+    virtual void rebuildKSpace() {
+      TxDebugExcept tde("PsPolymer::rebuildKSpace not implemented");
+      tde << " for <Polymer " << this->getName() << " >";
+      throw tde;
+    }
+
 /**
  * Set the static value of polymer length for scaling
  * quantities from ALL polymer objects
@@ -14,6 +14,9 @@
 #include <config.h>
 #endif
 
+// std includes
+#include <algorithm>
+
 // psbase includes
 #include <PsSolvent.h>
 
@@ -99,6 +102,27 @@ void PsSolvent<FLOATTYPE, NDIM>::update(double t) {
 
 }
 
+//
+// Volume fractions of all components must still sum to 1,
+// this is checked by the PhysField holder at the next update
+//
+template <class FLOATTYPE, size_t NDIM>
+void PsSolvent<FLOATTYPE, NDIM>::setSweepParam(const std::string& paramName,
+    FLOATTYPE val) {
+
+  if (paramName != "volfrac") {
+    PsDynObj<FLOATTYPE, NDIM>::setSweepParam(paramName, val);
+  }
+  if (hasVfSTFunc) {
+    TxDebugExcept tde("PsSolvent::setSweepParam: volfrac cannot be swept");
+    tde << " with an STFunc for volfrac in <Solvent " << this->getName() << " >";
+    throw tde;
+  }
+
+  volfrac = val;
+  this->dbprt("solvent volume frac = ", volfrac);
+}
+
 template <class FLOATTYPE, size_t NDIM>
 std::vector<std::string> PsSolvent<FLOATTYPE, NDIM>::getSolventNames() {
   return allSolventNames;
@@ -106,7 +130,11 @@ std::vector<std::string> PsSolvent<FLOATTYPE, NDIM>::getSolventNames() {
 
 template <class FLOATTYPE, size_t NDIM>
 void PsSolvent<FLOATTYPE, NDIM>::setSolventName(std::string pName) {
-  allSolventNames.push_back(pName);
+  // Replicas in one process register the same names
+  if (std::find(allSolventNames.begin(), allSolventNames.end(), pName) ==
+      allSolventNames.end()) {
+    allSolventNames.push_back(pName);
+  }
 }
 
 // Declaration of static data
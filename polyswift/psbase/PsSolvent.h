@@ -77,6 +77,14 @@ class PsSolvent : public virtual PsFunctionalQ<FLOATTYPE, NDIM> {
  */
     virtual void update(double t);
 
+/**
+ * Set volfrac for a parameter sweep
+ *
+ * @param paramName name of the parameter (volfrac)
+ * @param val the new value
+ */
+    virtual void setSweepParam(const std::string& paramName, FLOATTYPE val);
+
 /**
  * Get the overall volume fraction for this solvent
  *
@@ -95,6 +95,34 @@ class PsUpdater : public virtual PsDynObj<FLOATTYPE, NDIM> {
  */
     virtual FLOATTYPE getFreeE(bool calcDisorder=true) = 0;
 
+/**
+ * Get normalized residual from the last update, zero if this
+ * updater does not measure one
+ */
+    virtual FLOATTYPE getResidual() {
+      return 0.0;
+    }
+
+/**
+ * Forget the iterates of earlier updates (eg. at a new point of a
+ * parameter sweep), default keeps none
+ */
+    virtual void resetHistory() {}
+
+/**
+ * Check if the last update changed the grid cell sizes, the
+ * effective Hamiltonian then calls rebuildKSpace for all updaters
+ */
+    virtual bool changedBox() {
+      return false;
+    }
+
+/**
+ * Rebuild operators that depend on the grid cell sizes,
+ * default has none
+ */
+    virtual void rebuildKSpace() {}
+
   protected:
 
     /** Flag for performing update methods */
@@ -103,8 +103,16 @@ void PsInteractingSphere<FLOATTYPE, NDIM>::buildSolvers() {
     forceFieldVec.push_back(ffPtr);
   }
 
-  // Allocate result pointer
-  resPtr = new FLOATTYPE[this->fftSize];
+  // Allocate result pointer, one result per spatial component
+  resPtr = new FLOATTYPE[NDIM*this->fftSize];
+
+  // Gradient components are fixed so their transforms are kept
+  // by the FFT object and only the fields are transformed
+  gradKernels.clear();
+  for (size_t ic=0; ic<NDIM; ++ic) {
+    gradKernels.push_back(
+        this->fftObjPtr->addKernel(this->gradFieldVec[ic].getConstDataPtr()));
+  }
 }
 
 //
@@ -138,22 +146,27 @@ void PsInteractingSphere<FLOATTYPE, NDIM>::calculateForces() {
   // SWS: these could be separated into helpers....
 
   // Pressure force contribution...
-  FLOATTYPE* presPtr =
-    this->constraintPhysFldPtr->getConjgField().getDataPtr();
+  std::vector<const FLOATTYPE*> presPtrs(1,
+    this->constraintPhysFldPtr->getConjgField().getConstDataPtr());
+
+  // Convolution results for each gradient component
+  std::vector<FLOATTYPE*> resPtrs;
+  for (size_t ic=0; ic<NDIM; ++ic) {
+    resPtrs.push_back(resPtr + ic*this->fftSize);
+  }
+
+  // Find convolution integrals for all components of the
+  // particle gradient function in one batch
+  this->fftObjPtr->convolveKernelMany(presPtrs, gradKernels, resPtrs);
 
   //
   // Loop on spatial components
   //
   for (size_t ic=0; ic<NDIM; ++ic) {
 
-    // Find convolutaion integral for ic component of the
-    // particle gradient function
-    FLOATTYPE* gradPtr = this->gradFieldVec[ic].getDataPtr();
-    this->fftObjPtr->convolveRe(presPtr, gradPtr, resPtr);
-
     // Assign to force-field component
     FLOATTYPE* forcePtr = forceFieldVec[ic]->getDataPtr();
-    memcpy(forcePtr, resPtr, this->fftMemSize);
+    memcpy(forcePtr, resPtrs[ic], this->fftMemSize);
     forceFieldVec[ic]->scale(-1.0*this->scaleFFT/localVol);
   }
 
@@ -184,7 +197,8 @@ void PsInteractingSphere<FLOATTYPE, NDIM>::calculateForces() {
       throw tde;
     }
 
-    FLOATTYPE* physPtr = otherPhysField->getDensField().getDataPtr();
+    std::vector<const FLOATTYPE*> physPtrs(1,
+      otherPhysField->getDensField().getConstDataPtr());
 
     // Get chiN parameter for this interaction
     // FLOATTYPE chiN = interPtr->getParam();
@@ -193,19 +207,18 @@ void PsInteractingSphere<FLOATTYPE, NDIM>::calculateForces() {
     this->dbprt("accessing 'other' physical field ", otherPhysField->getName());
     this->dbprt("  for particle field ", this->bndryFieldName);
 
+    // Convolution integrals for forces, all components in one batch
+    this->fftObjPtr->convolveKernelMany(physPtrs, gradKernels, resPtrs);
+
     // Loop on spatial components
     for (size_t ic=0; ic<NDIM; ++ic) {
 
       // Reset for safety
       forceField->reset(0.0);
 
-      // Convolution integral for forces
-      FLOATTYPE* gradPtr = this->gradFieldVec[ic].getDataPtr();
-      this->fftObjPtr->convolveRe(physPtr, gradPtr, resPtr);
-
       // Assign to force-field component
       FLOATTYPE* forcePtr = forceField->getDataPtr();
-      memcpy(forcePtr, resPtr, this->fftMemSize);
+      memcpy(forcePtr, resPtrs[ic], this->fftMemSize);
 
       // Scale factor for convolution, and volume factor from force derivation
       // SWS: localVol should be global volume
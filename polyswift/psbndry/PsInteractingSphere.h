@@ -101,9 +101,15 @@ class PsInteractingSphere : public PsSphere<FLOATTYPE, NDIM> {
      */
     void calculateForces();
 
-    /** Result data pointer for FFT calcs */
+    /** Result data for FFT calcs, one block per spatial component */
     FLOATTYPE* resPtr;
 
+    /**
+     * Kernel indices in the FFT object for the components of the
+     * particle gradient (constant after buildSolvers)
+     */
+    std::vector<size_t> gradKernels;
+
     /** Number of domain update iterations between particle moves steps */
     size_t updateMovePeriod;
 
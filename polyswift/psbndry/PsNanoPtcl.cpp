@@ -487,21 +487,26 @@ void PsNanoPtcl<FLOATTYPE, NDIM>::setGradFieldVec() {
   PsGridField<FLOATTYPE, NDIM> gradPtclField;
   gradPtclField.setGrid(gItr);
 
-  // Local data pointers
-  FLOATTYPE* resPtr = new FLOATTYPE[fftSize];
+  // Local data pointers, one result per spatial component
+  FLOATTYPE* resPtr = new FLOATTYPE[NDIM*fftSize];
   FLOATTYPE* gradPtr = 0;
-
-  // Loop on spatial components
+  std::vector<const FLOATTYPE*> cavPtrs(1, cavPtclField.getConstDataPtr());
+  std::vector<const FLOATTYPE*> ikPtrs;
+  std::vector<FLOATTYPE*> resPtrs;
   for (size_t ic=0; ic<NDIM; ++ic) {
+    ikPtrs.push_back(ikVecField[ic].getConstDataPtr());
+    resPtrs.push_back(resPtr + ic*fftSize);
+  }
 
-    fftObjPtr->scaledFFTPairIm(cavPtclField.getDataPtr(),
-                               ikVecField[ic].getDataPtr(),
-                               resPtr);
+  // All components from one transform of the particle field
+  fftObjPtr->scaledFFTPairImMany(cavPtrs, ikPtrs, resPtrs);
 
-    gradPtr = gradPtclField.getDataPtr();  // Get gradPtclField data
-    memcpy(gradPtr, resPtr, fftMemSize);   // Copy result into gradField ptr
-    gradPtclField.scale(1.0*scaleFFT);     // Scale factor for FFT
-    gradFieldVec.push_back(gradPtclField); // Set in main list
+  // Loop on spatial components
+  for (size_t ic=0; ic<NDIM; ++ic) {
+    gradPtr = gradPtclField.getDataPtr();    // Get gradPtclField data
+    memcpy(gradPtr, resPtrs[ic], fftMemSize); // Copy result into gradField ptr
+    gradPtclField.scale(1.0*scaleFFT);       // Scale factor for FFT
+    gradFieldVec.push_back(gradPtclField);   // Set in main list
   }
   delete[] resPtr;
   // ***********************************************************************
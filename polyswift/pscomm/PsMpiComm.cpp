@@ -13,7 +13,8 @@
 // pscomm includes
 #include <PsMpiComm.h>
 
-// replacing getMpiComm() --> MPI_COMM_WORLD
+// Collectives use mpiComm, which spans all ranks for the
+// default constructor or a group of them made by split()
 
 //
 // Construct - store data
@@ -25,6 +26,7 @@ PsMpiComm<FLOATTYPE, NDIM>::PsMpiComm() {
   mpiTag = 32767;
   sendingFltArray = false;
   sendingIntArray = false;
+  ownsComm = false;
 
 // Set up the communicators
 #ifndef HAVE_MPI
@@ -49,6 +51,66 @@ PsMpiComm<FLOATTYPE, NDIM>::PsMpiComm() {
 
 }
 
+//
+// Construct for the ranks of parentComm with the same color,
+// ordered as in parentComm
+//
+template <class FLOATTYPE, size_t NDIM>
+PsMpiComm<FLOATTYPE, NDIM>::PsMpiComm(Ps_MPI_Comm parentComm, int color) {
+
+// Set tag and sending array flags
+  mpiTag = 32767;
+  sendingFltArray = false;
+  sendingIntArray = false;
+  ownsComm = true;
+
+#ifndef HAVE_MPI
+  mpiGroup = 0;
+  mpiComm = 0;
+  mpiCommSize = 1;
+  mpiRank = 0;
+  return;
+#else
+
+// Split parent communicator
+  int parentRank;
+  MPI_Comm_rank(parentComm, &parentRank);
+  MPI_Comm_split(parentComm, color, parentRank, &mpiComm);
+  MPI_Comm_group(mpiComm, &mpiGroup);
+  MPI_Comm_size(mpiComm, &mpiCommSize);
+  MPI_Comm_rank(mpiComm, &mpiRank);
+
+// Create float type
+  if (sizeof(FLOATTYPE) == sizeof(float)) mpiFloatType = MPI_FLOAT;
+  else if (sizeof(FLOATTYPE) == sizeof(double)) mpiFloatType = MPI_DOUBLE;
+
+#endif
+
+}
+
+//
+// Free the split communicator and its group, unless MPI has already
+// been finalized (objects destroyed at exit)
+//
+template <class FLOATTYPE, size_t NDIM>
+PsMpiComm<FLOATTYPE, NDIM>::~PsMpiComm() {
+
+#ifdef HAVE_MPI
+  if (!ownsComm) return;
+  int finalized = 0;
+  MPI_Finalized(&finalized);
+  if (finalized) return;
+  MPI_Group_free(&mpiGroup);
+  MPI_Comm_free(&mpiComm);
+#endif
+}
+
+template <class FLOATTYPE, size_t NDIM>
+PsCommBase<FLOATTYPE, NDIM>* PsMpiComm<FLOATTYPE, NDIM>::split(
+     size_t color) const {
+  return new PsMpiComm<FLOATTYPE, NDIM>(mpiComm, (int)color);
+}
+
 template <class FLOATTYPE, size_t NDIM>
 PsTinyVector<int, NDIM> PsMpiComm<FLOATTYPE, NDIM>::broadcastVec(
      PsTinyVector<int, NDIM> tv, size_t sendNode) {
@@ -60,7 +122,7 @@ PsTinyVector<int, NDIM> PsMpiComm<FLOATTYPE, NDIM>::broadcastVec(
   for (size_t i=0; i<vecSize; ++i) {
     intVec[i] = tv[i];
   }
-  MPI_Bcast(&intVec, vecSize, MPI_INT, sendNode, MPI_COMM_WORLD);
+  MPI_Bcast(&intVec, vecSize, MPI_INT, sendNode, mpiComm);
   for (size_t i=0; i<vecSize; ++i) {
     tv[i] = intVec[i];
   }
@@ -73,7 +135,7 @@ void PsMpiComm<FLOATTYPE, NDIM>::allGatherData(size_t* sendData,
     size_t sendSize, size_t* recvData, size_t recvSize) const {
 #ifdef HAVE_MPI
   MPI_Allgather(sendData, (int)sendSize, MPI_UNSIGNED_LONG, recvData,
-      (int)recvSize, MPI_UNSIGNED_LONG, MPI_COMM_WORLD);
+      (int)recvSize, MPI_UNSIGNED_LONG, mpiComm);
 #else
   size_t minSize = sendSize < recvSize ? sendSize : recvSize;
   for (size_t i=0; i<minSize; ++i) recvData[i] = sendData[i];
@@ -85,7 +147,7 @@ void PsMpiComm<FLOATTYPE, NDIM>::allGatherData(FLOATTYPE* sendData,
     size_t sendSize, FLOATTYPE* recvData, size_t recvSize) const {
 #ifdef HAVE_MPI
   MPI_Allgather(sendData, (int)sendSize, this->mpiFloatType, recvData,
-    (int)recvSize, this->mpiFloatType, MPI_COMM_WORLD);
+    (int)recvSize, this->mpiFloatType, mpiComm);
 #else
   size_t minSize = sendSize < recvSize ? sendSize : recvSize;
   for (size_t i=0; i<minSize; ++i) recvData[i] = sendData[i];
@@ -96,7 +158,7 @@ template <class FLOATTYPE, size_t NDIM>
 size_t PsMpiComm<FLOATTYPE, NDIM>::allReduceSum(size_t x) const {
 #ifdef HAVE_MPI
   size_t rcv;
-  MPI_Allreduce(&x, &rcv, 1, MPI_UNSIGNED_LONG, MPI_SUM, MPI_COMM_WORLD);
+  MPI_Allreduce(&x, &rcv, 1, MPI_UNSIGNED_LONG, MPI_SUM, mpiComm);
   return rcv;
 #else
   return x;
@@ -107,7 +169,7 @@ template <class FLOATTYPE, size_t NDIM>
 FLOATTYPE PsMpiComm<FLOATTYPE, NDIM>::allReduceSum(FLOATTYPE x) const {
 #ifdef HAVE_MPI
   FLOATTYPE rcv;
-  MPI_Allreduce(&x, &rcv, 1, getFloatType(), MPI_SUM, MPI_COMM_WORLD);
+  MPI_Allreduce(&x, &rcv, 1, getFloatType(), MPI_SUM, mpiComm);
   return rcv;
 #else
   return x;
@@ -124,7 +186,7 @@ std::vector<FLOATTYPE> PsMpiComm<FLOATTYPE, NDIM>::allReduceMin(std::vector<FLOA
   for (size_t i=0; i<vecSize; ++i) {
     snd[i] = x[i];
   }
-  MPI_Allreduce(snd, rcv, vecSize, getFloatType(), MPI_MIN, MPI_COMM_WORLD);
+  MPI_Allreduce(snd, rcv, vecSize, getFloatType(), MPI_MIN, mpiComm);
 
   std::vector<FLOATTYPE> rcvVec;
   rcvVec.resize(vecSize);
@@ -149,7 +211,7 @@ std::vector<FLOATTYPE> PsMpiComm<FLOATTYPE, NDIM>::allReduceMax(
   for (size_t i=0; i<vecSize; ++i) {
     snd[i] = x[i];
   }
-  MPI_Allreduce(snd, rcv, vecSize, getFloatType(), MPI_MAX, MPI_COMM_WORLD);
+  MPI_Allreduce(snd, rcv, vecSize, getFloatType(), MPI_MAX, mpiComm);
   std::vector<FLOATTYPE> rcvVec;
   rcvVec.resize(vecSize);
    for (size_t i=0; i<vecSize; ++i)
@@ -165,7 +227,7 @@ FLOATTYPE PsMpiComm<FLOATTYPE, NDIM>::allReduceMax(FLOATTYPE xloc) const {
 
 #ifdef HAVE_MPI
   FLOATTYPE xmax;
-  MPI_Allreduce(&xloc, &xmax, 1, getFloatType(), MPI_MAX, MPI_COMM_WORLD);
+  MPI_Allreduce(&xloc, &xmax, 1, getFloatType(), MPI_MAX, mpiComm);
   return xmax;
 #else
   return xloc;
@@ -176,7 +238,7 @@ template <class FLOATTYPE, size_t NDIM>
 void PsMpiComm<FLOATTYPE, NDIM>::allReduceSumVec(FLOATTYPE* vec, size_t numElem,
     FLOATTYPE* vecSum) const {
 #ifdef HAVE_MPI
-  MPI_Allreduce(vec, vecSum, numElem, getFloatType(), MPI_SUM, MPI_COMM_WORLD);
+  MPI_Allreduce(vec, vecSum, numElem, getFloatType(), MPI_SUM, mpiComm);
 #else
   for (size_t i=0; i<numElem; ++i) {
     vecSum[i] = vec[i];
@@ -187,7 +249,7 @@ void PsMpiComm<FLOATTYPE, NDIM>::allReduceSumVec(FLOATTYPE* vec, size_t numElem,
 template <class FLOATTYPE, size_t NDIM>
 void PsMpiComm<FLOATTYPE, NDIM>::allReduceSumVec(int* vec, size_t numElem, int* vecSum) const {
 #ifdef HAVE_MPI
-  MPI_Allreduce(vec, vecSum, numElem, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+  MPI_Allreduce(vec, vecSum, numElem, MPI_INT, MPI_SUM, mpiComm);
 #else
   for (size_t i=0; i<numElem; ++i) {
     vecSum[i] = vec[i];
@@ -227,7 +289,7 @@ void PsMpiComm<FLOATTYPE, NDIM>::allReduceSumVec(
     rcv[vecIndx+2] = 0;
   }
 
-  MPI_Allreduce(snd, rcv, vecSize, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+  MPI_Allreduce(snd, rcv, vecSize, MPI_INT, MPI_SUM, mpiComm);
 
   for (size_t ivec=0; ivec<numElementsVec; ++ivec) {
     size_t vecIndx = ivec*NDIM;
@@ -254,7 +316,7 @@ template <class FLOATTYPE, size_t NDIM>
 void PsMpiComm<FLOATTYPE, NDIM>::allReduceMin(size_t* x, size_t numElem,
      size_t* xmin) const {
 #ifdef HAVE_MPI
-  MPI_Allreduce(x, xmin, numElem, MPI_UNSIGNED_LONG, MPI_MIN, MPI_COMM_WORLD);
+  MPI_Allreduce(x, xmin, numElem, MPI_UNSIGNED_LONG, MPI_MIN, mpiComm);
 #else
   for (size_t i=0; i<numElem; ++i) {
     xmin[i] = x[i];
@@ -266,7 +328,7 @@ template <class FLOATTYPE, size_t NDIM>
 void PsMpiComm<FLOATTYPE, NDIM>::allReduceMax(size_t* x, size_t numElem,
      size_t* xmax) const {
 #ifdef HAVE_MPI
-  MPI_Allreduce(x, xmax, numElem, MPI_UNSIGNED_LONG, MPI_MAX, MPI_COMM_WORLD);
+  MPI_Allreduce(x, xmax, numElem, MPI_UNSIGNED_LONG, MPI_MAX, mpiComm);
 #else
   for (size_t i=0; i<numElem; ++i) {
     xmax[i] = x[i];
@@ -295,7 +357,7 @@ void PsMpiComm<FLOATTYPE, NDIM>::sendArray(FLOATTYPE* array, size_t numElem,
 
 // send array
   int res = MPI_Isend(this->sendFltBuf, numElem, getFloatType(), recvRank,
-      mpiTag, MPI_COMM_WORLD, &arrayFltSndReq);
+      mpiTag, mpiComm, &arrayFltSndReq);
 
   sendingFltArray = true;
 
@@ -326,7 +388,7 @@ void PsMpiComm<FLOATTYPE, NDIM>::sendArray(int* array, size_t numElem,
 
 // send array
   int res = MPI_Isend(this->sendIntBuf, numElem, MPI_INT,
-      recvRank, mpiTag, MPI_COMM_WORLD, &arrayIntSndReq);
+      recvRank, mpiTag, mpiComm, &arrayIntSndReq);
 
   sendingIntArray = true;
 
@@ -349,7 +411,7 @@ void PsMpiComm<FLOATTYPE, NDIM>::recvArray(FLOATTYPE* array, size_t numElem,
 
 // Receive the array into the buffer
   res = MPI_Recv(this->recvFltBuf, numElem, getFloatType(),
-      sendRank, mpiTag, MPI_COMM_WORLD, &locMpiStatus);
+      sendRank, mpiTag, mpiComm, &locMpiStatus);
 
 // copy buffer into array
   for (size_t i=0; i<numElem; ++i)
@@ -373,7 +435,7 @@ void PsMpiComm<FLOATTYPE, NDIM>::recvArray(int* array, size_t numElem,
 
 // Receive the particles into the buffer
   res = MPI_Recv(this->recvIntBuf, numElem, MPI_INT,
-      sendRank, mpiTag, MPI_COMM_WORLD, &locMpiStatus);
+      sendRank, mpiTag, mpiComm, &locMpiStatus);
 
 // copy buffer into array
   for (size_t i=0; i<numElem; ++i)
@@ -393,7 +455,7 @@ void PsMpiComm<FLOATTYPE, NDIM>::recvArrayAndResize(FLOATTYPE* &array,
   MPI_Status locMpiStatus;
 
 // Determine the size of the incoming data
-  res = MPI_Probe(sendRank, mpiTag, MPI_COMM_WORLD, &locMpiStatus);
+  res = MPI_Probe(sendRank, mpiTag, mpiComm, &locMpiStatus);
   res = MPI_Get_count(&locMpiStatus, getFloatType(), &numIncElem);
 
 // Resize the receiving array so it is large enough
@@ -401,7 +463,7 @@ void PsMpiComm<FLOATTYPE, NDIM>::recvArrayAndResize(FLOATTYPE* &array,
 
 // Receive the data into the array
   res = MPI_Recv(array, numElem, getFloatType(), sendRank, mpiTag,
-       MPI_COMM_WORLD, &locMpiStatus);
+       mpiComm, &locMpiStatus);
 #else
   numElem = 0;
 #endif
@@ -419,7 +481,7 @@ void PsMpiComm<FLOATTYPE, NDIM>::allGatherV(FLOATTYPE* sendData,
   int* displacements = new int[nProcs];
   int count = sendSize;
 
-  MPI_Allgather(&count, 1, MPI_INT, counts, 1, MPI_INT, MPI_COMM_WORLD);
+  MPI_Allgather(&count, 1, MPI_INT, counts, 1, MPI_INT, mpiComm);
 
   displacements[0] = 0;
   for (size_t i=1;i<nProcs;i++) {
@@ -431,7 +493,7 @@ void PsMpiComm<FLOATTYPE, NDIM>::allGatherV(FLOATTYPE* sendData,
   recvData = new FLOATTYPE[totalNum];
 
   //
-  MPI_Allgatherv(sendData, count,  mpiFloatType, recvData, counts, displacements,  mpiFloatType, MPI_COMM_WORLD);
+  MPI_Allgatherv(sendData, count,  mpiFloatType, recvData, counts, displacements,  mpiFloatType, mpiComm);
 
   recvSize = new size_t[nProcs];
   displs =  new size_t[nProcs];
@@ -460,7 +522,7 @@ void PsMpiComm<FLOATTYPE, NDIM>::allGatherVS(size_t* sendData, size_t sendSize,
 
 // Use Allgather to get sizes of receive arrays
   MPI_Allgather(&sendSize, 1, MPI_UNSIGNED_LONG, recvSize, 1,
-      MPI_UNSIGNED_LONG, MPI_COMM_WORLD);
+      MPI_UNSIGNED_LONG, mpiComm);
 
   size_t globalSize = 0;
   for (size_t i=0; i<numProc; ++i) {
@@ -484,7 +546,7 @@ void PsMpiComm<FLOATTYPE, NDIM>::allGatherVS(size_t* sendData, size_t sendSize,
   }
 // broadcast from each rank
   for (size_t i=0; i<numProc; ++i) MPI_Bcast(&recvData[displs[i]], recvSize[i],
-      MPI_UNSIGNED_LONG, i, MPI_COMM_WORLD);
+      MPI_UNSIGNED_LONG, i, mpiComm);
   return;
 #endif
 }
@@ -505,7 +567,7 @@ void PsMpiComm<FLOATTYPE, NDIM>::allGatherVS(FLOATTYPE* sendData,
 
 // Use Allgather to get sizes of receive arrays
   MPI_Allgather(&sendSize, 1, MPI_UNSIGNED_LONG, recvSize, 1,
-       MPI_UNSIGNED_LONG, MPI_COMM_WORLD);
+       MPI_UNSIGNED_LONG, mpiComm);
   // allGatherData(&sendSize, 1, recvSize, 1);
 
   size_t globalSize = 0;
@@ -530,7 +592,7 @@ void PsMpiComm<FLOATTYPE, NDIM>::allGatherVS(FLOATTYPE* sendData,
   }
 // broadcast from each rank
   for (size_t i=0; i<numProc; ++i)
-    MPI_Bcast(&recvData[displs[i]], recvSize[i], mpiFloatType, i, MPI_COMM_WORLD);
+    MPI_Bcast(&recvData[displs[i]], recvSize[i], mpiFloatType, i, mpiComm);
     return;
 #endif
 }
@@ -560,7 +622,7 @@ void PsMpiComm<FLOATTYPE, NDIM>::allToAllV(FLOATTYPE* sendData, size_t* sendSize
   }
 
   mpi_err = MPI_Alltoall(sendSizeInt, 1, MPI_INT,
-       recvSizeInt, 1, MPI_INT, MPI_COMM_WORLD);
+       recvSizeInt, 1, MPI_INT, mpiComm);
 
   sendDisplsInt[0]=0;
   for (i=1;i<nProcs;i++) {
@@ -580,7 +642,7 @@ void PsMpiComm<FLOATTYPE, NDIM>::allToAllV(FLOATTYPE* sendData, size_t* sendSize
   recvData= new FLOATTYPE[recvTotalSize];
 
   mpi_err = MPI_Alltoallv(sendData, sendSizeInt, sendDisplsInt, mpiFloatType,
-      recvData, recvSizeInt, recvDisplsInt, mpiFloatType, MPI_COMM_WORLD);
+      recvData, recvSizeInt, recvDisplsInt, mpiFloatType, mpiComm);
 
   for (i=0;i<nProcs;i++) {
     recvSize[i]=recvSizeInt[i];
@@ -50,9 +50,26 @@ class PsMpiComm : public PsCommBase<FLOATTYPE, NDIM> {
     PsMpiComm();
 
 /**
- * Destructor
+ * Constructor: split parentComm and store the MPI variables
+ * for the group of ranks with the same color
+ *
+ * @param parentComm communicator to split
+ * @param color      group of this rank
  */
-    virtual ~PsMpiComm() {}
+    PsMpiComm(Ps_MPI_Comm parentComm, int color);
+
+/**
+ * Destructor: frees the communicator and group made by split
+ */
+    virtual ~PsMpiComm();
+
+/**
+ * Make a communicator for the ranks of this one with the same color
+ *
+ * @param color group of this rank
+ * @return new communicator (owned by caller)
+ */
+    virtual PsCommBase<FLOATTYPE, NDIM>* split(size_t color) const;
 
 /**
  * Get the MPI type for FLOATTYPE
@@ -413,6 +430,9 @@ class PsMpiComm : public PsCommBase<FLOATTYPE, NDIM> {
 /** Flag indicating float array send status */
     mutable bool sendingIntArray;
 
+/** Flag for a communicator made by split, freed in the destructor */
+    bool ownsComm;
+
 };
 
 #endif // PS_MPI_COMM_H
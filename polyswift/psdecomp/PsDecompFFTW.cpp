@@ -10,6 +10,9 @@
  * All rights reserved.
  */
 
+// std includes
+#include <algorithm>
+
 // psdecomp includes
 #include <PsDecompFFTW.h>
 
@@ -19,6 +22,7 @@ PsDecompFFTW<FLOATTYPE, NDIM>::PsDecompFFTW() {
 
   // Defaults to NORMAL data layout
   transposeFlag = false;
+  replicatedFlag = false;
 }
 
 // Destructor
@@ -40,6 +44,12 @@ void PsDecompFFTW<FLOATTYPE, NDIM>::setAttrib(const TxHierAttribSetIntDbl& tas)
     if (tStr == "on") transposeFlag = true;
   }
 
+  // Whole grid on every rank, eg. for PsPolyDisperseBCP quadrature groups
+  if (tas.hasString("replicated")) {
+    std::string rStr = tas.getString("replicated");
+    if (rStr == "on") replicatedFlag = true;
+  }
+
 }
 
 //
@@ -100,29 +110,54 @@ void PsDecompFFTW<FLOATTYPE, NDIM>::build() {
     planDims[n] = dims[n];
   }
 
-  #ifndef HAVE_MPI
   //
   // Setting FFTW size info from global
-  // so these can be used to setup data structures
+  // so these can be used to setup data structures,
+  // the serial and replicated decomps stop here
   //
   local_nx = planDims[0];
   local_ny_after_transpose = planDims[1];
   for (int n=0; n<rank; ++n) {
     total_local_size = total_local_size * planDims[n];
   }
-  #endif // SERIAL
 
-  #ifdef HAVE_MPI
+  #if defined(HAVE_MPI) && defined(HAVE_FFTW3)
+  if (!replicatedFlag) {
+
+    //
+    // Same block distribution as the FFTW3 MPI plans (and FFTW2),
+    // ceil(n/numRanks) planes per rank for both slab directions
+    //
+    int myRank = 0;
+    int numRanks = 1;
+    MPI_Comm_rank(MPI_COMM_WORLD, &myRank);
+    MPI_Comm_size(MPI_COMM_WORLD, &numRanks);
+
+    int xBlock = (planDims[0] + numRanks - 1)/numRanks;
+    int yBlock = (planDims[1] + numRanks - 1)/numRanks;
+    local_x_start = std::min(myRank*xBlock, planDims[0]);
+    local_nx = std::min(xBlock, planDims[0] - local_x_start);
+    local_y_start_after_transpose = std::min(myRank*yBlock, planDims[1]);
+    local_ny_after_transpose =
+        std::min(yBlock, planDims[1] - local_y_start_after_transpose);
+
+    total_local_size = local_nx;
+    for (int n=1; n<rank; ++n) total_local_size *= planDims[n];
+  }
+
+  #elif defined(HAVE_MPI)
+  if (!replicatedFlag) {
 
-  /** FFTW plan for forward transforms */
-  fftwnd_mpi_plan forwardPlan =
-      fftwnd_mpi_create_plan(MPI_COMM_WORLD,
-      rank, planDims, FFTW_FORWARD, FFTW_ESTIMATE);
+    /** FFTW plan for forward transforms */
+    fftwnd_mpi_plan forwardPlan =
+        fftwnd_mpi_create_plan(MPI_COMM_WORLD,
+        rank, planDims, FFTW_FORWARD, FFTW_ESTIMATE);
 
-  // Set FFTW decomp parameters
-  fftwnd_mpi_local_sizes(forwardPlan,
-      &local_nx, &local_x_start, &local_ny_after_transpose,
-      &local_y_start_after_transpose, &total_local_size);
+    // Set FFTW decomp parameters
+    fftwnd_mpi_local_sizes(forwardPlan,
+        &local_nx, &local_x_start, &local_ny_after_transpose,
+        &local_y_start_after_transpose, &total_local_size);
+  }
 
   #endif // PARALLEL
 
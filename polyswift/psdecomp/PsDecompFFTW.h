@@ -22,11 +22,14 @@
 #include <config.h>
 #endif
 
+// FFTW3 builds do not link FFTW2, see PsDecompFFTW::build
 #ifdef HAVE_MPI
 #define MPICH_IGNORE_CXX_SEEK
 #include <mpi.h>
+#ifndef HAVE_FFTW3
 #include <fftw_mpi.h>
-#else
+#endif
+#elif !defined(HAVE_FFTW3)
 #include <fftw.h>
 #endif
 
@@ -93,6 +96,24 @@ class PsDecompFFTW : public PsDecomp<FLOATTYPE, NDIM> {
  */
     virtual bool hasPosition(PsTinyVector<int, NDIM> globalPos);
 
+/**
+ * Check if the local domain is the transposed (y-slab) layout
+ *
+ * @return true if transposeFlag set
+ */
+    virtual bool isTransposed() {
+      return transposeFlag;
+    }
+
+/**
+ * Check if every rank holds the whole grid
+ *
+ * @return true if replicated set
+ */
+    virtual bool isReplicated() {
+      return replicatedFlag;
+    }
+
   protected:
 
   private:
@@ -103,6 +124,9 @@ class PsDecompFFTW : public PsDecomp<FLOATTYPE, NDIM> {
     /** Flag to grab transpose plan results from FFTW */
     bool transposeFlag;
 
+    /** Flag for the whole grid on every rank */
+    bool replicatedFlag;
+
     /** Constructor private to prevent use */
     PsDecompFFTW(const PsDecompFFTW<FLOATTYPE, NDIM>& psbcp);
 
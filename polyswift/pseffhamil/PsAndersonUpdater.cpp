@@ -0,0 +1,265 @@
+/**
+ *
+ * @file    PsAndersonUpdater.cpp
+ *
+ * @brief   Class for updating fields with Anderson mixing
+ *
+ * @version $Id: PsAndersonUpdater.cpp 8257 2007-09-12 22:05:20Z swsides $
+ *
+ * Copyright &copy; 2008-2020, Tech-X Corporation, Boulder, CO.
+ * All rights reserved.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+// std includes
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <algorithm>
+
+// pseffhamil includes
+#include <PsAndersonUpdater.h>
+
+// Constructor
+template <class FLOATTYPE, size_t NDIM>
+PsAndersonUpdater<FLOATTYPE, NDIM>::PsAndersonUpdater() {
+  numHistory = 5;
+  numStartSteps = 1;
+  mixParam = 1.0;
+  numIterates = 0;
+  fieldSize = 0;
+}
+
+// Destructor
+template <class FLOATTYPE, size_t NDIM>
+PsAndersonUpdater<FLOATTYPE, NDIM>::~PsAndersonUpdater() {
+  history.clear();
+  lsqSystem.clear();
+  lsqWork.clear();
+  mixCoeffs.clear();
+}
+
+template <class FLOATTYPE, size_t NDIM>
+void PsAndersonUpdater<FLOATTYPE, NDIM>::setAttrib(
+    const TxHierAttribSetIntDbl& tas) {
+
+  // Scoping call to base class
+  PsSteepDUpdater<FLOATTYPE, NDIM>::setAttrib(tas);
+
+  this->dbprt("PsAndersonUpdater::setAttrib() ");
+
+  // Number of previous iterates in mixing
+  if (tas.hasOption("numHistory")) {
+    numHistory = (size_t) tas.getOption("numHistory");
+  }
+
+  // Steepest-descent updates before mixing
+  if (tas.hasOption("numStartSteps")) {
+    numStartSteps = (size_t) tas.getOption("numStartSteps");
+  }
+
+  // Fraction of mixed residual
+  if (tas.hasParam("mixParam")) {
+    double tmp = tas.getParam("mixParam");
+    mixParam = (FLOATTYPE) tmp;
+  }
+}
+
+template <class FLOATTYPE, size_t NDIM>
+void PsAndersonUpdater<FLOATTYPE, NDIM>::buildSolvers() {
+
+  // Scoping call to base class
+  PsSteepDUpdater<FLOATTYPE, NDIM>::buildSolvers();
+  this->dbprt("PsAndersonUpdater::buildSolvers() ");
+
+  // All histories allocated once
+  fieldSize = this->resField->getSize();
+  size_t nslots = numHistory + 1;
+  history.assign(2*nslots*this->numUpdateFields*fieldSize, 0.0);
+  lsqSystem.assign(numHistory*(numHistory+1), 0.0);
+  lsqWork.assign(numHistory*(numHistory+1), 0.0);
+  mixCoeffs.assign(numHistory, 0.0);
+  numIterates = 0;
+
+  this->pprt("Anderson mixing with numHistory = ", (int)numHistory);
+}
+
+//
+// Ring buffer slots are overwritten before they are read again
+//
+template <class FLOATTYPE, size_t NDIM>
+void PsAndersonUpdater<FLOATTYPE, NDIM>::resetHistory() {
+
+  // Scoping call to base class
+  PsSteepDUpdater<FLOATTYPE, NDIM>::resetHistory();
+  this->dbprt("PsAndersonUpdater::resetHistory() ");
+
+  numIterates = 0;
+}
+
+//
+// Mixed update
+//   w_new = wbar + mixParam*dbar
+//   wbar  = w_k - sum_i c_i*(w_k - w_{k-i})
+//   dbar  = d_k - sum_i c_i*(d_k - d_{k-i})
+// where d is the steepest-descent step and c minimizes |dbar|
+//
+template <class FLOATTYPE, size_t NDIM>
+void PsAndersonUpdater<FLOATTYPE, NDIM>::update(double t) {
+
+  // Scoping call to base class
+  PsPolymerUpdater<FLOATTYPE, NDIM>::update(t);
+  this->dbprt("PsAndersonUpdater::update() ");
+
+  // If not updating this time step...exit
+  if (!this->updateFlag) return;
+
+  // Calc tot contrib to dHTotals for all updateFields
+  this->update_dHTotals();
+  this->calcResidual();
+
+  // Store current fields and residuals
+  size_t k = numIterates;
+  PsFieldBase<FLOATTYPE>& xField = *(this->resField);
+  for (size_t n=0; n<this->numUpdateFields; ++n) {
+    PsFieldBase<FLOATTYPE>& wField = this->updateFields[n]->getConjgField();
+    this->calcFieldStep(n, xField);
+    std::memcpy(getHistory(k, n, false), wField.getConstDataPtr(),
+        fieldSize*sizeof(FLOATTYPE));
+    std::memcpy(getHistory(k, n, true), xField.getConstDataPtr(),
+        fieldSize*sizeof(FLOATTYPE));
+  }
+
+  // Number of previous iterates to mix
+  size_t nh = 0;
+  if (k >= numStartSteps) nh = std::min(k, numHistory);
+
+  //
+  // Local parts of U_ij = <d_k-d_{k-i}, d_k-d_{k-j}>
+  // and V_i = <d_k-d_{k-i}, d_k>, summed over update fields
+  // and reduced over ranks in one call
+  //
+  if (nh > 0) {
+    size_t nsys = nh*(nh+1);
+    for (size_t i=0; i<nh; ++i) {
+      for (size_t j=i; j<nh; ++j) {
+        double uij = 0.0;
+        for (size_t n=0; n<this->numUpdateFields; ++n) {
+          const FLOATTYPE* dk = getHistory(k, n, true);
+          const FLOATTYPE* di = getHistory(k-i-1, n, true);
+          const FLOATTYPE* dj = getHistory(k-j-1, n, true);
+          for (size_t l=0; l<fieldSize; ++l)
+            uij += (dk[l] - di[l])*(dk[l] - dj[l]);
+        }
+        lsqWork[i*nh + j] = (FLOATTYPE) uij;
+        lsqWork[j*nh + i] = (FLOATTYPE) uij;
+      }
+
+      double vi = 0.0;
+      for (size_t n=0; n<this->numUpdateFields; ++n) {
+        const FLOATTYPE* dk = getHistory(k, n, true);
+        const FLOATTYPE* di = getHistory(k-i-1, n, true);
+        for (size_t l=0; l<fieldSize; ++l)
+          vi += (dk[l] - di[l])*dk[l];
+      }
+      lsqWork[nh*nh + i] = (FLOATTYPE) vi;
+    }
+    this->getCommBase().allReduceSumVec(&lsqWork[0], nsys, &lsqSystem[0]);
+  }
+
+  // Drop oldest iterates until system is solvable
+  size_t nhMax = nh;
+  while ( (nh > 0) && !solveMixCoeffs(nh, nhMax) ) --nh;
+  if (nh < nhMax) {
+    this->dbprt("...singular Anderson system, using numHistory = ", (int)nh);
+  }
+
+  // Replace new values in update fields
+  for (size_t n=0; n<this->numUpdateFields; ++n) {
+    PsFieldBase<FLOATTYPE>& wField = this->updateFields[n]->getConjgField();
+    FLOATTYPE* w = wField.getDataPtr();
+    const FLOATTYPE* wk = getHistory(k, n, false);
+    const FLOATTYPE* dk = getHistory(k, n, true);
+
+    for (size_t l=0; l<fieldSize; ++l)
+      w[l] = wk[l] + mixParam*dk[l];
+
+    for (size_t i=0; i<nh; ++i) {
+      const FLOATTYPE* wi = getHistory(k-i-1, n, false);
+      const FLOATTYPE* di = getHistory(k-i-1, n, true);
+      FLOATTYPE ci = mixCoeffs[i];
+      for (size_t l=0; l<fieldSize; ++l)
+        w[l] -= ci*( (wk[l] - wi[l]) + mixParam*(dk[l] - di[l]) );
+    }
+  }
+  ++numIterates;
+
+  // Noise and pressure from new update fields
+  this->update_presFields();
+
+  // Update constraint physical field class specifics
+  this->constraintFieldPtr->updatePres();
+  this->calcFeField();
+
+} // end update
+
+//
+// Gaussian elimination with partial pivoting on the leading
+// nh x nh block of U and first nh entries of V
+//
+template <class FLOATTYPE, size_t NDIM>
+bool PsAndersonUpdater<FLOATTYPE, NDIM>::solveMixCoeffs(size_t nh,
+    size_t nhMax) {
+
+  // Copy sub-system, augmented column holds V
+  size_t nc = nh + 1;
+  FLOATTYPE umax = 0.0;
+  for (size_t i=0; i<nh; ++i) {
+    for (size_t j=0; j<nh; ++j) lsqWork[i*nc + j] = lsqSystem[i*nhMax + j];
+    lsqWork[i*nc + nh] = lsqSystem[nhMax*nhMax + i];
+    umax = std::max(umax, (FLOATTYPE)std::fabs(lsqSystem[i*nhMax + i]));
+  }
+  if (umax <= 0.0) return false;
+  FLOATTYPE tiny = umax*std::numeric_limits<FLOATTYPE>::epsilon()*nh;
+
+  // Forward elimination
+  for (size_t p=0; p<nh; ++p) {
+
+    size_t prow = p;
+    for (size_t i=p+1; i<nh; ++i) {
+      if (std::fabs(lsqWork[i*nc + p]) > std::fabs(lsqWork[prow*nc + p]))
+        prow = i;
+    }
+    if (std::fabs(lsqWork[prow*nc + p]) <= tiny) return false;
+    if (prow != p) {
+      for (size_t j=p; j<nc; ++j)
+        std::swap(lsqWork[p*nc + j], lsqWork[prow*nc + j]);
+    }
+
+    for (size_t i=p+1; i<nh; ++i) {
+      FLOATTYPE f = lsqWork[i*nc + p]/lsqWork[p*nc + p];
+      for (size_t j=p; j<nc; ++j) lsqWork[i*nc + j] -= f*lsqWork[p*nc + j];
+    }
+  }
+
+  // Back substitution
+  for (size_t i=nh; i-- > 0; ) {
+    FLOATTYPE sum = lsqWork[i*nc + nh];
+    for (size_t j=i+1; j<nh; ++j) sum -= lsqWork[i*nc + j]*mixCoeffs[j];
+    mixCoeffs[i] = sum/lsqWork[i*nc + i];
+  }
+
+  return true;
+}
+
+// Instantiate classes
+template class PsAndersonUpdater<float, 1>;
+template class PsAndersonUpdater<float, 2>;
+template class PsAndersonUpdater<float, 3>;
+
+template class PsAndersonUpdater<double, 1>;
+template class PsAndersonUpdater<double, 2>;
+template class PsAndersonUpdater<double, 3>;
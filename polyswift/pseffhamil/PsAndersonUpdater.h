@@ -0,0 +1,154 @@
+/**
+ *
+ * @file    PsAndersonUpdater.h
+ *
+ * @brief   Class for updating fields with Anderson mixing
+ *
+ * @version $Id: PsAndersonUpdater.h 8199 2007-09-05 05:07:11Z swsides $
+ *
+ * Copyright &copy; 2008-2020, Tech-X Corporation, Boulder, CO.
+ * All rights reserved.
+ */
+
+#ifndef PS_ANDERSON_UPDATER_H
+#define PS_ANDERSON_UPDATER_H
+
+// standard headers
+#include <vector>
+
+// configure stuff
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#undef HAVE_CONFIG_H
+#endif
+
+// txbase headers
+#include <TxDebugExcept.h>
+
+// pseffhamil includes
+#include <PsSteepDUpdater.h>
+
+/**
+ * A PsAndersonUpdater object updates fields with Anderson mixing
+ * over the last numHistory iterates. The residual of each iterate is
+ * the steepest-descent step (relaxlambdas) so with mixParam = 1 the
+ * first numStartSteps updates and the numHistory = 0 case reduce to
+ * PsSteepDUpdater.
+ *
+ * The field and residual histories live in one ring buffer allocated
+ * in buildSolvers, and the small least-squares system is reduced over
+ * all ranks with a single collective per update.
+ *
+ * @param FLOATTYPE numeric type of the data.
+ * @param NDIM dimensionality of the physical space
+ */
+
+template <class FLOATTYPE, size_t NDIM>
+class PsAndersonUpdater : public PsSteepDUpdater<FLOATTYPE, NDIM> {
+
+  public:
+
+/**
+ * Constructor
+ *
+ */
+    PsAndersonUpdater();
+
+/**
+ * Destructor
+ */
+    virtual ~PsAndersonUpdater();
+
+/**
+ * Set the parameters
+ *
+ * @param tas the parameters
+ */
+    virtual void setAttrib(const TxHierAttribSetIntDbl& tas);
+
+/**
+ * Build the solvers structures
+ */
+    virtual void buildSolvers();
+
+/**
+ * Update the updater
+ *
+ * @param t the time
+ */
+    virtual void update(double t);
+
+/**
+ * Drop the mixing history, the next numStartSteps updates are
+ * steepest-descent again
+ */
+    virtual void resetHistory();
+
+  private:
+
+    /** Number of previous iterates used in mixing */
+    size_t numHistory;
+
+    /** Number of steepest-descent updates before mixing starts */
+    size_t numStartSteps;
+
+    /** Fraction of the mixed residual added to the mixed field */
+    FLOATTYPE mixParam;
+
+    /**
+     * Number of update calls since buildSolvers (initialize is
+     * called every step so the history is not reset there)
+     */
+    size_t numIterates;
+
+    /** Number of values in one update field */
+    size_t fieldSize;
+
+    /**
+     * Ring buffer of (numHistory+1) slots, each holding the
+     * updateFields followed by their residuals
+     */
+    std::vector<FLOATTYPE> history;
+
+    /** Least-squares matrix and right-hand side, reduced together */
+    std::vector<FLOATTYPE> lsqSystem;
+
+    /** Work copy of lsqSystem for elimination */
+    std::vector<FLOATTYPE> lsqWork;
+
+    /** Mixing coefficients for the previous iterates */
+    std::vector<FLOATTYPE> mixCoeffs;
+
+    /**
+     * Get pointer into history ring buffer
+     *
+     * @param iter iterate number
+     * @param n    index of update field
+     * @param res  true for residual, false for field
+     */
+    FLOATTYPE* getHistory(size_t iter, size_t n, bool res) {
+      size_t slot = iter % (numHistory+1);
+      size_t offset = (2*slot*this->numUpdateFields +
+          (res ? this->numUpdateFields : 0) + n)*fieldSize;
+      return &history[offset];
+    }
+
+    /**
+     * Solve the leading nh x nh part of the least-squares system
+     * for mixCoeffs
+     *
+     * @param nh    number of previous iterates used
+     * @param nhMax number of previous iterates in lsqSystem
+     * @return true if the system was not singular
+     */
+    bool solveMixCoeffs(size_t nh, size_t nhMax);
+
+    /** Constructor private to prevent use */
+    PsAndersonUpdater(const PsAndersonUpdater<FLOATTYPE, NDIM>& psb);
+
+   /** Assignment private to prevent use */
+    PsAndersonUpdater<FLOATTYPE, NDIM>& operator=(
+       const PsAndersonUpdater<FLOATTYPE, NDIM>& psb);
+};
+
+#endif  // PS_ANDERSON_UPDATER_H
@@ -0,0 +1,174 @@
+/**
+ *
+ * @file    PsBoxRelaxUpdater.cpp
+ *
+ * @brief   Class for relaxing the cell sizes of the simulation box
+ *
+ * @version $Id: PsBoxRelaxUpdater.cpp 8257 2007-09-12 22:05:20Z swsides $
+ *
+ * Copyright &copy; 2008-2020, Tech-X Corporation, Boulder, CO.
+ * All rights reserved.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+// std includes
+#include <cmath>
+#include <sstream>
+#include <algorithm>
+
+// pseffhamil includes
+#include <PsBoxRelaxUpdater.h>
+
+// Constructor
+template <class FLOATTYPE, size_t NDIM>
+PsBoxRelaxUpdater<FLOATTYPE, NDIM>::PsBoxRelaxUpdater() {
+  boxStep = 0.0;
+  maxStrain = 0.02;
+  boxResidual = 0.0;
+  boxChanged = false;
+}
+
+// Destructor
+template <class FLOATTYPE, size_t NDIM>
+PsBoxRelaxUpdater<FLOATTYPE, NDIM>::~PsBoxRelaxUpdater() {
+  grids.clear();
+  polymers.clear();
+}
+
+template <class FLOATTYPE, size_t NDIM>
+void PsBoxRelaxUpdater<FLOATTYPE, NDIM>::setAttrib(
+    const TxHierAttribSetIntDbl& tas) {
+
+  // Scoping call to base class
+  PsUpdater<FLOATTYPE, NDIM>::setAttrib(tas);
+
+  this->dbprt("PsBoxRelaxUpdater::setAttrib() ");
+
+  // Names of grids to change
+  if (tas.hasStrVec("grids")) {
+    gridNames = tas.getStrVec("grids");
+  }
+  else {
+    TxDebugExcept tde("PsBoxRelaxUpdater::setAttrib: grids not set");
+    tde << " in <Updater " << this->getName() << " >";
+    throw tde;
+  }
+
+  // Relative step per unit L dF/dL
+  if (tas.hasParam("boxStep")) {
+    double tmp = tas.getParam("boxStep");
+    boxStep = (FLOATTYPE) tmp;
+  }
+  else {
+    TxDebugExcept tde("PsBoxRelaxUpdater::setAttrib: boxStep not set");
+    tde << " in <Updater " << this->getName() << " >";
+    throw tde;
+  }
+
+  // Limit on relative change in one update
+  if (tas.hasParam("maxStrain")) {
+    double tmp = tas.getParam("maxStrain");
+    maxStrain = (FLOATTYPE) tmp;
+  }
+  if (maxStrain <= 0.0 || maxStrain >= 1.0) {
+    TxDebugExcept tde("PsBoxRelaxUpdater::setAttrib: maxStrain must be");
+    tde << " in (0, 1) in <Updater " << this->getName() << " >";
+    throw tde;
+  }
+}
+
+template <class FLOATTYPE, size_t NDIM>
+void PsBoxRelaxUpdater<FLOATTYPE, NDIM>::buildSolvers() {
+
+  // Scoping call to base class
+  PsUpdater<FLOATTYPE, NDIM>::buildSolvers();
+  this->dbprt("PsBoxRelaxUpdater::buildSolvers() ");
+
+  for (size_t n=0; n<gridNames.size(); ++n) {
+    PsGridBase<FLOATTYPE, NDIM>* gridPtr =
+      PsNamedObject::getObject<PsGridBase<FLOATTYPE, NDIM> >(gridNames[n]);
+    if (!gridPtr) {
+      TxDebugExcept tde("PsBoxRelaxUpdater::buildSolvers: grid ");
+      tde << gridNames[n] << " not found in <Updater ";
+      tde << this->getName() << " >";
+      throw tde;
+    }
+    grids.push_back(gridPtr);
+  }
+
+  // Polymers compute the box-length derivatives from now on
+  std::vector<std::string> polymerNames =
+    PsPolymer<FLOATTYPE, NDIM>::getPolymerNames();
+  for (size_t i=0; i<polymerNames.size(); ++i) {
+    PsPolymer<FLOATTYPE, NDIM>* polymerPtr =
+      PsNamedObject::getObject<PsPolymer<FLOATTYPE, NDIM> >(polymerNames[i]);
+    polymerPtr->setCalcStress(true);
+    polymers.push_back(polymerPtr);
+    this->dbprt("PsBoxRelaxUpdater storing Polymer: ", polymerPtr->getName());
+  }
+}
+
+//
+// Uses the derivatives from the polymer solves of this step,
+// the new k-space operators are used from the next step
+//
+template <class FLOATTYPE, size_t NDIM>
+void PsBoxRelaxUpdater<FLOATTYPE, NDIM>::update(double t) {
+
+  // Scoping call to base class
+  PsUpdater<FLOATTYPE, NDIM>::update(t);
+  this->dbprt("PsBoxRelaxUpdater::update() ");
+
+  // If not updating this time step...exit
+  boxChanged = false;
+  if (!this->updateFlag) return;
+
+  // g_i = L_i dF/dL_i summed over polymers
+  std::vector<FLOATTYPE> gBox;
+  for (size_t p=0; p<polymers.size(); ++p) {
+    std::vector<FLOATTYPE> stress = polymers[p]->getStress();
+    FLOATTYPE fac = polymers[p]->getVolfrac()/polymers[p]->getLengthRatio();
+    gBox.resize(stress.size(), 0.0);
+    for (size_t i=0; i<stress.size(); ++i) gBox[i] -= fac*stress[i];
+  }
+
+  // Relative change of each direction
+  boxResidual = 0.0;
+  std::vector<FLOATTYPE> strain(gBox.size(), 0.0);
+  for (size_t i=0; i<gBox.size(); ++i) {
+    boxResidual = std::max(boxResidual, (FLOATTYPE)std::fabs(gBox[i]));
+    FLOATTYPE s = -boxStep*gBox[i];
+    strain[i] = std::max(-maxStrain, std::min(maxStrain, s));
+  }
+
+  // Same strain applied to all listed grids
+  for (size_t n=0; n<grids.size(); ++n) {
+    std::vector<FLOATTYPE> cellSizes = grids[n]->getCellSizes();
+    for (size_t i=0; i<cellSizes.size() && i<strain.size(); ++i)
+      cellSizes[i] *= (1.0 + strain[i]);
+    grids[n]->setCellSizes(cellSizes);
+  }
+
+  for (size_t p=0; p<polymers.size(); ++p) polymers[p]->rebuildKSpace();
+  boxChanged = true;
+
+  std::ostringstream msg;
+  msg << "... box cell sizes =";
+  std::vector<FLOATTYPE> cellSizes = this->getGridBase().getCellSizes();
+  for (size_t i=0; i<cellSizes.size(); ++i) msg << " " << cellSizes[i];
+  msg << ", max |L dF/dL| = " << boxResidual;
+  this->pprt(msg.str());
+
+} // end update
+
+// Instantiate classes
+template class PsBoxRelaxUpdater<float, 1>;
+template class PsBoxRelaxUpdater<float, 2>;
+template class PsBoxRelaxUpdater<float, 3>;
+
+template class PsBoxRelaxUpdater<double, 1>;
+template class PsBoxRelaxUpdater<double, 2>;
+template class PsBoxRelaxUpdater<double, 3>;
@@ -0,0 +1,149 @@
+/**
+ *
+ * @file    PsBoxRelaxUpdater.h
+ *
+ * @brief   Class for relaxing the cell sizes of the simulation box
+ *
+ * @version $Id: PsBoxRelaxUpdater.h 8199 2007-09-05 05:07:11Z swsides $
+ *
+ * Copyright &copy; 2008-2020, Tech-X Corporation, Boulder, CO.
+ * All rights reserved.
+ */
+
+#ifndef PS_BOX_RELAX_UPDATER_H
+#define PS_BOX_RELAX_UPDATER_H
+
+// standard headers
+#include <string>
+#include <vector>
+
+// configure stuff
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#undef HAVE_CONFIG_H
+#endif
+
+// txbase headers
+#include <TxDebugExcept.h>
+
+// psbase includes
+#include <PsUpdater.h>
+#include <PsPolymer.h>
+#include <PsGridBase.h>
+
+/**
+ * A PsBoxRelaxUpdater object changes the cell sizes of the listed
+ * grids between iterations to lower the free-energy (variable-cell
+ * SCFT). The derivative of the free-energy per chain with respect to
+ * the box length in direction i at fixed fields (on the cell index)
+ * is only from the polymers
+ *
+ *   g_i = L_i dF/dL_i = - sum_p (volfrac_p/lengthRatio_p) L_i dlogQ_p/dL_i
+ *
+ * and each call scales the cell sizes by (1 - boxStep*g_i), with the
+ * strain in one step limited by maxStrain. The polymers then rebuild
+ * their k-space operators, and the effective Hamiltonian has the
+ * other updaters rebuild theirs (semi-implicit kernel, Poisson
+ * Laplacian). The spectral filter cells are on mode indices and do
+ * not change. All grids used by the polymer blocks and their FFT
+ * objects (usually mainGrid and fftGrid) must be listed.
+ *
+ * The updatefields are only used to place this updater in the
+ * effective Hamiltonian, they are not changed.
+ *
+ * @param FLOATTYPE numeric type of the data.
+ * @param NDIM dimensionality of the physical space
+ */
+
+template <class FLOATTYPE, size_t NDIM>
+class PsBoxRelaxUpdater : public PsUpdater<FLOATTYPE, NDIM> {
+
+  public:
+
+/**
+ * Constructor
+ *
+ */
+    PsBoxRelaxUpdater();
+
+/**
+ * Destructor
+ */
+    virtual ~PsBoxRelaxUpdater();
+
+/**
+ * Set the parameters
+ *
+ * @param tas the parameters
+ */
+    virtual void setAttrib(const TxHierAttribSetIntDbl& tas);
+
+/**
+ * Build the solvers structures
+ */
+    virtual void buildSolvers();
+
+/**
+ * Update the updater
+ *
+ * @param t the time
+ */
+    virtual void update(double t);
+
+/**
+ * Get free-energy value
+ *
+ * @return the free-energy
+ */
+    virtual FLOATTYPE getFreeE(bool calcDisorder=true) {
+      TxDebugExcept tde("PsBoxRelaxUpdater::getFreeE not implemented");
+      throw tde;
+    }
+
+/**
+ * Get largest |L_i dF/dL_i| from the last update so the box is
+ * included in the convergence test
+ */
+    virtual FLOATTYPE getResidual() {
+      return boxResidual;
+    }
+
+/**
+ * Check if the last update changed the cell sizes
+ */
+    virtual bool changedBox() {
+      return boxChanged;
+    }
+
+  private:
+
+    /** Names of grids whose cell sizes are changed */
+    std::vector<std::string> gridNames;
+
+    /** Pointers to grids whose cell sizes are changed */
+    std::vector< PsGridBase<FLOATTYPE, NDIM>* > grids;
+
+    /** Pointers to all polymers */
+    std::vector< PsPolymer<FLOATTYPE, NDIM>* > polymers;
+
+    /** Relative change of the box per unit L_i dF/dL_i */
+    FLOATTYPE boxStep;
+
+    /** Largest relative change of a cell size in one update */
+    FLOATTYPE maxStrain;
+
+    /** Largest |L_i dF/dL_i| from the last update */
+    FLOATTYPE boxResidual;
+
+    /** Flag for cell sizes changed in the last update */
+    bool boxChanged;
+
+    /** Constructor private to prevent use */
+    PsBoxRelaxUpdater(const PsBoxRelaxUpdater<FLOATTYPE, NDIM>& psb);
+
+   /** Assignment private to prevent use */
+    PsBoxRelaxUpdater<FLOATTYPE, NDIM>& operator=(
+       const PsBoxRelaxUpdater<FLOATTYPE, NDIM>& psb);
+};
+
+#endif  // PS_BOX_RELAX_UPDATER_H
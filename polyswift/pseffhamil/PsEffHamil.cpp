@@ -10,6 +10,9 @@
  * All rights reserved.
  */
 
+// std includes
+#include <algorithm>
+
 // pseffhamil includes
 #include <PsEffHamil.h>
 
@@ -200,6 +203,11 @@ void PsEffHamil<FLOATTYPE, NDIM>::update(double t) {
 
     this->dbprt("Performing updater ", updaterSequence[i]);
     updaterPtr->update(t);
+
+    // New box, k-space operators for the following updates
+    if (updaterPtr->changedBox()) {
+      for (size_t n=0; n<numUpdaters; ++n) updaters[n]->rebuildKSpace();
+    }
   }
 
 }
@@ -213,6 +221,25 @@ void PsEffHamil<FLOATTYPE, NDIM>::dump() {
   for (size_t i=0; i<numInteractions; ++i) interactions[i]->dump();
 }
 
+//
+// Largest residual over updaters
+//
+template <class FLOATTYPE, size_t NDIM>
+FLOATTYPE PsEffHamil<FLOATTYPE, NDIM>::getResidual() {
+
+  FLOATTYPE res = 0.0;
+  for (size_t i=0; i<numUpdaters; ++i)
+    res = std::max(res, updaters[i]->getResidual());
+  return res;
+}
+
+//
+template <class FLOATTYPE, size_t NDIM>
+void PsEffHamil<FLOATTYPE, NDIM>::resetHistory() {
+
+  for (size_t i=0; i<numUpdaters; ++i) updaters[i]->resetHistory();
+}
+
 // Instantiate
 template class PsEffHamil<float, 1>;
 template class PsEffHamil<float, 2>;
@@ -88,6 +88,16 @@ class PsEffHamil : public PsEffHamilBase<FLOATTYPE, NDIM> {
  */
     virtual void dump();
 
+/**
+ * Get largest residual of the updaters from the last update
+ */
+    virtual FLOATTYPE getResidual();
+
+/**
+ * Forget the iterates of the updaters
+ */
+    virtual void resetHistory();
+
   protected:
 
     //
@@ -10,6 +10,9 @@
  * All rights reserved.
  */
 
+// std includes
+#include <algorithm>
+
 // pseffhamil includes
 #include <PsEffHamilHldr.h>
 
@@ -113,6 +116,25 @@ void PsEffHamilHldr<FLOATTYPE, NDIM>::dump() {
   }
 }
 
+//
+// Largest residual over effhamils
+//
+template <class FLOATTYPE, size_t  NDIM>
+FLOATTYPE PsEffHamilHldr<FLOATTYPE, NDIM>::getResidual() {
+
+  FLOATTYPE res = 0.0;
+  for (size_t i=0; i<effhamils.size(); ++i)
+    res = std::max(res, effhamils[i]->getResidual());
+  return res;
+}
+
+template <class FLOATTYPE, size_t NDIM>
+void PsEffHamilHldr<FLOATTYPE, NDIM>::resetHistory() {
+
+  for (size_t i=0; i<effhamils.size(); ++i)
+    effhamils[i]->resetHistory();
+}
+
 // Instantiate base effhamil holder classes
 template class PsEffHamilHldr<float, 1>;
 template class PsEffHamilHldr<float, 2>;
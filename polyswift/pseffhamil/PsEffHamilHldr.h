@@ -93,6 +93,16 @@ class PsEffHamilHldr : public PsDynObj<FLOATTYPE, NDIM> {
  */
     virtual void dump();
 
+/**
+ * Get largest residual of all PsEffHamil-s from the last update
+ */
+    FLOATTYPE getResidual();
+
+/**
+ * Forget the iterates of the updaters of all PsEffHamil-s
+ */
+    void resetHistory();
+
   protected:
 
     /** Number of effhamils... ie length of the effhamils vector */
@@ -144,17 +144,7 @@ void PsFloryInteraction<FLOATTYPE, NDIM>::buildSolvers() {
   this->dbprt("PsFloryInteraction::buildSolvers() ");
 
   // Set average monomer density values
-  densAvg0 = 0.0;
-  densAvg1 = 0.0;
-  if (this->shiftDensFlag) {
-    densAvg0 = this->physFields[0]->getDensAverage();
-    densAvg1 = this->physFields[1]->getDensAverage();
-  }
-
-  this->dbprt("Density average = ", densAvg0);
-  this->dbprt(" for ", this->physFields[0]->getName());
-  this->dbprt("Density average = ", densAvg1);
-  this->dbprt(" for ", this->physFields[1]->getName());
+  setDensAverages();
 
   // Scale chi value by static polymer scaling length
   Nlen = (FLOATTYPE) PsPolymer<FLOATTYPE, NDIM>::getScaleLength();
@@ -326,6 +316,9 @@ void PsFloryInteraction<FLOATTYPE, NDIM>::update(double t) {
 
   this->dbprt("PsFloryInteraction::update(t = ", (int)t);
 
+  // Volume fractions can change between updates (parameter sweep)
+  setDensAverages();
+
   // Initialize and calculate correct parameters for updating the owned STFunc
   FLOATTYPE simTime = (FLOATTYPE)t;
   FLOATTYPE x[NDIM];
@@ -385,6 +378,55 @@ void PsFloryInteraction<FLOATTYPE, NDIM>::update(double t) {
 
 }
 
+//
+// Averages are set by the PhysFields from the volume fractions
+// in their update, which comes before the interaction updates
+//
+template <class FLOATTYPE, size_t NDIM>
+void PsFloryInteraction<FLOATTYPE, NDIM>::setDensAverages() {
+
+  densAvg0 = 0.0;
+  densAvg1 = 0.0;
+  if (this->shiftDensFlag) {
+    densAvg0 = this->physFields[0]->getDensAverage();
+    densAvg1 = this->physFields[1]->getDensAverage();
+  }
+
+  this->dbprt("Density average = ", densAvg0);
+  this->dbprt(" for ", this->physFields[0]->getName());
+  this->dbprt("Density average = ", densAvg1);
+  this->dbprt(" for ", this->physFields[1]->getName());
+}
+
+//
+// Only a constant chi can be swept, chiN field is reset at next update
+//
+template <class FLOATTYPE, size_t NDIM>
+void PsFloryInteraction<FLOATTYPE, NDIM>::setSweepParam(
+    const std::string& paramName, FLOATTYPE val) {
+
+  if (paramName != "chi" && paramName != "chiN") {
+    PsDynObj<FLOATTYPE, NDIM>::setSweepParam(paramName, val);
+  }
+  if (hasConstChiRamp || hasChiNrSTFunc) {
+    TxDebugExcept tde("PsFloryInteraction::setSweepParam: chi cannot be");
+    tde << " swept with an STFunc for chi";
+    tde << " in <PsInteraction " << this->getName() << " >";
+    throw tde;
+  }
+
+  if (paramName == "chiN") {
+    chiN = val;
+    chi = chiN/Nlen;
+  }
+  else {
+    chi = val;
+    chiN = chi*Nlen;
+  }
+  chiNFieldPtr->reset(chiN);
+  this->dbprt("PsFloryInteraction::setSweepParam chiN = ", chiN);
+}
+
 template <class FLOATTYPE, size_t NDIM>
 void PsFloryInteraction<FLOATTYPE, NDIM>::dump() {}
 
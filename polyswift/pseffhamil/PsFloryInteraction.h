@@ -114,6 +114,14 @@ class PsFloryInteraction : public virtual PsInteraction<FLOATTYPE, NDIM> {
  */
     virtual void update(double t);
 
+/**
+ * Set chi (or chiN) for a parameter sweep
+ *
+ * @param paramName name of the parameter (chi or chiN)
+ * @param val the new value
+ */
+    virtual void setSweepParam(const std::string& paramName, FLOATTYPE val);
+
 /**
  * Return interaction paramter if constant in space
  *
@@ -189,13 +197,15 @@ class PsFloryInteraction : public virtual PsInteraction<FLOATTYPE, NDIM> {
 
   private:
 
-    // SWS: Are these updated for varying vol frac calcs?
-    /** Average density */
+    /** Average density, set at each update */
     FLOATTYPE densAvg0;
 
-    /** Average density */
+    /** Average density, set at each update */
     FLOATTYPE densAvg1;
 
+    /** Set densAvg0/densAvg1 from the PhysFields */
+    void setDensAverages();
+
     /** Constructor private to prevent use */
     PsFloryInteraction(const PsFloryInteraction<FLOATTYPE, NDIM>& psb);
 
@@ -205,6 +205,10 @@ void PsFloryWallInteraction<FLOATTYPE, NDIM>::update(double t) {
 
   // Scoping call to base class
   PsFloryInteraction<FLOATTYPE, NDIM>::update(t);
+
+  // Volume fractions can change between updates (parameter sweep)
+  if (this->shiftDensFlag)
+    densAvg = densFieldPtr->getDensAverage();
 }
 
 //
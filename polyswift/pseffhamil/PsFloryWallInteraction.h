@@ -125,7 +125,7 @@ class PsFloryWallInteraction : public virtual PsFloryInteraction<FLOATTYPE, NDIM
 
   private:
 
-    /** Average of density field that couples to wall */
+    /** Average of density field that couples to wall, set at each update */
     FLOATTYPE densAvg;
 
     /** Constructor private to prevent use */
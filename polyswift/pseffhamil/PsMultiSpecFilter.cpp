@@ -90,9 +90,9 @@ void PsMultiSpecFilter<FLOATTYPE, NDIM>::buildData() {
   this->dbprt("total #-spectral filter cells = ", (int)totNumCells);
 
   // Create cutoff lists with length set by number
-  // of spectral cells needed
-  cutoffFactors.resize(totNumCells, 0.0);
-  cutoffFactorsTmp.resize(totNumCells, 0.0);
+  // of spectral cells needed, for all update fields
+  cutoffFactors.resize(this->numUpdateFields*totNumCells, 0.0);
+  cutoffFactorsTmp.resize(this->numUpdateFields*totNumCells, 0.0);
 }
 
 template <class FLOATTYPE, size_t NDIM>
@@ -122,6 +122,10 @@ void PsMultiSpecFilter<FLOATTYPE, NDIM>::buildSolvers() {
 
   // Build the kcellMap values
   build_specCells_transpose();
+
+  // Mask and spectra/results for filtering all update fields
+  specMask.assign(fftSizeMulti, 0.0);
+  fieldResults.assign(this->numUpdateFields*fftSizeMulti, 0.0);
 }
 
 //
@@ -148,23 +152,54 @@ void PsMultiSpecFilter<FLOATTYPE, NDIM>::update(double t) {
   if (!this->updateFlag)         return;
   if (this->cutoffFactor <= 0.0) return;
 
+  // Spectra of all update fields stay resident in the FFT object
+  // while the masks are set, ie. one transform each way
+  std::vector<const FLOATTYPE*> wPtrs;
+  std::vector<FLOATTYPE*> resPtrs;
+
   // Loop on update fields
   for (size_t n=0; n<this->numUpdateFields; ++n) {
 
-    // Access conjugate polymer field and filter
+    // Access conjugate polymer field
     PsFieldBase<FLOATTYPE>& wField = this->updateFields[n]->getConjgField();
 
     this->dbprt("... filtering ", this->updateFields[n]->getName());
-    this->dbprt("... with fft object: ", this->fftObjPtr->getName());
+    this->dbprt("... with fft object: ", fftTransObjPtr->getName());
 
     this->subtractAverage(wField);
-    applyFilter(wField);
+    wPtrs.push_back(wField.getConstDataPtr());
+    resPtrs.push_back(&fieldResults[n*fftSizeMulti]);
+  }
+  fftTransObjPtr->forwardSpectra(wPtrs);
+
+  // Absolute values of spectra (results space reused) and the
+  // cutoffs of all fields in one reduction
+  for (size_t n=0; n<this->numUpdateFields; ++n) {
+    fftTransObjPtr->getSpectrumAbs(n, resPtrs[n]);
+  }
+  setCutoffs(resPtrs);
+
+  // Mask each spectrum
+  for (size_t n=0; n<this->numUpdateFields; ++n) {
+    buildMask(n, resPtrs[n]);
+    fftTransObjPtr->scaleSpectrum(n, &specMask[0]);
+  }
+
+  fftTransObjPtr->backwardSpectra(resPtrs);
+
+  // This should be through PsField interface SWS: (refactor needed)
+  for (size_t n=0; n<this->numUpdateFields; ++n) {
+    FLOATTYPE* wdata = this->updateFields[n]->getConjgField().getDataPtr();
+    for (size_t l=0; l<fftSizeMulti; ++l) {
+      wdata[l] = this->scaleFFT*resPtrs[n][l];
+    }
   }
 
 } // end update
 
 //
-// helper method to calculate list of spectral filter cells
+// helper method to calculate list of spectral filter cells, the
+// map follows the spectrum order of the transpose FFT object
 //
 template <class FLOATTYPE, size_t NDIM>
 void PsMultiSpecFilter<FLOATTYPE, NDIM>::build_specCells_transpose() {
@@ -182,18 +217,26 @@ void PsMultiSpecFilter<FLOATTYPE, NDIM>::build_specCells_transpose() {
   std::vector<size_t> shifts = fftGridPtr->getDecomp().getLocalToGlobalShifts();
   size_t ny_trans      = kDims[1];
   size_t y_start_trans = shifts[1];
+  bool transposed = fftTransObjPtr->isTransposedOrder();
 
 // Auxillary variables
   size_t nn = 0;
   size_t iregion = 0;
-  size_t j;
+  size_t i, j;
+
+// Transposed order is local in y with all x, normal order is
+// local in x with all y
+  size_t niLoop = transposed ? globalSize[0] : kDims[0];
+  size_t iShift = transposed ? 0 : shifts[0];
+  size_t jShift = transposed ? y_start_trans : 0;
 
 // SWS: Is this pattern needed? Because array is kept "flat"
   for (size_t jloc = 0; jloc < ny_trans; ++jloc) {
-    for (size_t i = 0; i < globalSize[0]; ++i) {
+    for (size_t iloc = 0; iloc < niLoop; ++iloc) {
       for (size_t k = 0; k < globalSize[2]; ++k) {
 // shift for parallel data mapping
-        j = jloc + y_start_trans;
+        i = iloc + iShift;
+        j = jloc + jShift;
 
         icells[0] = floor( (FLOATTYPE)(i/specCellSizes[0]));
         icells[1] = floor( (FLOATTYPE)(j/specCellSizes[1]));
@@ -202,7 +245,10 @@ void PsMultiSpecFilter<FLOATTYPE, NDIM>::build_specCells_transpose() {
         iregion = ( icells[2]*(numSpecCells[0]*numSpecCells[1]) ) +
             (icells[1]* numSpecCells[0]) + icells[0];
 
-        nn = (( (jloc*globalSize[0]) + i)*globalSize[2]) + k;
+        if (transposed)
+          nn = (( (jloc*globalSize[0]) + iloc)*globalSize[2]) + k;
+        else
+          nn = (( (iloc*ny_trans) + jloc)*globalSize[2]) + k;
         kcellMap[nn] = iregion;
 
         this->dbprt("nn        = ", (int)nn);
@@ -220,50 +266,53 @@ void PsMultiSpecFilter<FLOATTYPE, NDIM>::build_specCells_transpose() {
 
 } // transpose k2 build
 
-// Helper method to filter... called from update
+//
+// Helper method to find maximum of each spectral cell for all
+// update fields... called from update
+//
 template <class FLOATTYPE, size_t NDIM>
-void PsMultiSpecFilter<FLOATTYPE, NDIM>::applyFilter(PsFieldBase<FLOATTYPE>& wf) {
+void PsMultiSpecFilter<FLOATTYPE, NDIM>::setCutoffs(
+    const std::vector<FLOATTYPE*>& specAbs) {
 
-  this->dbprt("PsMultiSpecFilter::applyFilter ");
+  this->dbprt("PsMultiSpecFilter::setCutoffs ");
 
   // Reset counters
-  for (size_t n=0; n<totNumCells; ++n) {
+  for (size_t n=0; n<cutoffFactorsTmp.size(); ++n) {
     cutoffFactors[n] = 0.0;
     cutoffFactorsTmp[n] = 0.0;
   }
 
-  // Return absolute value of forward transform
-  this->fftObjPtr->forwardFFTAbs(wf.getDataPtr(), this->resPtr);
-
   // Record maximum and apply cutoff for each region
-  for (size_t n=0; n<fftSizeMulti; ++n) {
-    size_t iregion = kcellMap[n];
-    FLOATTYPE kCut = this->cutoffFactor*this->resPtr[n];
-    if ( kCut > cutoffFactorsTmp[iregion] )
-      cutoffFactorsTmp[iregion] = kCut;
+  for (size_t f=0; f<specAbs.size(); ++f) {
+    size_t offset = f*totNumCells;
+    for (size_t n=0; n<fftSizeMulti; ++n) {
+      size_t iregion = offset + kcellMap[n];
+      FLOATTYPE kCut = this->cutoffFactor*specAbs[f][n];
+      if ( kCut > cutoffFactorsTmp[iregion] )
+        cutoffFactorsTmp[iregion] = kCut;
+    }
   }
 
   // Gather maximum cutoffs in each cell
   cutoffFactors = this->getCommBase().allReduceMax(cutoffFactorsTmp);
+}
+
+// Helper method to set filter mask... called from update
+template <class FLOATTYPE, size_t NDIM>
+void PsMultiSpecFilter<FLOATTYPE, NDIM>::buildMask(size_t f,
+    const FLOATTYPE* specAbs) {
+
+  this->dbprt("PsMultiSpecFilter::buildMask ");
 
   // Create mask array
+  size_t offset = f*totNumCells;
   for (size_t n=0; n<fftSizeMulti; ++n) {
 
-    size_t iregion = kcellMap[n];
-    if (this->resPtr[n] < cutoffFactors[iregion])
-      this->maskCutPtr[n] = this->filterStrength;
+    size_t iregion = offset + kcellMap[n];
+    if (specAbs[n] < cutoffFactors[iregion])
+      specMask[n] = this->filterStrength;
     else
-      this->maskCutPtr[n] = 1.0;
-  }
-
-  // SWS: this repeats transform work... must refactor
-  fftTransObjPtr->scaledFFTPair(wf.getDataPtr(),
-      this->maskCutPtr, this->resPtr);
-
-  // This should be through PsField interface SWS: (refactor needed)
-  FLOATTYPE* wdata = wf.getDataPtr();
-  for (size_t n=0; n<fftSizeMulti; ++n) {
-    wdata[n] = this->scaleFFT*this->resPtr[n];
+      specMask[n] = 1.0;
   }
 
 }
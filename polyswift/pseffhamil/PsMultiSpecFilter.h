@@ -92,8 +92,21 @@ class PsMultiSpecFilter : public virtual PsSpecFilterUpdater<FLOATTYPE, NDIM> {
     /** Sets up kcellMap */
     void build_specCells_transpose();
 
-    /** Helper for update to filter */
-    void applyFilter(PsFieldBase<FLOATTYPE>& wField);
+    /**
+     * Helper for update to set the cutoffs of every spectral cell
+     * for all update fields with one reduction
+     *
+     * @param specAbs absolute values of the update field spectra
+     */
+    void setCutoffs(const std::vector<FLOATTYPE*>& specAbs);
+
+    /**
+     * Helper for update to set specMask for one update field
+     *
+     * @param f       index of update field
+     * @param specAbs absolute value of its spectrum
+     */
+    void buildMask(size_t f, const FLOATTYPE* specAbs);
 
     // SWS: NDIM length?
     /** Number of cells that sub-divide k-space */
@@ -121,9 +134,16 @@ class PsMultiSpecFilter : public virtual PsSpecFilterUpdater<FLOATTYPE, NDIM> {
 
     /**
      * Temporary cutoffs for parallel calc
+     * (totNumCells values for each update field)
      */
     std::vector<FLOATTYPE> cutoffFactorsTmp;
 
+    /** Spectral mask in transpose k-space layout */
+    std::vector<FLOATTYPE> specMask;
+
+    /** Spectrum absolute values, then filtered results, of all fields */
+    std::vector<FLOATTYPE> fieldResults;
+
     /** Constructor private to prevent use */
     PsMultiSpecFilter(const PsMultiSpecFilter<FLOATTYPE, NDIM>& psb);
 
@@ -182,6 +182,16 @@ void PsPoissonUpdater<FLOATTYPE, NDIM>::build_k2() {
   scaleFFT = 1.0 / ((FLOATTYPE) this->getGridBase().getTotalCellsGlobal() );
 }
 
+//
+// Called after a box change, eg. by PsBoxRelaxUpdater
+//
+template <class FLOATTYPE, size_t NDIM>
+void PsPoissonUpdater<FLOATTYPE, NDIM>::rebuildKSpace() {
+
+  this->dbprt("PsPoissonUpdater::rebuildKSpace() ");
+  build_k2();
+}
+
 // Initialize
 template <class FLOATTYPE, size_t NDIM>
 void PsPoissonUpdater<FLOATTYPE, NDIM>::initialize() {
@@ -86,6 +86,11 @@ class PsPoissonUpdater : public virtual PsUpdater<FLOATTYPE, NDIM> {
  */
     virtual void update(double t);
 
+/**
+ * Rebuild the Laplacian list from the current cell sizes
+ */
+    virtual void rebuildKSpace();
+
     // SWS: history access
 /**
  * Get free-energy value
@@ -0,0 +1,221 @@
+/**
+ *
+ * @file    PsSemiImplicitUpdater.cpp
+ *
+ * @brief   Class for updating fields with a semi-implicit Seidel
+ *          algorithm preconditioned by the Debye function
+ *
+ * @version $Id: PsSemiImplicitUpdater.cpp 8257 2007-09-12 22:05:20Z swsides $
+ *
+ * Copyright &copy; 2008-2020, Tech-X Corporation, Boulder, CO.
+ * All rights reserved.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+// std includes
+#include <cmath>
+
+// psbase includes
+#include <PsGridField.h>
+
+// pseffhamil includes
+#include <PsSemiImplicitUpdater.h>
+
+// Constructor
+template <class FLOATTYPE, size_t NDIM>
+PsSemiImplicitUpdater<FLOATTYPE, NDIM>::PsSemiImplicitUpdater() {
+  fftObjPtr = NULL;
+  radiusGyration = 0.0;
+  responseScale = 1.0;
+  fftSize = 0;
+  kernel = NULL;
+  resPtr = NULL;
+}
+
+// Destructor
+template <class FLOATTYPE, size_t NDIM>
+PsSemiImplicitUpdater<FLOATTYPE, NDIM>::~PsSemiImplicitUpdater() {
+  delete[] kernel;
+  delete[] resPtr;
+}
+
+template <class FLOATTYPE, size_t NDIM>
+void PsSemiImplicitUpdater<FLOATTYPE, NDIM>::setAttrib(
+    const TxHierAttribSetIntDbl& tas) {
+
+  // Scoping call to base class
+  PsSteepDUpdater<FLOATTYPE, NDIM>::setAttrib(tas);
+
+  this->dbprt("PsSemiImplicitUpdater::setAttrib() ");
+
+  // Object name of FFT object
+  if (tas.hasString("fftKind")) {
+    fftKind = tas.getString("fftKind");
+  }
+  else {
+    TxDebugExcept tde("PsSemiImplicitUpdater::setAttrib: fftKind not set");
+    tde << " in <Updater " << this->getName() << " >";
+    throw tde;
+  }
+
+  // Chain size for Debye function
+  if (tas.hasParam("radiusGyration")) {
+    double tmp = tas.getParam("radiusGyration");
+    radiusGyration = (FLOATTYPE) tmp;
+  }
+  else {
+    TxDebugExcept tde("PsSemiImplicitUpdater::setAttrib: ");
+    tde << "radiusGyration not set in <Updater " << this->getName() << " >";
+    throw tde;
+  }
+
+  // Amplitude of linear response
+  if (tas.hasParam("responseScale")) {
+    double tmp = tas.getParam("responseScale");
+    responseScale = (FLOATTYPE) tmp;
+  }
+}
+
+template <class FLOATTYPE, size_t NDIM>
+void PsSemiImplicitUpdater<FLOATTYPE, NDIM>::buildSolvers() {
+
+  // Scoping call to base class
+  PsSteepDUpdater<FLOATTYPE, NDIM>::buildSolvers();
+  this->dbprt("PsSemiImplicitUpdater::buildSolvers() ");
+
+  // Get FFTW method pointer
+  fftObjPtr = PsNamedObject::getObject<PsFFTBase<FLOATTYPE, NDIM> >(fftKind);
+
+  // Real-space step must fit the FFT data struct
+  fftSize = fftObjPtr->getFFTSize();
+  if (fftSize != this->resField->getSize()) {
+    TxDebugExcept tde("PsSemiImplicitUpdater::buildSolvers: the FFT data");
+    tde << " struct size in <Updater " << this->getName() << " >";
+    tde << " is not equal to update field size";
+    tde << "\n fftSize   = " << fftSize;
+    tde << "\n fieldSize = " << this->resField->getSize();
+    throw tde;
+  }
+
+  kernel = new FLOATTYPE[fftObjPtr->getSpecSize()];
+  resPtr = new FLOATTYPE[fftSize];
+  build_kernel();
+}
+
+//
+// Same as PsSteepDUpdater::update with each step preconditioned
+//
+template <class FLOATTYPE, size_t NDIM>
+void PsSemiImplicitUpdater<FLOATTYPE, NDIM>::update(double t) {
+
+  // Scoping call to base class
+  PsPolymerUpdater<FLOATTYPE, NDIM>::update(t);
+  this->dbprt("PsSemiImplicitUpdater::update() ");
+
+  // If not updating this time step...exit
+  if (!this->updateFlag) return;
+
+  // Calc tot contrib to dHTotals for all updateFields
+  this->update_dHTotals();
+  this->calcResidual();
+
+  // Explicit step, then one transform pair per update field
+  PsFieldBase<FLOATTYPE>& xField = *(this->resField);
+  for (size_t n=0; n<this->numUpdateFields; ++n) {
+
+    PsFieldBase<FLOATTYPE>& wField = this->updateFields[n]->getConjgField();
+    FLOATTYPE* wdata = wField.getDataPtr();
+
+    this->calcFieldStep(n, xField);
+    fftObjPtr->scaledFFTPair(xField.getConstDataPtr(), kernel, resPtr);
+    for (size_t l=0; l<fftSize; ++l) wdata[l] += resPtr[l];
+  }
+
+  // Noise and pressure from new update fields
+  this->update_presFields();
+
+  // Update constraint physical field class specifics
+  this->constraintFieldPtr->updatePres();
+  this->calcFeField();
+
+} // end update
+
+//
+// Called after a box change, eg. by PsBoxRelaxUpdater
+//
+template <class FLOATTYPE, size_t NDIM>
+void PsSemiImplicitUpdater<FLOATTYPE, NDIM>::rebuildKSpace() {
+
+  this->dbprt("PsSemiImplicitUpdater::rebuildKSpace() ");
+  build_kernel();
+}
+
+//
+// g_D(x) = 2*( exp(-x) + x - 1 )/x^2, series for small x
+//
+template <class FLOATTYPE, size_t NDIM>
+FLOATTYPE PsSemiImplicitUpdater<FLOATTYPE, NDIM>::debyeFunc(FLOATTYPE x) {
+
+  if (x < 1.0e-3) return 1.0 - x/3.0 + x*x/12.0;
+  return 2.0*(std::exp(-x) + x - 1.0)/(x*x);
+}
+
+//
+// helper method to build the preconditioner, only depends on
+// relaxlambdas, Rg and system size. The kernel is in the spectrum
+// order of the FFT object used by scaledFFTPair (see PsFlexPseudoSpec)
+//
+template <class FLOATTYPE, size_t NDIM>
+void PsSemiImplicitUpdater<FLOATTYPE, NDIM>::build_kernel() {
+
+  // Local holder for k2 values formed from fft grid/decomp
+  PsGridBase<FLOATTYPE, NDIM>* fftGridPtr = &fftObjPtr->getGrid();
+  PsGridField<FLOATTYPE, NDIM> k2Field;
+  PsGridBaseItr* gItr = fftGridPtr;
+  k2Field.setGrid(gItr);
+  k2Field.calck2();
+
+  // Half-spectrum transforms only keep k < nz/2+1 in the last dimension
+  std::vector<size_t> kDims = fftGridPtr->getDecomp().getNumCellsLocal();
+  size_t nkLast = kDims[2];
+  if (fftObjPtr->hasHalfSpectrum()) nkLast = kDims[2]/2 + 1;
+
+  // FFT scaling folded into kernel
+  FLOATTYPE scaleFFT =
+      1.0 / ((FLOATTYPE) this->getGridBase().getTotalCellsGlobal() );
+  FLOATTYPE rg2 = radiusGyration*radiusGyration;
+  FLOATTYPE lam = this->relaxlambdas[0]*responseScale;
+
+  size_t n=0;
+  if (fftObjPtr->isTransposedOrder()) {
+    for (size_t j = 0; j< kDims[1]; ++j) {
+    for (size_t i = 0; i < kDims[0]; ++i) {
+    for (size_t k = 0; k < nkLast; ++k) {
+      FLOATTYPE gD = debyeFunc(k2Field(i, j, k, 0)*rg2);
+      kernel[n] = scaleFFT/(1.0 + lam*gD);
+      n++;
+    }}}
+  }
+  else {
+    for (size_t i = 0; i < kDims[0]; ++i) {
+    for (size_t j = 0; j< kDims[1]; ++j) {
+    for (size_t k = 0; k < nkLast; ++k) {
+      FLOATTYPE gD = debyeFunc(k2Field(i, j, k, 0)*rg2);
+      kernel[n] = scaleFFT/(1.0 + lam*gD);
+      n++;
+    }}}
+  }
+
+}
+
+// Instantiate classes
+template class PsSemiImplicitUpdater<float, 1>;
+template class PsSemiImplicitUpdater<float, 2>;
+template class PsSemiImplicitUpdater<float, 3>;
+
+template class PsSemiImplicitUpdater<double, 1>;
+template class PsSemiImplicitUpdater<double, 2>;
+template class PsSemiImplicitUpdater<double, 3>;
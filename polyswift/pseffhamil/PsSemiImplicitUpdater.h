@@ -0,0 +1,136 @@
+/**
+ *
+ * @file    PsSemiImplicitUpdater.h
+ *
+ * @brief   Class for updating fields with a semi-implicit Seidel
+ *          algorithm preconditioned by the Debye function
+ *
+ * @version $Id: PsSemiImplicitUpdater.h 8199 2007-09-05 05:07:11Z swsides $
+ *
+ * Copyright &copy; 2008-2020, Tech-X Corporation, Boulder, CO.
+ * All rights reserved.
+ */
+
+#ifndef PS_SEMI_IMPLICIT_UPDATER_H
+#define PS_SEMI_IMPLICIT_UPDATER_H
+
+// standard headers
+#include <string>
+
+// configure stuff
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#undef HAVE_CONFIG_H
+#endif
+
+// txbase headers
+#include <TxDebugExcept.h>
+
+// psbase includes
+#include <PsFFTBase.h>
+
+// pseffhamil includes
+#include <PsSteepDUpdater.h>
+
+/**
+ * A PsSemiImplicitUpdater object updates fields with the
+ * steepest-descent step treated semi-implicitly in Fourier space.
+ * The linear response of the update fields is approximated with the
+ * Debye function g_D(k^2 Rg^2), so each step is scaled by
+ *
+ *   1/( 1 + lambda0*responseScale*g_D(k^2 Rg^2) )
+ *
+ * which damps the stiff long-wavelength modes and allows much larger
+ * relaxlambdas. The kernel is built in buildSolvers on the layout
+ * of the FFT object, and again after a box change. The pressure is then set from the updated fields
+ * (Seidel ordering) as in PsSteepDUpdater.
+ *
+ * @param FLOATTYPE numeric type of the data.
+ * @param NDIM dimensionality of the physical space
+ */
+
+template <class FLOATTYPE, size_t NDIM>
+class PsSemiImplicitUpdater : public PsSteepDUpdater<FLOATTYPE, NDIM> {
+
+  public:
+
+/**
+ * Constructor
+ *
+ */
+    PsSemiImplicitUpdater();
+
+/**
+ * Destructor
+ */
+    virtual ~PsSemiImplicitUpdater();
+
+/**
+ * Set the parameters
+ *
+ * @param tas the parameters
+ */
+    virtual void setAttrib(const TxHierAttribSetIntDbl& tas);
+
+/**
+ * Build the solvers structures
+ */
+    virtual void buildSolvers();
+
+/**
+ * Update the updater
+ *
+ * @param t the time
+ */
+    virtual void update(double t);
+
+/**
+ * Rebuild the kernel from the current cell sizes
+ */
+    virtual void rebuildKSpace();
+
+  private:
+
+    /** FFT object name */
+    std::string fftKind;
+
+    /** Pointer to FFT interface object */
+    PsFFTBase<FLOATTYPE, NDIM>* fftObjPtr;
+
+    /** Radius of gyration in grid length units */
+    FLOATTYPE radiusGyration;
+
+    /** Amplitude of the Debye linear response */
+    FLOATTYPE responseScale;
+
+    /** Size of data transform */
+    size_t fftSize;
+
+    /** Preconditioner in k-space, includes the FFT scaling */
+    FLOATTYPE* kernel;
+
+    /** Preconditioned step in real space */
+    FLOATTYPE* resPtr;
+
+    /**
+     * Debye function
+     *
+     * @param x k^2 Rg^2
+     */
+    FLOATTYPE debyeFunc(FLOATTYPE x);
+
+    /**
+     * Helper method to build kernel in the k-space layout
+     * of the FFT object
+     */
+    void build_kernel();
+
+    /** Constructor private to prevent use */
+    PsSemiImplicitUpdater(const PsSemiImplicitUpdater<FLOATTYPE, NDIM>& psb);
+
+   /** Assignment private to prevent use */
+    PsSemiImplicitUpdater<FLOATTYPE, NDIM>& operator=(
+       const PsSemiImplicitUpdater<FLOATTYPE, NDIM>& psb);
+};
+
+#endif  // PS_SEMI_IMPLICIT_UPDATER_H
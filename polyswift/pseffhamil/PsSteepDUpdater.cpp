@@ -14,6 +14,10 @@
 #include <config.h>
 #endif
 
+// std includes
+#include <cmath>
+#include <algorithm>
+
 // pseffhamil includes
 #include <PsSteepDUpdater.h>
 
@@ -27,6 +31,20 @@ PsSteepDUpdater<FLOATTYPE, NDIM>::PsSteepDUpdater() {
   //  numInteractions = 0;
   noiseStrength = 0.0000;
   numCInteractions = 0;
+  residual = 0.0;
+  stepScale = 1.0;
+
+  adaptiveStep = false;
+  stepGrowth = 1.05;
+  stepShrink = 0.5;
+  minStepScale = 0.01;
+  maxStepScale = 10.0;
+  rollbackRatio = 1.5;
+  lastResidual = 0.0;
+  lastFreeE = 0.0;
+  lastDeltaFreeE = 0.0;
+  hasSavedFields = false;
+  chiInverse = false;
 }
 
 // Destructor
@@ -39,6 +57,12 @@ PsSteepDUpdater<FLOATTYPE, NDIM>::~PsSteepDUpdater() {
   }
   dHTotals.clear();
 
+  // Delete rollback fields
+  for (size_t i=0; i<savedFields.size(); ++i) {
+    delete savedFields[i];
+  }
+  savedFields.clear();
+
   relaxlambdas.clear();
   cInteractionNames.clear();
   constraintInteractions.clear();
@@ -73,6 +97,33 @@ void PsSteepDUpdater<FLOATTYPE, NDIM>::setAttrib(const TxHierAttribSetIntDbl& ta
     double tmp = tas.getParam("noise");
     noiseStrength = (FLOATTYPE) tmp;
   }
+
+  // Adaptive step size with rollback
+  if (tas.hasString("adaptiveStep")) {
+    std::string adaptStr = tas.getString("adaptiveStep");
+    if (adaptStr == "on") adaptiveStep = true;
+  }
+  if (tas.hasParam("stepGrowth")) {
+    stepGrowth = (FLOATTYPE) tas.getParam("stepGrowth");
+  }
+  if (tas.hasParam("stepShrink")) {
+    stepShrink = (FLOATTYPE) tas.getParam("stepShrink");
+  }
+  if (tas.hasParam("minStepScale")) {
+    minStepScale = (FLOATTYPE) tas.getParam("minStepScale");
+  }
+  if (tas.hasParam("maxStepScale")) {
+    maxStepScale = (FLOATTYPE) tas.getParam("maxStepScale");
+  }
+  if (tas.hasParam("rollbackRatio")) {
+    rollbackRatio = (FLOATTYPE) tas.getParam("rollbackRatio");
+  }
+
+  // Pressure from inverse chiN matrix (always for > 3 fields)
+  if (tas.hasString("chiInverse")) {
+    std::string chiInvStr = tas.getString("chiInverse");
+    if (chiInvStr == "on") chiInverse = true;
+  }
 }
 
 template <class FLOATTYPE, size_t NDIM>
@@ -82,12 +133,9 @@ void PsSteepDUpdater<FLOATTYPE, NDIM>::buildData() {
   PsPolymerUpdater<FLOATTYPE, NDIM>::buildData();
   this->dbprt("PsSteepDUpdater::buildData() ");
 
-  // Check for more than 3 fields
-  if (this->numUpdateFields > 3 ) {
-    TxDebugExcept tde("PsSteepDUpdater::buildData");
-    tde << "numUpdateFields > 3 not implemented yet";
-    throw tde;
-  }
+  // The pair chi pressure is the 2- and 3-component model, more
+  // fields use the inverse chiN matrix
+  if (this->numUpdateFields > 3) chiInverse = true;
 
   // Push back pointers to interaction objects
   for (size_t i=0; i<numCInteractions; ++i) {
@@ -108,6 +156,14 @@ void PsSteepDUpdater<FLOATTYPE, NDIM>::buildData() {
     throw tde;
   }
 
+  // Inverse chiN pressure has no wall terms
+  if ( (numCInteractions > 0) && chiInverse ) {
+    TxDebugExcept tde("PsSteepDUpdater::buildData");
+    tde << "chiInverse not implemented for interacting nanoparticles/walls";
+    tde << " in <Updater " << this->getName() << " >";
+    throw tde;
+  }
+
   //
   // Functional derivative fields built here to enforce the
   // ordering relationship between updateFields <--> dHTotals
@@ -136,6 +192,16 @@ void PsSteepDUpdater<FLOATTYPE, NDIM>::buildSolvers() {
   // Return pointers to a PsFieldBase object
   resField = TxMakerMap< PsFieldBase<FLOATTYPE> >::getNew(this->updateFieldType);
   resField->setGrid(gItr);
+
+  // Copies of update fields and pressure for rollback
+  if (adaptiveStep) {
+    for (size_t n=0; n<=this->numUpdateFields; ++n) {
+      PsFieldBase<FLOATTYPE>* sFieldPtr =
+        TxMakerMap< PsFieldBase<FLOATTYPE> >::getNew(this->updateFieldType);
+      sFieldPtr->setGrid(gItr);
+      savedFields.push_back(sFieldPtr);
+    }
+  }
 }
 
 //
@@ -165,32 +231,20 @@ void PsSteepDUpdater<FLOATTYPE, NDIM>::update(double t) {
   // If not updating this time step...exit
   if (!this->updateFlag) return;
 
-  // **************************************************************************
-  // Get reference to pressure field
-  PsFieldBase<FLOATTYPE>& presField = this->constraintFieldPtr->getConjgField();
-
-  // Loop over update fields and initialize with chemical
-  // potential fields and pressure [ie dHTotals_n = -w()_n + p() ]
-  for (size_t n=0; n<this->numUpdateFields; ++n) {
-
-    PsFieldBase<FLOATTYPE>& dH0 = *dHTotals[n];
-    PsFieldBase<FLOATTYPE>& wField = this->updateFields[n]->getConjgField();
-
-    dH0.reset(0.0);
-    dH0 += presField;
-    dH0 -= wField;
-    //    dH0 += (presField - wField);
-    //    dH0 -= wField;
-  }
-  // **************************************************************************
-
   // Calc tot contrib to dHTotals for all updateFields
   // Loops over over interactions for *each* update field
   update_dHTotals();
+  calcResidual();
+
+  // Free energy of the current fields and densities, computed once
+  // per step. Rolled back to last accepted fields, no step
+  if (adaptiveStep) {
+    this->calcFeField();
+    if (!adaptStep(this->getFreeE())) return;
+  }
 
-  // Replace new values in update fields
-  if (this->numUpdateFields == 2) update_set2Fields();
-  if (this->numUpdateFields == 3) update_set3Fields();
+  // Replace new values in update fields (a single field is left as is)
+  if (this->numUpdateFields >= 2) update_setFields();
 
   // Update constraint physical field class specifics
   // dynamic cast to specific interface
@@ -198,7 +252,7 @@ void PsSteepDUpdater<FLOATTYPE, NDIM>::update(double t) {
   this->constraintFieldPtr->updatePres();
 
   // SWS: here to match regression, need to sort order
-  this->calcFeField();
+  if (!adaptiveStep) this->calcFeField();
 
 } // end update
 
@@ -209,6 +263,25 @@ void PsSteepDUpdater<FLOATTYPE, NDIM>::update_dHTotals() {
 
   this->dbprt("PsSteepDUpdater::update_dHTotals() ");
 
+  // **************************************************************************
+  // Get reference to pressure field
+  PsFieldBase<FLOATTYPE>& presField = this->constraintFieldPtr->getConjgField();
+
+  // Loop over update fields and initialize with chemical
+  // potential fields and pressure [ie dHTotals_n = -w()_n + p() ]
+  for (size_t n=0; n<this->numUpdateFields; ++n) {
+
+    PsFieldBase<FLOATTYPE>& dH0 = *dHTotals[n];
+    PsFieldBase<FLOATTYPE>& wField = this->updateFields[n]->getConjgField();
+
+    dH0.reset(0.0);
+    dH0 += presField;
+    dH0 -= wField;
+    //    dH0 += (presField - wField);
+    //    dH0 -= wField;
+  }
+  // **************************************************************************
+
   std::string upFieldStr;
 
   // Loop on all updateFields
@@ -237,219 +310,384 @@ void PsSteepDUpdater<FLOATTYPE, NDIM>::update_dHTotals() {
 
 //
 // helper method for update()
-//   Update 2-component updateFields
-//   Add noise to all update fields and
-//   update pressure with sum of conjugate fields
+//   RMS of dHTotals over update fields and RMS of the
+//   incompressibility error sum_n phi_n + phi_wall - 1
+//
+template <class FLOATTYPE, size_t NDIM>
+void PsSteepDUpdater<FLOATTYPE, NDIM>::calcResidual() {
+
+  // Incompressibility error in workspace
+  PsFieldBase<FLOATTYPE>& errField = *(resField);
+  errField.reset(0.0);
+  errField += this->constraintFieldPtr->getDensField();
+  errField -= 1.0;
+  for (size_t n=0; n<this->numUpdateFields; ++n) {
+    errField += this->updateFields[n]->getDensField();
+  }
+
+  // Local sums of squares
+  size_t fieldSize = errField.getSize();
+  FLOATTYPE localSums[2] = {0.0, 0.0};
+  FLOATTYPE globalSums[2] = {0.0, 0.0};
+  for (size_t n=0; n<this->numUpdateFields; ++n) {
+    const FLOATTYPE* dH = dHTotals[n]->getConstDataPtr();
+    for (size_t l=0; l<fieldSize; ++l) localSums[0] += dH[l]*dH[l];
+  }
+  const FLOATTYPE* err = errField.getConstDataPtr();
+  for (size_t l=0; l<fieldSize; ++l) localSums[1] += err[l]*err[l];
+  this->getCommBase().allReduceSumVec(localSums, 2, globalSums);
+
+  // Normalize by number of cells
+  FLOATTYPE numCells = (FLOATTYPE) this->getGridBase().getTotalCellsGlobal();
+  FLOATTYPE dHNorm =
+      std::sqrt(globalSums[0]/(numCells*(FLOATTYPE)this->numUpdateFields));
+  FLOATTYPE incNorm = std::sqrt(globalSums[1]/numCells);
+  residual = std::max(dHNorm, incNorm);
+
+  this->dbprt("... dHTotals residual = ", dHNorm);
+  this->dbprt("... incompressibility residual = ", incNorm);
+}
+
 //
-// pres = 0.5*( w(1,:,:,:)+w(2,:,:,:)          + &
-//        ( phi0*(      chiN(1,2)           )) + &
-//        ( phi0_wall*( chiwN(1) + chiwN(2) )) + &
-//        ( phi0_ptcl*( chipN(1) + chipN(2) )) )
+// helper method for update()
+//   Update all updateFields in one pass over the cells with the
+//   same per-cell arithmetic as calcFieldStep
+//     dw_n = lambda0*( dH_n - lambda1*sum_{m!=n} dH_m )
 //
 template <class FLOATTYPE, size_t NDIM>
-void PsSteepDUpdater<FLOATTYPE, NDIM>::update_set2Fields() {
+void PsSteepDUpdater<FLOATTYPE, NDIM>::update_setFields() {
 
-  // Workspace
-  PsFieldBase<FLOATTYPE>& xField = *(resField);
+  size_t nf = this->numUpdateFields;
+  size_t fieldSize = resField->getSize();
 
-  // Explicitly list update/constraint fields
-  PsFieldBase<FLOATTYPE>& updateField0 = this->updateFields[0]->getConjgField();
-  PsFieldBase<FLOATTYPE>& updateField1 = this->updateFields[1]->getConjgField();
-  PsFieldBase<FLOATTYPE>& presField = this->constraintFieldPtr->getConjgField();
-  PsFieldBase<FLOATTYPE>& phi0Field = this->constraintFieldPtr->getDensField();
+  // Data pointers for dHTotals and update fields
+  std::vector<const FLOATTYPE*> dH(nf);
+  std::vector<FLOATTYPE*> w(nf);
+  for (size_t n=0; n<nf; ++n) {
+    dH[n] = dHTotals[n]->getConstDataPtr();
+    w[n] = this->updateFields[n]->getConjgField().getDataPtr();
+  }
 
-  PsFieldBase<FLOATTYPE>& dHTotal0 = *dHTotals[0];
-  PsFieldBase<FLOATTYPE>& dHTotal1 = *dHTotals[1];
+  FLOATTYPE mixLambda = -1.0*relaxlambdas[1];
+  FLOATTYPE relaxLambda = relaxlambdas[0]*stepScale;
 
-  // Hardwired updateField[0]
-  xField.reset(0.0);
-  xField += dHTotal1;
-  xField *= -1.0*relaxlambdas[1];
-  xField += dHTotal0;
-  xField *= relaxlambdas[0];
-  updateField0 += xField;
+  for (size_t l=0; l<fieldSize; ++l) {
+    for (size_t n=0; n<nf; ++n) {
+      FLOATTYPE x = 0.0;
+      for (size_t m=0; m<nf; ++m) {
+        if (m != n) x += dH[m][l];
+      }
+      x *= mixLambda;
+      x += dH[n][l];
+      x *= relaxLambda;
+      w[n][l] += x;
+    }
+  }
+
+  update_presFields();
+}
+
+//
+// Relaxation step for updateField[n] from the dHTotals
+//   dw_n = lambda0*( dH_n - lambda1*sum_{m!=n} dH_m )
+//
+template <class FLOATTYPE, size_t NDIM>
+void PsSteepDUpdater<FLOATTYPE, NDIM>::calcFieldStep(size_t n,
+    PsFieldBase<FLOATTYPE>& xField) {
 
-  // Hardwired updateField[1]
   xField.reset(0.0);
-  xField += dHTotal0;
+  for (size_t m=0; m<this->numUpdateFields; ++m) {
+    if (m != n) xField += *dHTotals[m];
+  }
   xField *= -1.0*relaxlambdas[1];
-  xField += dHTotal1;
-  xField *= relaxlambdas[0];
-  updateField1 += xField;
+  xField += *dHTotals[n];
+  xField *= relaxlambdas[0]*stepScale;
+}
+
+//
+// Residuals and free energies of another parameter point are not
+// comparable, the next adaptive step starts a new comparison
+//
+template <class FLOATTYPE, size_t NDIM>
+void PsSteepDUpdater<FLOATTYPE, NDIM>::resetHistory() {
+
+  this->dbprt("PsSteepDUpdater::resetHistory() ");
+  lastResidual = 0.0;
+  lastFreeE = 0.0;
+  lastDeltaFreeE = 0.0;
+  hasSavedFields = false;
+}
+
+//
+// helper method for update()
+//   Accept current fields (and save them) or roll back to the
+//   last accepted ones. freeE is the free energy of the current
+//   fields and the densities from them
+//
+template <class FLOATTYPE, size_t NDIM>
+bool PsSteepDUpdater<FLOATTYPE, NDIM>::adaptStep(FLOATTYPE freeE) {
+
+  PsFieldBase<FLOATTYPE>& presField = this->constraintFieldPtr->getConjgField();
+
+  // Overshoot: restore fields and retry with smaller step
+  if (hasSavedFields && (residual > rollbackRatio*lastResidual) ) {
+    for (size_t n=0; n<this->numUpdateFields; ++n) {
+      PsFieldBase<FLOATTYPE>& wField = this->updateFields[n]->getConjgField();
+      wField.reset(0.0);
+      wField += *savedFields[n];
+    }
+    presField.reset(0.0);
+    presField += *savedFields[this->numUpdateFields];
+    this->constraintFieldPtr->updatePres();
+
+    stepScale = std::max(stepScale*stepShrink, minStepScale);
+    this->pprt("... residual overshoot, rolling back with step scale = ",
+        stepScale);
+    return false;
+  }
+
+  // Grow step while residual falls and free energy settles
+  FLOATTYPE deltaFreeE = std::fabs(freeE - lastFreeE);
+  if (hasSavedFields && (residual < lastResidual) &&
+      (deltaFreeE <= lastDeltaFreeE) ) {
+    stepScale = std::min(stepScale*stepGrowth, maxStepScale);
+  }
+  this->dbprt("... adaptive step scale = ", stepScale);
+
+  // Accept and save current fields
+  for (size_t n=0; n<this->numUpdateFields; ++n) {
+    savedFields[n]->reset(0.0);
+    *savedFields[n] += this->updateFields[n]->getConjgField();
+  }
+  savedFields[this->numUpdateFields]->reset(0.0);
+  *savedFields[this->numUpdateFields] += presField;
+
+  lastDeltaFreeE = hasSavedFields ? deltaFreeE : std::fabs(freeE);
+  lastResidual = residual;
+  lastFreeE = freeE;
+  hasSavedFields = true;
+
+  return true;
+}
+
+//
+// helper method for update()
+//   Add noise to all update fields and
+//   update pressure with sum of conjugate fields.
+//   From incompressibility and w_n = sum_m chiN_nm phi_m + pres
+//   (up to constant shifts) for N = 2, 3 components
+//
+//  pres = (1/N)*( sum_n w_n
+//     + sum_{polymer chiN_ij} chiN_ij*( phi0 + sum_{k!=i,j} phi_k_shifted )
+//     - sum_{wall chiN_n} chiN_n*phi_wall )
+//
+// For N = 2 the shifted density sum is empty, for N = 3 it is the
+// single third component. These are the hand-written 2- and
+// 3-component formulas in one pass. With chiInverse (and for more
+// than 3 components) see update_presChiInverse.
+//
+template <class FLOATTYPE, size_t NDIM>
+void PsSteepDUpdater<FLOATTYPE, NDIM>::update_presFields() {
+
+  size_t nf = this->numUpdateFields;
+  size_t fieldSize = resField->getSize();
+
+  // Explicitly list constraint fields
+  PsFieldBase<FLOATTYPE>& presField = this->constraintFieldPtr->getConjgField();
+  PsFieldBase<FLOATTYPE>& phi0Field = this->constraintFieldPtr->getDensField();
 
-  //
-  // Hardwired pressure update for 2-components
-  //
   this->addRandUpdateConjgFields(noiseStrength);
-  this->setConjgFieldsToPres();
+  if (chiInverse) {
+    update_presChiInverse();
+    return;
+  }
 
-  // Contributions from 'mixed' terms from polymer interactions
-  //  p(r) = phi0*(chiN_12)
-  for (size_t i=0; i<this->numInteractions; ++i) {
+  // Data pointers for update fields (after noise)
+  std::vector<const FLOATTYPE*> w(nf);
+  std::vector<const FLOATTYPE*> phiShifted(nf, NULL);
+  for (size_t n=0; n<nf; ++n) {
+    w[n] = this->updateFields[n]->getConjgField().getConstDataPtr();
+    if (nf > 2) {
+      phiShifted[n] =
+        this->updateFields[n]->getShiftedDensField().getConstDataPtr();
+    }
+  }
 
-    std::string upFieldStr1 = this->updateFields[0]->getName();
-    std::string upFieldStr2 = this->updateFields[1]->getName();
-    bool hasField1 = this->interactions[i]->hasScField(upFieldStr1);
-    bool hasField2 = this->interactions[i]->hasScField(upFieldStr2);
-
-    // This logic limits terms to polymer chi's
-    if ( hasField1 && hasField2 ) {
-      PsFieldBase<FLOATTYPE>& chiN = this->interactions[i]->getParam();
-      xField.reset(0.0);
-      xField += phi0Field;
-      xField *= chiN;
-      presField += xField;
-      //      presField += phi0Field * chiN;
+  // Polymer chi's are the interactions with two of the update fields
+  std::vector<const FLOATTYPE*> chiPtrs;
+  std::vector< std::vector<size_t> > otherFields;
+  for (size_t i=0; i<this->numInteractions; ++i) {
+    std::vector<size_t> others;
+    for (size_t n=0; n<nf; ++n) {
+      std::string upFieldStr = this->updateFields[n]->getName();
+      if ( !this->interactions[i]->hasScField(upFieldStr) ) others.push_back(n);
     }
-  } // loop interactions
+    if (others.size() + 2 == nf) {
+      chiPtrs.push_back(this->interactions[i]->getParam().getConstDataPtr());
+      otherFields.push_back(others);
+    }
+  }
 
   // Constraint interaction pressure contribution
   // SWS: sign correction for constraint chi-s added 02/01/2013
-  //  p(r) = ( p0_wall*( chiwN(1) + chiwN(2) )) +
-  //         ( p0_ptcl*( chipN(1) + chipN(2) )) )
+  std::vector<const FLOATTYPE*> chiWallPtrs;
+  std::vector<const FLOATTYPE*> wallPtrs;
   for (size_t i=0; i<numCInteractions; ++i) {
-    for (size_t n=0; n<this->numUpdateFields; ++n) {
+    for (size_t n=0; n<nf; ++n) {
 
       std::string upFieldStr = this->updateFields[n]->getName();
       bool hasField = constraintInteractions[i]->hasScField(upFieldStr);
 
       // This logic picks out wall physical fields
-      if (hasField ) {
-        PsFieldBase<FLOATTYPE>& chiN = constraintInteractions[i]->getParam();
+      if (hasField) {
         PsPhysField<FLOATTYPE, NDIM>* physPtr =
             constraintInteractions[i]->getOtherPhysField(upFieldStr);
-        PsFieldBase<FLOATTYPE>& wallField = physPtr->getDensField();
-        xField.reset(0.0);
-        xField += wallField;
-        xField *= chiN;
-        presField -= xField;
+        chiWallPtrs.push_back(
+            constraintInteractions[i]->getParam().getConstDataPtr());
+        wallPtrs.push_back(physPtr->getDensField().getConstDataPtr());
       }
-
     }
   }
 
   // Scaling w/#of components
-  presField.scale(0.5);
+  FLOATTYPE invNumFields = 1.0/(double)nf;
+
+  FLOATTYPE* pres = presField.getDataPtr();
+  const FLOATTYPE* phi0 = phi0Field.getConstDataPtr();
+  for (size_t l=0; l<fieldSize; ++l) {
+
+    FLOATTYPE p = 0.0;
+    for (size_t n=0; n<nf; ++n) p += w[n][l];
+
+    for (size_t i=0; i<chiPtrs.size(); ++i) {
+      FLOATTYPE x = 0.0;
+      for (size_t k=0; k<otherFields[i].size(); ++k) {
+        x += phiShifted[otherFields[i][k]][l];
+      }
+      x += phi0[l];
+      x *= chiPtrs[i][l];
+      p += x;
+    }
+
+    for (size_t i=0; i<wallPtrs.size(); ++i) {
+      FLOATTYPE x = wallPtrs[i][l]*chiWallPtrs[i][l];
+      p -= x;
+    }
+
+    pres[l] = p*invNumFields;
+  }
 }
 
 //
-// helper method for update()
-//   Update 3-component updateFields
-//   Add noise to all update fields and
-//   update pressure with sum of conjugate fields
-//
-//  pres = (1./3.)*( w(1,:,:,:)+w(2,:,:,:)+w(3,:,:,:)      +      &
-//     chiN(1,2)*(phi_tot(3,:,:,:)-phi_avg(3))        +      &
-//     chiN(1,3)*(phi_tot(2,:,:,:)-phi_avg(2))        +      &
-//     chiN(2,3)*(phi_tot(1,:,:,:)-phi_avg(1))        +      &
-//     (     phi0*( chiN(1,2) + chiN(1,3) + chiN(2,3) ) ) +  &
-//     ( dn0*phi0_wall  *( chiw(1)   + chiw(2)   + chiw(3) ) ) + &
-//     ( dn0*phi0_multip*( chip(1)   + chip(2)   + chip(3) ) ) )
+// Solve a x = b in place (b holds x) by Gaussian elimination with
+// partial pivoting, false for a singular matrix
 //
-template <class FLOATTYPE, size_t NDIM>
-void PsSteepDUpdater<FLOATTYPE, NDIM>::update_set3Fields() {
-
-  PsFieldBase<FLOATTYPE>& xField = *(resField);
+static bool solveSmallSystem(size_t n, std::vector<double>& a,
+    std::vector<double>& b) {
 
-  // Explicitly list update/constraint fields
-  PsFieldBase<FLOATTYPE>& dHTotal0     = *dHTotals[0];
+  for (size_t c=0; c<n; ++c) {
 
-  //  Ps Field<FLOATTYPE, NDIM> dHTotalf(dHTotal0);
+    // Pivot row
+    size_t piv = c;
+    for (size_t r=c+1; r<n; ++r) {
+      if (std::fabs(a[r*n+c]) > std::fabs(a[piv*n+c])) piv = r;
+    }
+    if (std::fabs(a[piv*n+c]) < 1.0e-12) return false;
+    if (piv != c) {
+      for (size_t k=0; k<n; ++k) std::swap(a[c*n+k], a[piv*n+k]);
+      std::swap(b[c], b[piv]);
+    }
 
-  PsFieldBase<FLOATTYPE>& dHTotal1     = *dHTotals[1];
-  PsFieldBase<FLOATTYPE>& dHTotal2     = *dHTotals[2];
-  PsFieldBase<FLOATTYPE>& updateField0 = this->updateFields[0]->getConjgField();
-  PsFieldBase<FLOATTYPE>& updateField1 = this->updateFields[1]->getConjgField();
-  PsFieldBase<FLOATTYPE>& updateField2 = this->updateFields[2]->getConjgField();
+    // Eliminate below pivot
+    for (size_t r=c+1; r<n; ++r) {
+      double f = a[r*n+c]/a[c*n+c];
+      for (size_t k=c; k<n; ++k) a[r*n+k] -= f*a[c*n+k];
+      b[r] -= f*b[c];
+    }
+  }
 
-  PsFieldBase<FLOATTYPE>& presField = this->constraintFieldPtr->getConjgField();
-  PsFieldBase<FLOATTYPE>& phi0Field = this->constraintFieldPtr->getDensField();
+  // Back substitution
+  for (size_t c=n; c-- > 0; ) {
+    double x = b[c];
+    for (size_t k=c+1; k<n; ++k) x -= a[c*n+k]*b[k];
+    b[c] = x/a[c*n+c];
+  }
+  return true;
+}
 
-  // Hardwired updateField[0]
-  xField.reset(0.0);
-  xField += dHTotal1;
-  xField += dHTotal2;
-  xField *= -1.0*relaxlambdas[1];
-  xField += dHTotal0;
-  xField *= relaxlambdas[0];
-  updateField0 += xField;
+//
+// helper method for update_presFields()
+//   Pressure from the inverse chiN matrix for N components.
+//   With w - pres = chiN phi_shifted and the shifted densities
+//   summing to zero (incompressible, no walls), u = chiN^-1 1 gives
+//
+//  pres = ( sum_n u_n w_n ) / ( sum_n u_n )
+//
+// The N x N system is solved on each cell as chiN can vary in
+// space and time. For N = 2 this is the 2-component formula, for
+// N = 3 it has the same saddle point as the pair chi formula.
+//
+template <class FLOATTYPE, size_t NDIM>
+void PsSteepDUpdater<FLOATTYPE, NDIM>::update_presChiInverse() {
 
-  // Hardwired updateField[1]
-  xField.reset(0.0);
-  xField += dHTotal0;
-  xField += dHTotal2;
-  xField *= -1.0*relaxlambdas[1];
-  xField += dHTotal1;
-  xField *= relaxlambdas[0];
-  updateField1 += xField;
+  size_t nf = this->numUpdateFields;
+  size_t fieldSize = resField->getSize();
 
-  // Hardwired updateField[2]
-  xField.reset(0.0);
-  xField += dHTotal0;
-  xField += dHTotal1;
-  xField *= -1.0*relaxlambdas[1];
-  xField += dHTotal2;
-  xField *= relaxlambdas[0];
-  updateField2 += xField;
+  PsFieldBase<FLOATTYPE>& presField = this->constraintFieldPtr->getConjgField();
 
-  //
-  // Hardwired pressure update for 3-components
-  //
-  this->addRandUpdateConjgFields(noiseStrength);
-  this->setConjgFieldsToPres();
+  // Data pointers for update fields (after noise)
+  std::vector<const FLOATTYPE*> w(nf);
+  for (size_t n=0; n<nf; ++n) {
+    w[n] = this->updateFields[n]->getConjgField().getConstDataPtr();
+  }
 
-  // Contributions from 'mixed' terms from polymer interactions
-  //  p(r) = chiN_12*(phi3-phi3ave) + chiN_13*(phi2-phi2ave) + chiN_23*(phi1-phi1ave)
-  //  p(r) = phi0*( chiN_12 + chiN_13 + chiN_23 )
+  // Polymer chi's are the interactions with two of the update fields
+  std::vector<size_t> pairRow;
+  std::vector<size_t> pairCol;
+  std::vector<const FLOATTYPE*> chiPtrs;
   for (size_t i=0; i<this->numInteractions; ++i) {
-    for (size_t n=0; n<this->numUpdateFields; ++n) {
-
-      // This logic limits terms to polymer chi's
+    std::vector<size_t> pair;
+    for (size_t n=0; n<nf; ++n) {
       std::string upFieldStr = this->updateFields[n]->getName();
-      bool hasField = this->interactions[i]->hasScField(upFieldStr);
-      PsFieldBase<FLOATTYPE>& chiN = this->interactions[i]->getParam();
-
-      if ( !hasField ) {
-        PsFieldBase<FLOATTYPE>& densField =
-            this->updateFields[n]->getShiftedDensField();
-        xField.reset(0.0);
-        xField += densField;
-        xField += phi0Field;
-        xField *= chiN;
-        presField += xField;
-      }
+      if ( this->interactions[i]->hasScField(upFieldStr) ) pair.push_back(n);
+    }
+    if (pair.size() == 2) {
+      pairRow.push_back(pair[0]);
+      pairCol.push_back(pair[1]);
+      chiPtrs.push_back(this->interactions[i]->getParam().getConstDataPtr());
+    }
+  }
 
-    } // loop field check
-  } // loop interactions
+  // Per-cell workspace
+  std::vector<double> chiMat(nf*nf);
+  std::vector<double> u(nf);
 
-  // Constraint interaction pressure contribution
-  // SWS: sign correction added 02/01/2013
-  //  p(r) = ( p0_wall*( chiwN(1) + chiwN(2) + chiwN(3) )) +
-  //         ( p0_ptcl*( chipN(1) + chipN(2) + chiwN(3) )) )
-  for (size_t i=0; i<numCInteractions; ++i) {
-    for (size_t n=0; n<this->numUpdateFields; ++n) {
+  FLOATTYPE* pres = presField.getDataPtr();
+  for (size_t l=0; l<fieldSize; ++l) {
 
-      std::string upFieldStr = this->updateFields[n]->getName();
-      bool hasField = constraintInteractions[i]->hasScField(upFieldStr);
+    chiMat.assign(nf*nf, 0.0);
+    for (size_t i=0; i<chiPtrs.size(); ++i) {
+      chiMat[pairRow[i]*nf + pairCol[i]] += chiPtrs[i][l];
+      chiMat[pairCol[i]*nf + pairRow[i]] += chiPtrs[i][l];
+    }
+    u.assign(nf, 1.0);
 
-      // This logic picks out wall physical fields
-      if (hasField ) {
-        PsFieldBase<FLOATTYPE>& chiN =
-            constraintInteractions[i]->getParam();
-        PsPhysField<FLOATTYPE, NDIM>* physPtr =
-            constraintInteractions[i]->getOtherPhysField(upFieldStr);
-        PsFieldBase<FLOATTYPE>& wallField = physPtr->getDensField();
-        xField.reset(0.0);
-        xField += wallField;
-        xField *= chiN;
-        presField -= xField;
-      }
+    double uSum = 0.0;
+    bool solved = solveSmallSystem(nf, chiMat, u);
+    if (solved) {
+      for (size_t n=0; n<nf; ++n) uSum += u[n];
+    }
+    if (!solved || (std::fabs(uSum) < 1.0e-12) ) {
+      TxDebugExcept tde("PsSteepDUpdater::update_presChiInverse: ");
+      tde << "chiN matrix of the interactions is singular";
+      tde << " in <Updater " << this->getName() << " >";
+      throw tde;
     }
-  }
 
-  // Pressure scale factor for number of components
-  FLOATTYPE invNumFields = 1.0/3.0;
-  presField.scale(invNumFields);
+    double p = 0.0;
+    for (size_t n=0; n<nf; ++n) p += u[n]*w[n][l];
+    pres[l] = p/uSum;
+  }
 }
 
 // Instantiate classes
@@ -36,6 +36,12 @@
  * A PsSteepDUpdater object updates fields using steepest descent
  * algorithm
  *
+ * With adaptiveStep = on the relaxlambdas[0] step is scaled each
+ * update: grown by stepGrowth while the residual falls and the
+ * free-energy change settles, and shrunk by stepShrink with the
+ * conjugate fields rolled back to the last accepted ones when the
+ * residual grows by more than rollbackRatio.
+ *
  * @param FLOATTYPE numeric type of the data.
  * @param NDIM dimensionality of the physical space
  */
@@ -85,6 +91,18 @@ class PsSteepDUpdater : public virtual PsPolymerUpdater<FLOATTYPE, NDIM> {
  */
     virtual void update(double t);
 
+/**
+ * Get normalized residual from the last update
+ */
+    virtual FLOATTYPE getResidual() {
+      return residual;
+    }
+
+/**
+ * Forget the accepted fields of the adaptive step, stepScale is kept
+ */
+    virtual void resetHistory();
+
   protected:
 
     /** Strength of noise term in relaxation algorithm */
@@ -105,11 +123,15 @@ class PsSteepDUpdater : public virtual PsPolymerUpdater<FLOATTYPE, NDIM> {
     /** List of interaction constraint pointers */
     std::vector< PsInteraction<FLOATTYPE, NDIM>* > constraintInteractions;
 
-  private:
-
     /** Field result holder */
     PsFieldBase<FLOATTYPE>* resField;
 
+    /** Larger of the dHTotals and incompressibility RMS norms */
+    FLOATTYPE residual;
+
+    /** Current multiplier of relaxlambdas[0] */
+    FLOATTYPE stepScale;
+
     /**
      * Helper method for update
      * Calculate total dH values for each physical update field
@@ -118,15 +140,86 @@ class PsSteepDUpdater : public virtual PsPolymerUpdater<FLOATTYPE, NDIM> {
 
     /**
      * Helper method for update
-     * Uses dHTotals to calculate change in updateFields
+     * Set residual from dHTotals and the incompressibility error,
+     * both reduced over ranks in one call
      */
-    void update_set2Fields();
+    void calcResidual();
+
+    /**
+     * Relaxation step for one update field from dHTotals
+     *
+     * @param n      index of update field
+     * @param xField holder for change in updateFields[n]
+     */
+    void calcFieldStep(size_t n, PsFieldBase<FLOATTYPE>& xField);
 
     /**
      * Helper method for update
-     * Uses dHTotals to calculate change in updateFields
+     * Add noise and set pressure from the updateFields in one
+     * pass over the cells
+     */
+    void update_presFields();
+
+  private:
+
+    /** Flag for adaptive step size with rollback */
+    bool adaptiveStep;
+
+    /** Factor for growing stepScale */
+    FLOATTYPE stepGrowth;
+
+    /** Factor for shrinking stepScale on rollback */
+    FLOATTYPE stepShrink;
+
+    /** Smallest allowed stepScale */
+    FLOATTYPE minStepScale;
+
+    /** Largest allowed stepScale */
+    FLOATTYPE maxStepScale;
+
+    /** Residual growth ratio that triggers a rollback */
+    FLOATTYPE rollbackRatio;
+
+    /** Residual of last accepted fields */
+    FLOATTYPE lastResidual;
+
+    /** Free energy of last accepted fields */
+    FLOATTYPE lastFreeE;
+
+    /** Free-energy change at last accepted fields */
+    FLOATTYPE lastDeltaFreeE;
+
+    /** Flag for saved fields present */
+    bool hasSavedFields;
+
+    /** Flag for pressure from the inverse chiN matrix */
+    bool chiInverse;
+
+    /** Last accepted update fields followed by pressure field */
+    std::vector< PsFieldBase<FLOATTYPE>* > savedFields;
+
+    /**
+     * Helper method for update
+     * Adjust stepScale from residual and free energy
+     *
+     * @param freeE free energy of the current fields
+     * @return false if fields were rolled back and no step taken
+     */
+    bool adaptStep(FLOATTYPE freeE);
+
+    /**
+     * Helper method for update
+     * Uses dHTotals to calculate change in all updateFields
+     * in one pass over the cells
+     */
+    void update_setFields();
+
+    /**
+     * Helper method for update_presFields
+     * Set pressure from the inverse of the pair chiN matrix
+     * solved on each cell, for any number of updateFields
      */
-    void update_set3Fields();
+    void update_presChiInverse();
 
     /** Constructor private to prevent use */
     PsSteepDUpdater(const PsSteepDUpdater<FLOATTYPE, NDIM>& psb);
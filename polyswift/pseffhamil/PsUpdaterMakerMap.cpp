@@ -13,6 +13,9 @@
 // pseffhamil includes
 #include <PsUpdaterMakerMap.h>
 #include <PsSteepDUpdater.h>
+#include <PsAndersonUpdater.h>
+#include <PsSemiImplicitUpdater.h>
+#include <PsBoxRelaxUpdater.h>
 #include <PsPoissonUpdater.h>
 #include <PsSimpleSpecFilter.h>
 #include <PsMultiSpecFilter.h>
@@ -33,6 +36,12 @@ PsUpdaterMakerMap<FLOATTYPE, NDIM>::PsUpdaterMakerMap() {
   new TxMaker< PsSteepDUpdater<FLOATTYPE, NDIM>,
         PsUpdater<FLOATTYPE, NDIM> >("steepestDescent");
 
+  new TxMaker< PsAndersonUpdater<FLOATTYPE, NDIM>,
+        PsUpdater<FLOATTYPE, NDIM> >("andersonMixing");
+
+  new TxMaker< PsSemiImplicitUpdater<FLOATTYPE, NDIM>,
+        PsUpdater<FLOATTYPE, NDIM> >("semiImplicitSeidel");
+
   new TxMaker< PsSimpleSpecFilter<FLOATTYPE, NDIM>,
         PsUpdater<FLOATTYPE, NDIM> >("simpleSpecFilter");
 
@@ -41,6 +50,9 @@ PsUpdaterMakerMap<FLOATTYPE, NDIM>::PsUpdaterMakerMap() {
 
   new TxMaker< PsPoissonUpdater<FLOATTYPE, NDIM>,
         PsUpdater<FLOATTYPE, NDIM> >("poissonUpdater");
+
+  new TxMaker< PsBoxRelaxUpdater<FLOATTYPE, NDIM>,
+        PsUpdater<FLOATTYPE, NDIM> >("boxRelax");
 }
 
 template <class FLOATTYPE, size_t NDIM>
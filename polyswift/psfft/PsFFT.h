@@ -24,6 +24,12 @@
 // psbase includes
 #include <PsFFTBase.h>
 
+// MPI includes
+#ifdef HAVE_MPI
+#define MPICH_IGNORE_CXX_SEEK
+#include <mpi.h>
+#endif
+
 /**
  * Fourier transform interface class
  */
@@ -64,6 +70,20 @@ class PsFFT : public virtual PsFFTBase<FLOATTYPE, NDIM> {
 
   protected:
 
+#ifdef HAVE_MPI
+/**
+ * Communicator for the MPI plans. On a replicated grid (see
+ * PsDecompBase::isReplicated) each rank transforms the whole grid
+ * alone, otherwise the grid is distributed over all ranks
+ *
+ * @return MPI communicator
+ */
+    MPI_Comm getPlanComm() {
+      if (gridPtr->getDecomp().isReplicated()) return MPI_COMM_SELF;
+      return MPI_COMM_WORLD;
+    }
+#endif
+
     /** Global dimensions of grid */
     std::vector<size_t> globalDims;
 
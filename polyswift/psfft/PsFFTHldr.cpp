@@ -41,6 +41,20 @@ void PsFFTHldr<FLOATTYPE, NDIM>::buildData(PsNamedObject* inOwner) {
 
   this->dbprt("PsFFTHldr::buildData() ");
 
+  // Shared objects are only registered, ffts stays empty
+  if (srcHldr) {
+    if (srcHldr->fftNames != fftNames) {
+      TxDebugExcept tde("PsFFTHldr::buildData: shared FFT holder");
+      tde << " has different <FFT> blocks";
+      throw tde;
+    }
+    for (size_t i=0; i<fftNames.size(); ++i) {
+      this->pprt("Sharing <FFT> block:  ", fftNames[i]);
+      inOwner->makeAvail(srcHldr->ffts[i], fftNames[i]);
+    }
+    return;
+  }
+
   for (size_t i=0; i<fftNames.size(); ++i) {
 
     // For each FFT look for kind
@@ -41,6 +41,7 @@ class PsFFTHldr : public PsDynObj<FLOATTYPE, NDIM> {
  */
     PsFFTHldr() {
       this->setName("FFTHdlr");
+      srcHldr = NULL;
     }
 
 /**
@@ -80,6 +81,18 @@ class PsFFTHldr : public PsDynObj<FLOATTYPE, NDIM> {
  */
     virtual void buildData(PsNamedObject* inOwner);
 
+/**
+ * Use the FFT objects of another holder built from the same input
+ * (eg. of the first replica domain) instead of making new ones.
+ * buildData registers them under their names in the owner, they
+ * are not built or deleted by this holder.
+ *
+ * @param src holder that owns the FFT objects
+ */
+    void shareFFTs(PsFFTHldr<FLOATTYPE, NDIM>& src) {
+      srcHldr = &src;
+    }
+
   protected:
 
     /** Number of FFT objects */
@@ -90,6 +103,9 @@ class PsFFTHldr : public PsDynObj<FLOATTYPE, NDIM> {
 
   private:
 
+    /** Holder owning the shared FFT objects, NULL if not sharing */
+    PsFFTHldr<FLOATTYPE, NDIM>* srcHldr;
+
     /** List of fft names */
     std::vector< std::string > fftNames;
 
@@ -12,8 +12,14 @@
 
 // psfft includes
 #include <PsFFTMakerMap.h>
+#ifdef HAVE_FFTW3
+#include <PsFFTW3.h>
+#include <PsRealFFTW3.h>
+#else
 #include <PsNormalFFTW.h>
 #include <PsTransposeFFTW.h>
+#include <PsRealFFTW.h>
+#endif
 
 // txbase includes
 #include <TxMakerMap.h>
@@ -28,11 +34,35 @@ PsFFTMakerMap<FLOATTYPE, NDIM>::PsFFTMakerMap() {
   TxMakerMap<PsFFTBase<FLOATTYPE, NDIM>>::getInstance();
 
 // Add the makers (they are deleted by the makermap)
+#ifdef HAVE_FFTW3
+
+// FFTW2 is not linked in FFTW3 builds, the FFTW2 kinds are FFTW3
+// objects taking their k-space order from the grid decomp, realfftw
+// keeps the half-spectrum (r2c/c2r) transforms
+  new TxMaker< PsFFTW3<FLOATTYPE, NDIM>,
+        PsFFTBase<FLOATTYPE, NDIM> >("fftw3");
+
+  new TxMaker< PsFFTW3<FLOATTYPE, NDIM>,
+        PsFFTBase<FLOATTYPE, NDIM> >("normalfftw");
+
+  new TxMaker< PsFFTW3<FLOATTYPE, NDIM>,
+        PsFFTBase<FLOATTYPE, NDIM> >("transposefftw");
+
+  new TxMaker< PsRealFFTW3<FLOATTYPE, NDIM>,
+        PsFFTBase<FLOATTYPE, NDIM> >("realfftw");
+
+#else
+
   new TxMaker< PsNormalFFTW<FLOATTYPE, NDIM>,
         PsFFTBase<FLOATTYPE, NDIM> >("normalfftw");
 
   new TxMaker< PsTransposeFFTW<FLOATTYPE, NDIM>,
         PsFFTBase<FLOATTYPE, NDIM> >("transposefftw");
+
+  new TxMaker< PsRealFFTW<FLOATTYPE, NDIM>,
+        PsFFTBase<FLOATTYPE, NDIM> >("realfftw");
+
+#endif
 }
 
 template <class FLOATTYPE, size_t NDIM>
@@ -10,9 +10,28 @@
  * All rights reserved.
  */
 
+// std includes
+#include <cstring>
+#include <algorithm>
+
 // psfft includes
 #include <PsFFTW.h>
 
+#ifdef HAVE_FFTW_THREADS
+#include <fftw_threads.h>
+
+//
+// Library level setup is done once for all threaded FFTW objects
+//
+static bool fftwThreadsInitialized = false;
+
+static void initFFTWThreads() {
+  if (fftwThreadsInitialized) return;
+  fftw_threads_init();
+  fftwThreadsInitialized = true;
+}
+#endif
+
 template <class FLOATTYPE, size_t NDIM>
 PsFFTW<FLOATTYPE, NDIM>::PsFFTW() {
 
@@ -23,10 +42,24 @@ PsFFTW<FLOATTYPE, NDIM>::PsFFTW() {
   // Number of data sets to transform
   n_fields = 1;
 
+  // Threads per serial transform
+  numThreads = 1;
+
   // Set pointers
   in = NULL;
   out = NULL;
   work = NULL;
+
+  // Batch data allocated on first use
+  batchIn = NULL;
+  batchSpec = NULL;
+  batchWork = NULL;
+  batchFields = 0;
+
+  // No resident spectra
+  specData = NULL;
+  specFields = 0;
+  numSpectra = 0;
 }
 
 template <class FLOATTYPE, size_t NDIM>
@@ -35,6 +68,15 @@ PsFFTW<FLOATTYPE, NDIM>::~PsFFTW() {
   delete[] in;
   delete[] out;
   delete[] work;
+  delete[] batchIn;
+  delete[] batchSpec;
+  delete[] batchWork;
+  for (size_t k=0; k<kernelSpecs.size(); ++k) delete[] kernelSpecs[k];
+  delete[] specData;
+  for (size_t w=0; w<wsIn.size(); ++w) {
+    delete[] wsIn[w];
+    delete[] wsOut[w];
+  }
 
   fftwnd_destroy_plan(forwardPlan);
   fftwnd_destroy_plan(backwardPlan);
@@ -47,6 +89,25 @@ void PsFFTW<FLOATTYPE, NDIM>::setAttrib(const TxHierAttribSetIntDbl& tas) {
   PsFFT<FLOATTYPE, NDIM>::setAttrib(tas);
 
   this->dbprt("PsFFTW::setAttrib() ");
+
+  // Threads per transform, fftwnd_mpi is not threaded
+  if (tas.hasParam("numThreads")) {
+    numThreads = (int)tas.getParam("numThreads");
+    if (numThreads < 1) numThreads = 1;
+#if defined(HAVE_MPI) || !defined(HAVE_FFTW_THREADS)
+    if (numThreads > 1) {
+      TxDebugExcept tde("PsFFTW::setAttrib: numThreads > 1 ");
+#ifdef HAVE_MPI
+      tde << "not supported by FFTW2 MPI transforms, threads with MPI";
+      tde << " need a build with ENABLE_FFTW3";
+#else
+      tde << "but FFTW threads library not found";
+#endif
+      tde << " in <FFT " << this->getName() << " >";
+      throw tde;
+    }
+#endif
+  }
 }
 
 template <class FLOATTYPE, size_t NDIM>
@@ -67,6 +128,10 @@ void PsFFTW<FLOATTYPE, NDIM>::buildData() {
   int* planDims = new int[rank];
   for (int n=0; n<rank; ++n) planDims[n] = dims[n];
 
+#ifdef HAVE_FFTW_THREADS
+  if (numThreads > 1) initFFTWThreads();
+#endif
+
   // This sets plans and sizes
   forwardPlan  = fftwnd_create_plan(rank,planDims, FFTW_FORWARD,
       FFTW_ESTIMATE);
@@ -131,7 +196,7 @@ void PsFFTW<FLOATTYPE, NDIM>::forwardFFTAbs(
   }
 
   // FFT returned through the "out" arrary
-  fftwnd_one(forwardPlan, in, out);
+  executeOne(forwardPlan, in, out);
 
   // Calculate absolute value
   for (int n=0; n<total_local_size; ++n) {
@@ -152,39 +217,36 @@ void PsFFTW<FLOATTYPE, NDIM>::convolveRe(
 
   this->dbprt("PsFFTW::convolveRe serial");
 
-  // Local space... must be managed by this method
-  fftw_complex* in2  = new fftw_complex[total_local_size];
-  fftw_complex* out2 = new fftw_complex[total_local_size];
+  // Transform of data2 is kept in the "work" array
+  for (int n=0; n<total_local_size; ++n) {
+    in[n].re = data2[n];
+    in[n].im = 0.0;
+  }
+  executeOne(forwardPlan, in, work);
 
   // Format data for fft_complex data type
   for (int n=0; n<total_local_size; ++n) {
     in[n].re = data1[n];
     in[n].im = 0.0;
-    in2[n].re = data2[n];
-    in2[n].im = 0.0;
   }
 
   // FFT returned through the "out" arrary
-  fftwnd_one(forwardPlan, in, out);
-  fftwnd_one(forwardPlan, in2, out2);
+  executeOne(forwardPlan, in, out);
 
   // Scale transform result by kdata
   // (both Re/Im)
   for (int n=0; n<total_local_size; ++n) {
-    in[n].re = (out[n].re * out2[n].re) - (out[n].im * out2[n].im);
-    in[n].im = (out[n].im * out2[n].re) + (out[n].re * out2[n].im);
+    in[n].re = (out[n].re * work[n].re) - (out[n].im * work[n].im);
+    in[n].im = (out[n].im * work[n].re) + (out[n].re * work[n].im);
   }
 
   // FFT returned through the "out" arrary
-  fftwnd_one(backwardPlan, in, out);
+  executeOne(backwardPlan, in, out);
 
   // Format data for output
   for (int n=0; n<total_local_size; ++n) {
     resPtr[n] = out[n].re;
   }
-
-  delete[] in2;
-  delete[] out2;
 }
 
 //
@@ -197,28 +259,132 @@ void PsFFTW<FLOATTYPE, NDIM>::scaledFFTPair(
    const FLOATTYPE* data, const FLOATTYPE* kdata, FLOATTYPE* resPtr){
 
   this->dbprt("PsFFTW::scaledFFTPair serial");
+  scaledPair(data, NULL, kdata, resPtr, NULL, in, out);
+}
+
+//
+// Two real data sets packed as Re/Im of one complex transform.
+// kdata is real and even so F^-1[k*F[a+ib]] = (k*a) + i(k*b)
+//
+template <class FLOATTYPE, size_t NDIM>
+void PsFFTW<FLOATTYPE, NDIM>::scaledFFTPairTwo(
+   const FLOATTYPE* data1, const FLOATTYPE* data2,
+   const FLOATTYPE* kdata, FLOATTYPE* resPtr1, FLOATTYPE* resPtr2){
+
+  this->dbprt("PsFFTW::scaledFFTPairTwo serial");
+  scaledPair(data1, data2, kdata, resPtr1, resPtr2, in, out);
+}
+
+//
+// Workspaces are in/out pairs for fftwnd_one on the shared plans,
+// executing a plan is reentrant for distinct data
+//
+template <class FLOATTYPE, size_t NDIM>
+size_t PsFFTW<FLOATTYPE, NDIM>::addWorkspace() {
+
+  if (!hasWorkspaces()) return 0;
+
+  wsIn.push_back(new fftw_complex[total_local_size]);
+  wsOut.push_back(new fftw_complex[total_local_size]);
+  return wsIn.size();
+}
+
+//
+// Workspace 0 is the in/out pair of this object (MPI transforms
+// of derived classes)
+//
+template <class FLOATTYPE, size_t NDIM>
+void PsFFTW<FLOATTYPE, NDIM>::scaledFFTPairWs(size_t ws,
+   const FLOATTYPE* data, const FLOATTYPE* kdata, FLOATTYPE* resPtr){
+
+  if (ws == 0 || ws > wsIn.size()) {
+    scaledFFTPair(data, kdata, resPtr);
+    return;
+  }
+  scaledPair(data, NULL, kdata, resPtr, NULL, wsIn[ws-1], wsOut[ws-1]);
+}
+
+template <class FLOATTYPE, size_t NDIM>
+void PsFFTW<FLOATTYPE, NDIM>::scaledFFTPairTwoWs(size_t ws,
+   const FLOATTYPE* data1, const FLOATTYPE* data2,
+   const FLOATTYPE* kdata, FLOATTYPE* resPtr1, FLOATTYPE* resPtr2){
+
+  if (ws == 0 || ws > wsIn.size()) {
+    scaledFFTPairTwo(data1, data2, kdata, resPtr1, resPtr2);
+    return;
+  }
+  scaledPair(data1, data2, kdata, resPtr1, resPtr2,
+      wsIn[ws-1], wsOut[ws-1]);
+}
+
+//
+// Polarization on the in/out pair of a workspace, as the
+// PsFFTBase default without the temporary copies
+//
+template <class FLOATTYPE, size_t NDIM>
+void PsFFTW<FLOATTYPE, NDIM>::crossSpectrumReWs(size_t ws,
+   const FLOATTYPE* data1, const FLOATTYPE* data2, FLOATTYPE* resPtr){
+
+  if (ws == 0 || ws > wsIn.size()) {
+    this->crossSpectrumRe(data1, data2, resPtr);
+    return;
+  }
+  fftw_complex* src = wsIn[ws-1];
+  fftw_complex* dst = wsOut[ws-1];
+
+  for (int n=0; n<total_local_size; ++n) {
+    src[n].re = data1[n] + data2[n];
+    src[n].im = 0.0;
+  }
+  executeOne(forwardPlan, src, dst);
+  for (int n=0; n<total_local_size; ++n)
+    resPtr[n] = 0.25*((dst[n].re * dst[n].re) + (dst[n].im * dst[n].im));
+
+  for (int n=0; n<total_local_size; ++n) {
+    src[n].re = data1[n] - data2[n];
+    src[n].im = 0.0;
+  }
+  executeOne(forwardPlan, src, dst);
+  for (int n=0; n<total_local_size; ++n)
+    resPtr[n] -= 0.25*((dst[n].re * dst[n].re) + (dst[n].im * dst[n].im));
+}
+
+//
+// Serial FFT pair through the src/dst arrays. data2 (if not NULL)
+// is packed as the Im part and returned through resPtr2
+//
+template <class FLOATTYPE, size_t NDIM>
+void PsFFTW<FLOATTYPE, NDIM>::scaledPair(
+   const FLOATTYPE* data1, const FLOATTYPE* data2,
+   const FLOATTYPE* kdata, FLOATTYPE* resPtr1, FLOATTYPE* resPtr2,
+   fftw_complex* src, fftw_complex* dst){
 
   // Format data for fft_complex data type
   for (int n=0; n<total_local_size; ++n) {
-    in[n].re = data[n];
-    in[n].im = 0.0;
+    src[n].re = data1[n];
+    src[n].im = data2 ? data2[n] : 0.0;
   }
 
-  // FFT returned through the "out" arrary
-  fftwnd_one(forwardPlan, in, out);
+  // FFT returned through the "dst" arrary
+  executeOne(forwardPlan, src, dst);
 
   // Scale transform result by kdata (both Re/Im)
   for (int n=0; n<total_local_size; ++n) {
-    in[n].re = out[n].re * kdata[n];
-    in[n].im = out[n].im * kdata[n];
+    src[n].re = dst[n].re * kdata[n];
+    src[n].im = dst[n].im * kdata[n];
   }
 
-  // FFT returned through the "out" arrary
-  fftwnd_one(backwardPlan, in, out);
+  // FFT returned through the "dst" arrary
+  executeOne(backwardPlan, src, dst);
 
   // Format data for output
   for (int n=0; n<total_local_size; ++n) {
-    resPtr[n] = out[n].re;
+    resPtr1[n] = dst[n].re;
+  }
+  if (resPtr2) {
+    for (int n=0; n<total_local_size; ++n) {
+      resPtr2[n] = dst[n].im;
+    }
   }
 
 }
@@ -236,7 +402,7 @@ void PsFFTW<FLOATTYPE, NDIM>::scaledFFTPairIm(
   }
 
   // FFT returned through the "out" arrary
-  fftwnd_one(forwardPlan, in, out);
+  executeOne(forwardPlan, in, out);
 
   // Scale transform result by kdata (both Re/Im)
   for (int n=0; n<total_local_size; ++n) {
@@ -245,7 +411,7 @@ void PsFFTW<FLOATTYPE, NDIM>::scaledFFTPairIm(
   }
 
   // FFT returned through the "out" arrary
-  fftwnd_one(backwardPlan, in, out);
+  executeOne(backwardPlan, in, out);
 
   // Format data for output
   for (int n=0; n<total_local_size; ++n) {
@@ -268,7 +434,7 @@ void PsFFTW<FLOATTYPE, NDIM>::calcForwardFFT(const FLOATTYPE* data, FLOATTYPE* r
   }
 
   // FFT returned through the "out" arrary
-  fftwnd_one(forwardPlan, in, out);
+  executeOne(forwardPlan, in, out);
 
   // Format data for float type
   for (int n=0; n<total_local_size; ++n) {
@@ -289,7 +455,7 @@ void PsFFTW<FLOATTYPE, NDIM>::calcBackwardFFT(const FLOATTYPE* data, FLOATTYPE*
   }
 
   // FFT returned through the "out" arrary
-  fftwnd_one(backwardPlan, in, out);
+  executeOne(backwardPlan, in, out);
 
   // Format data for float type
   for (int n=0; n<total_local_size; ++n)
@@ -297,6 +463,414 @@ void PsFFTW<FLOATTYPE, NDIM>::calcBackwardFFT(const FLOATTYPE* data, FLOATTYPE*
 
 }
 
+/*
+ * *************************
+ * Batch (many-field) calls
+ * *************************
+ */
+
+template <class FLOATTYPE, size_t NDIM>
+void PsFFTW<FLOATTYPE, NDIM>::scaledFFTPairMany(
+    const std::vector<const FLOATTYPE*>& data,
+    const std::vector<const FLOATTYPE*>& kdata,
+    const std::vector<FLOATTYPE*>& resPtrs) {
+
+  this->dbprt("PsFFTW::scaledFFTPairMany");
+
+  int nf = (int)resPtrs.size();
+  this->checkManySize("PsFFTW::scaledFFTPairMany", data.size(), nf);
+  this->checkManySize("PsFFTW::scaledFFTPairMany", kdata.size(), nf);
+  if (nf == 0) return;
+
+  forwardMany(data, nf, false);
+  backwardMany(kdata, resPtrs);
+}
+
+template <class FLOATTYPE, size_t NDIM>
+void PsFFTW<FLOATTYPE, NDIM>::scaledFFTPairImMany(
+    const std::vector<const FLOATTYPE*>& data,
+    const std::vector<const FLOATTYPE*>& kdata,
+    const std::vector<FLOATTYPE*>& resPtrs) {
+
+  this->dbprt("PsFFTW::scaledFFTPairImMany");
+
+  int nf = (int)resPtrs.size();
+  this->checkManySize("PsFFTW::scaledFFTPairImMany", data.size(), nf);
+  this->checkManySize("PsFFTW::scaledFFTPairImMany", kdata.size(), nf);
+  if (nf == 0) return;
+
+  forwardMany(data, nf, true);
+  backwardMany(kdata, resPtrs);
+}
+
+template <class FLOATTYPE, size_t NDIM>
+void PsFFTW<FLOATTYPE, NDIM>::convolveReMany(
+    const std::vector<const FLOATTYPE*>& data1,
+    const std::vector<const FLOATTYPE*>& data2,
+    const std::vector<FLOATTYPE*>& resPtrs) {
+
+  this->dbprt("PsFFTW::convolveReMany");
+
+  int nf = (int)resPtrs.size();
+  this->checkManySize("PsFFTW::convolveReMany", data1.size(), nf);
+  this->checkManySize("PsFFTW::convolveReMany", data2.size(), nf);
+  if (nf == 0) return;
+
+  // Keep transforms of data2 while data1 is transformed
+  forwardMany(data2, nf, false);
+  std::swap(batchIn, batchSpec);
+  forwardMany(data1, nf, false);
+
+  // Multiply transforms
+  fftw_complex tmp;
+  int nsize = total_local_size*nf;
+  for (int n=0; n<nsize; ++n) {
+    tmp.re = (batchIn[n].re * batchSpec[n].re) -
+        (batchIn[n].im * batchSpec[n].im);
+    tmp.im = (batchIn[n].im * batchSpec[n].re) +
+        (batchIn[n].re * batchSpec[n].im);
+    batchIn[n].re = tmp.re;
+    batchIn[n].im = tmp.im;
+  }
+
+  transformMany(BACKWARD, nf, batchIn);
+
+  // Format data for output
+  for (int f=0; f<nf; ++f) {
+    FLOATTYPE* resPtr = resPtrs[f];
+    for (int n=0; n<total_local_size; ++n)
+      resPtr[n] = batchIn[n*nf + f].re;
+  }
+}
+
+template <class FLOATTYPE, size_t NDIM>
+void PsFFTW<FLOATTYPE, NDIM>::calcForwardFFTMany(
+    const std::vector<const FLOATTYPE*>& data,
+    const std::vector<FLOATTYPE*>& resPtrs) {
+
+  this->dbprt("PsFFTW::calcForwardFFTMany");
+
+  int nf = (int)resPtrs.size();
+  this->checkManySize("PsFFTW::calcForwardFFTMany", data.size(), nf);
+  if (nf == 0) return;
+
+  forwardMany(data, nf, false);
+
+  // Format data for float type
+  for (int f=0; f<nf; ++f) {
+    FLOATTYPE* resPtr = resPtrs[f];
+    for (int n=0; n<total_local_size; ++n)
+      resPtr[n] = batchIn[n*nf + f].re;
+  }
+}
+
+/*
+ * *************************
+ * Registered kernel calls
+ * *************************
+ */
+
+template <class FLOATTYPE, size_t NDIM>
+size_t PsFFTW<FLOATTYPE, NDIM>::addKernel(const FLOATTYPE* kdata) {
+
+  this->dbprt("PsFFTW::addKernel");
+
+  setBatchMem(1);
+  for (int n=0; n<total_local_size; ++n) {
+    in[n].re = kdata[n];
+    in[n].im = 0.0;
+  }
+  transformMany(FORWARD, 1, in);
+
+  // Kernel transform stays resident for convolutions
+  fftw_complex* kspec = new fftw_complex[total_local_size];
+  std::memcpy(kspec, in, total_local_size*sizeof(fftw_complex));
+  kernelSpecs.push_back(kspec);
+
+  return kernelSpecs.size() - 1;
+}
+
+template <class FLOATTYPE, size_t NDIM>
+void PsFFTW<FLOATTYPE, NDIM>::convolveKernel(const FLOATTYPE* data,
+    size_t kernel, FLOATTYPE* resPtr) {
+
+  this->dbprt("PsFFTW::convolveKernel");
+
+  this->checkKernel("PsFFTW::convolveKernel", kernel, kernelSpecs.size());
+  const fftw_complex* kspec = kernelSpecs[kernel];
+
+  for (int n=0; n<total_local_size; ++n) {
+    in[n].re = data[n];
+    in[n].im = 0.0;
+  }
+  transformMany(FORWARD, 1, in);
+
+  // Multiply transforms
+  fftw_complex tmp;
+  for (int n=0; n<total_local_size; ++n) {
+    tmp.re = (in[n].re * kspec[n].re) - (in[n].im * kspec[n].im);
+    tmp.im = (in[n].im * kspec[n].re) + (in[n].re * kspec[n].im);
+    in[n].re = tmp.re;
+    in[n].im = tmp.im;
+  }
+
+  transformMany(BACKWARD, 1, in);
+
+  // Format data for output
+  for (int n=0; n<total_local_size; ++n)
+    resPtr[n] = in[n].re;
+}
+
+template <class FLOATTYPE, size_t NDIM>
+void PsFFTW<FLOATTYPE, NDIM>::convolveKernelMany(
+    const std::vector<const FLOATTYPE*>& data,
+    const std::vector<size_t>& kernels,
+    const std::vector<FLOATTYPE*>& resPtrs) {
+
+  this->dbprt("PsFFTW::convolveKernelMany");
+
+  int nf = (int)resPtrs.size();
+  this->checkManySize("PsFFTW::convolveKernelMany", data.size(), nf);
+  this->checkManySize("PsFFTW::convolveKernelMany", kernels.size(), nf);
+  for (size_t f=0; f<kernels.size(); ++f) {
+    this->checkKernel("PsFFTW::convolveKernelMany", kernels[f],
+        kernelSpecs.size());
+  }
+  if (nf == 0) return;
+
+  forwardMany(data, nf, false);
+
+  // Multiply transforms
+  fftw_complex tmp;
+  for (int f=0; f<nf; ++f) {
+    const fftw_complex* kspec =
+        kernelSpecs[kernels[this->manyIndex(kernels.size(), f)]];
+    for (int n=0; n<total_local_size; ++n) {
+      fftw_complex& b = batchIn[n*nf + f];
+      tmp.re = (b.re * kspec[n].re) - (b.im * kspec[n].im);
+      tmp.im = (b.im * kspec[n].re) + (b.re * kspec[n].im);
+      b.re = tmp.re;
+      b.im = tmp.im;
+    }
+  }
+
+  transformMany(BACKWARD, nf, batchIn);
+
+  // Format data for output
+  for (int f=0; f<nf; ++f) {
+    FLOATTYPE* resPtr = resPtrs[f];
+    for (int n=0; n<total_local_size; ++n)
+      resPtr[n] = batchIn[n*nf + f].re;
+  }
+}
+
+/*
+ * *************************
+ * Resident spectra calls
+ * *************************
+ */
+
+template <class FLOATTYPE, size_t NDIM>
+void PsFFTW<FLOATTYPE, NDIM>::forwardSpectra(
+    const std::vector<const FLOATTYPE*>& data) {
+
+  this->dbprt("PsFFTW::forwardSpectra");
+
+  int nf = (int)data.size();
+  setBatchMem(nf);
+  if (nf > specFields) {
+    delete[] specData;
+    specFields = nf;
+    specData = new fftw_complex[total_local_size*specFields];
+  }
+
+  // Format data for interleaved fft_complex layout
+  for (int f=0; f<nf; ++f) {
+    const FLOATTYPE* dataPtr = data[f];
+    for (int n=0; n<total_local_size; ++n) {
+      specData[n*nf + f].re = dataPtr[n];
+      specData[n*nf + f].im = 0.0;
+    }
+  }
+
+  numSpectra = nf;
+  if (nf > 0) transformMany(FORWARD, nf, specData);
+}
+
+template <class FLOATTYPE, size_t NDIM>
+void PsFFTW<FLOATTYPE, NDIM>::getSpectrumAbs(size_t spec,
+    FLOATTYPE* resPtr) {
+
+  this->checkSpectrum("PsFFTW::getSpectrumAbs", spec, numSpectra);
+
+  // Calculate absolute value
+  for (int n=0; n<total_local_size; ++n) {
+    const fftw_complex& c = specData[n*numSpectra + spec];
+    resPtr[n] = (c.re * c.re) + (c.im * c.im);
+  }
+}
+
+template <class FLOATTYPE, size_t NDIM>
+void PsFFTW<FLOATTYPE, NDIM>::scaleSpectrum(size_t spec,
+    const FLOATTYPE* kdata) {
+
+  this->checkSpectrum("PsFFTW::scaleSpectrum", spec, numSpectra);
+
+  // Scale transform result by kdata (both Re/Im)
+  for (int n=0; n<total_local_size; ++n) {
+    specData[n*numSpectra + spec].re *= kdata[n];
+    specData[n*numSpectra + spec].im *= kdata[n];
+  }
+}
+
+template <class FLOATTYPE, size_t NDIM>
+void PsFFTW<FLOATTYPE, NDIM>::backwardSpectra(
+    const std::vector<FLOATTYPE*>& resPtrs) {
+
+  this->dbprt("PsFFTW::backwardSpectra");
+
+  int nf = numSpectra;
+  if ((int)resPtrs.size() != nf) {
+    TxDebugExcept tde("PsFFTW::backwardSpectra: ");
+    tde << resPtrs.size() << " results for " << nf;
+    tde << " spectra in <FFT " << this->getName() << " >";
+    throw tde;
+  }
+  if (nf == 0) return;
+
+  // Spectra are released by the inverse transform
+  setBatchMem(nf);
+  transformMany(BACKWARD, nf, specData);
+  numSpectra = 0;
+
+  // Format data for output
+  for (int f=0; f<nf; ++f) {
+    FLOATTYPE* resPtr = resPtrs[f];
+    for (int n=0; n<total_local_size; ++n)
+      resPtr[n] = specData[n*nf + f].re;
+  }
+}
+
+//
+// Serial many-field transform with strided fftwnd, result is
+// copied back so all batch transforms are in-place
+//
+template <class FLOATTYPE, size_t NDIM>
+void PsFFTW<FLOATTYPE, NDIM>::transformMany(DirType dir, int nf,
+    fftw_complex* data) {
+
+  planType plan = (dir == FORWARD) ? forwardPlan : backwardPlan;
+#ifdef HAVE_FFTW_THREADS
+  if (numThreads > 1) {
+    fftwnd_threads(numThreads, plan, nf, data, nf, 1, batchWork, nf, 1);
+  }
+  else {
+    fftwnd(plan, nf, data, nf, 1, batchWork, nf, 1);
+  }
+#else
+  fftwnd(plan, nf, data, nf, 1, batchWork, nf, 1);
+#endif
+  std::memcpy(data, batchWork, total_local_size*nf*sizeof(fftw_complex));
+}
+
+//
+// Serial single transform, threaded if numThreads > 1
+//
+template <class FLOATTYPE, size_t NDIM>
+void PsFFTW<FLOATTYPE, NDIM>::executeOne(planType plan, fftw_complex* src,
+    fftw_complex* dst) {
+
+#ifdef HAVE_FFTW_THREADS
+  if (numThreads > 1) {
+    fftwnd_threads_one(numThreads, plan, src, dst);
+    return;
+  }
+#endif
+  fftwnd_one(plan, src, dst);
+}
+
+//
+// Batch data grows to the largest number of fields requested
+//
+template <class FLOATTYPE, size_t NDIM>
+void PsFFTW<FLOATTYPE, NDIM>::setBatchMem(int nf) {
+
+  if (nf <= batchFields) return;
+
+  delete[] batchIn;
+  delete[] batchSpec;
+  delete[] batchWork;
+
+  batchFields = nf;
+  batchIn   = new fftw_complex[total_local_size*batchFields];
+  batchSpec = new fftw_complex[total_local_size*batchFields];
+  batchWork = new fftw_complex[total_local_size*batchFields];
+
+  this->dbprt("batch fields = ", batchFields);
+}
+
+template <class FLOATTYPE, size_t NDIM>
+void PsFFTW<FLOATTYPE, NDIM>::forwardMany(
+    const std::vector<const FLOATTYPE*>& data, int nf, bool imag) {
+
+  setBatchMem(nf);
+
+  // One data set shared by all fields is only transformed once
+  if ( (data.size() == 1) && (nf > 1) ) {
+
+    const FLOATTYPE* dataPtr = data[0];
+    for (int n=0; n<total_local_size; ++n) {
+      in[n].re = imag ? 0.0 : dataPtr[n];
+      in[n].im = imag ? dataPtr[n] : 0.0;
+    }
+    transformMany(FORWARD, 1, in);
+
+    for (int n=0; n<total_local_size; ++n) {
+      for (int f=0; f<nf; ++f) {
+        batchIn[n*nf + f].re = in[n].re;
+        batchIn[n*nf + f].im = in[n].im;
+      }
+    }
+    return;
+  }
+
+  // Format data for interleaved fft_complex layout
+  for (int f=0; f<nf; ++f) {
+    const FLOATTYPE* dataPtr = data[f];
+    for (int n=0; n<total_local_size; ++n) {
+      batchIn[n*nf + f].re = imag ? 0.0 : dataPtr[n];
+      batchIn[n*nf + f].im = imag ? dataPtr[n] : 0.0;
+    }
+  }
+  transformMany(FORWARD, nf, batchIn);
+}
+
+template <class FLOATTYPE, size_t NDIM>
+void PsFFTW<FLOATTYPE, NDIM>::backwardMany(
+    const std::vector<const FLOATTYPE*>& kdata,
+    const std::vector<FLOATTYPE*>& resPtrs) {
+
+  int nf = (int)resPtrs.size();
+
+  // Scale transform results by kdata (both Re/Im)
+  for (int f=0; f<nf; ++f) {
+    const FLOATTYPE* kPtr = kdata[this->manyIndex(kdata.size(), f)];
+    for (int n=0; n<total_local_size; ++n) {
+      batchIn[n*nf + f].re *= kPtr[n];
+      batchIn[n*nf + f].im *= kPtr[n];
+    }
+  }
+
+  transformMany(BACKWARD, nf, batchIn);
+
+  // Format data for output
+  for (int f=0; f<nf; ++f) {
+    FLOATTYPE* resPtr = resPtrs[f];
+    for (int n=0; n<total_local_size; ++n)
+      resPtr[n] = batchIn[n*nf + f].re;
+  }
+}
+
 template class PsFFTW<float, 1>;
 template class PsFFTW<float, 2>;
 template class PsFFTW<float, 3>;
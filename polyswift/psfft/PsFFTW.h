@@ -15,6 +15,7 @@
 
 // std includes
 #include <string>
+#include <vector>
 
 // configure stuff
 #ifdef HAVE_CONFIG_H
@@ -41,7 +42,10 @@ typedef fftwnd_plan  planType;
 typedef fftwnd_plan  planType;
 
 /**
- * Fastest Fourier-transform in the West interface class
+ * Fastest Fourier-transform in the West interface class. Serial
+ * transforms use numThreads FFTW threads when the FFTW threads
+ * library is present, the fftwnd_mpi transforms are not threaded
+ * (build with ENABLE_FFTW3 for threads within each rank).
  */
 template <class FLOATTYPE, size_t NDIM>
 class PsFFTW : public virtual PsFFT<FLOATTYPE, NDIM> {
@@ -123,6 +127,70 @@ class PsFFTW : public virtual PsFFT<FLOATTYPE, NDIM> {
    virtual void scaledFFTPair(const FLOATTYPE* data,
        const FLOATTYPE* kdata, FLOATTYPE* resPtr);
 
+/**
+ * Perform multi-dimensional FFT pair on two REAL data sets packed
+ * into the Re/Im parts of one complex transform
+ *
+ * @param data1   pointer to first REAL data to transform
+ * @param data2   pointer to second REAL data to transform
+ * @param kdata   pointer to real, even data to scale transform
+ * @param resPtr1 pointer to first Re[result] (also supplied by caller)
+ * @param resPtr2 pointer to second Re[result] (also supplied by caller)
+ */
+   virtual void scaledFFTPairTwo(const FLOATTYPE* data1,
+       const FLOATTYPE* data2, const FLOATTYPE* kdata,
+       FLOATTYPE* resPtr1, FLOATTYPE* resPtr2);
+
+/**
+ * Serial transforms can run concurrently in separate workspaces
+ */
+   virtual bool hasWorkspaces() {
+     return true;
+   }
+
+/**
+ * Add an in/out pair on the shared plans for one concurrent caller
+ *
+ * @return index of workspace
+ */
+   virtual size_t addWorkspace();
+
+/**
+ * Perform scaledFFTPair in a workspace from addWorkspace
+ *
+ * @param ws     index of workspace
+ * @param data   pointer to REAL data to transform
+ * @param kdata  pointer to data to scale transform
+ * @param resPtr pointer to Re[result] (also supplied by caller)
+ */
+   virtual void scaledFFTPairWs(size_t ws, const FLOATTYPE* data,
+       const FLOATTYPE* kdata, FLOATTYPE* resPtr);
+
+/**
+ * Perform scaledFFTPairTwo in a workspace from addWorkspace
+ *
+ * @param ws      index of workspace
+ * @param data1   pointer to first REAL data to transform
+ * @param data2   pointer to second REAL data to transform
+ * @param kdata   pointer to real, even data to scale transform
+ * @param resPtr1 pointer to first Re[result] (also supplied by caller)
+ * @param resPtr2 pointer to second Re[result] (also supplied by caller)
+ */
+   virtual void scaledFFTPairTwoWs(size_t ws, const FLOATTYPE* data1,
+       const FLOATTYPE* data2, const FLOATTYPE* kdata,
+       FLOATTYPE* resPtr1, FLOATTYPE* resPtr2);
+
+/**
+ * Perform crossSpectrumRe in a workspace from addWorkspace
+ *
+ * @param ws     index of workspace
+ * @param data1  pointer to first REAL data to transform
+ * @param data2  pointer to second REAL data to transform
+ * @param resPtr pointer to result in k-space (also supplied by caller)
+ */
+   virtual void crossSpectrumReWs(size_t ws, const FLOATTYPE* data1,
+       const FLOATTYPE* data2, FLOATTYPE* resPtr);
+
 /**
  * Perform multi-dimensional FFT pair, scaling the
  * result by kdata in-between transform pair
@@ -151,8 +219,150 @@ class PsFFTW : public virtual PsFFT<FLOATTYPE, NDIM> {
    virtual void calcBackwardFFT(const FLOATTYPE* data,
        FLOATTYPE* resPtr);
 
+/**
+ * Perform multi-dimensional FFT pairs on several REAL data sets
+ * with one many-field transform each way
+ *
+ * @param data    pointers to REAL data to transform
+ * @param kdata   pointers to data to scale transforms
+ * @param resPtrs pointers to Re[result] (also supplied by caller)
+ */
+   virtual void scaledFFTPairMany(const std::vector<const FLOATTYPE*>& data,
+       const std::vector<const FLOATTYPE*>& kdata,
+       const std::vector<FLOATTYPE*>& resPtrs);
+
+/**
+ * Perform multi-dimensional FFT pairs on several IMAGINARY data sets
+ * with one many-field transform each way
+ *
+ * @param data    pointers to IMAGINARY data to transform
+ * @param kdata   pointers to data to scale transforms
+ * @param resPtrs pointers to Re[result] (also supplied by caller)
+ */
+   virtual void scaledFFTPairImMany(const std::vector<const FLOATTYPE*>& data,
+       const std::vector<const FLOATTYPE*>& kdata,
+       const std::vector<FLOATTYPE*>& resPtrs);
+
+/**
+ * Convolve several pairs of REAL data sets with many-field transforms
+ *
+ * @param data1   pointers to REAL data to transform
+ * @param data2   pointers to REAL data to scale transforms
+ * @param resPtrs pointers to Re[result] (also supplied by caller)
+ */
+   virtual void convolveReMany(const std::vector<const FLOATTYPE*>& data1,
+       const std::vector<const FLOATTYPE*>& data2,
+       const std::vector<FLOATTYPE*>& resPtrs);
+
+/**
+ * Perform forward multi-dimensional FFT on several REAL data sets
+ * with one many-field transform
+ *
+ * @param data    pointers to REAL data to transform
+ * @param resPtrs pointers to Re[result] (also supplied by caller)
+ */
+   virtual void calcForwardFFTMany(const std::vector<const FLOATTYPE*>& data,
+       const std::vector<FLOATTYPE*>& resPtrs);
+
+/**
+ * Register a REAL kernel, its transform is kept for convolveKernel
+ *
+ * @param kdata pointer to REAL kernel data
+ * @return index of kernel for convolveKernel calls
+ */
+   virtual size_t addKernel(const FLOATTYPE* kdata);
+
+/**
+ * Convolve REAL data with a registered kernel, one transform
+ * each way
+ *
+ * @param data   pointer to REAL data to transform
+ * @param kernel index of kernel from addKernel
+ * @param resPtr pointer to Re[result] (also supplied by caller)
+ */
+   virtual void convolveKernel(const FLOATTYPE* data, size_t kernel,
+       FLOATTYPE* resPtr);
+
+/**
+ * Convolve REAL data sets with registered kernels, one
+ * many-field transform each way
+ *
+ * @param data    pointers to REAL data to transform
+ * @param kernels indices of kernels from addKernel
+ * @param resPtrs pointers to Re[result] (also supplied by caller)
+ */
+   virtual void convolveKernelMany(const std::vector<const FLOATTYPE*>& data,
+       const std::vector<size_t>& kernels,
+       const std::vector<FLOATTYPE*>& resPtrs);
+
+/**
+ * Forward transform REAL data sets with one many-field transform
+ * and keep the spectra resident
+ *
+ * @param data pointers to REAL data to transform
+ */
+   virtual void forwardSpectra(const std::vector<const FLOATTYPE*>& data);
+
+/**
+ * Get |a+bi| elementwise of a resident spectrum
+ *
+ * @param spec   index of spectrum from forwardSpectra
+ * @param resPtr pointer to result in k-space (also supplied by caller)
+ */
+   virtual void getSpectrumAbs(size_t spec, FLOATTYPE* resPtr);
+
+/**
+ * Scale a resident spectrum elementwise (both Re/Im)
+ *
+ * @param spec  index of spectrum from forwardSpectra
+ * @param kdata pointer to data to scale spectrum
+ */
+   virtual void scaleSpectrum(size_t spec, const FLOATTYPE* kdata);
+
+/**
+ * Backward transform all resident spectra with one
+ * many-field transform
+ *
+ * @param resPtrs pointers to Re[result], one per spectrum
+ */
+   virtual void backwardSpectra(const std::vector<FLOATTYPE*>& resPtrs);
+
  protected:
 
+/**
+ * Transform nf interleaved fields in-place, ie. element n of
+ * field f is at data[n*nf + f] (the n_fields layout of fftwnd_mpi)
+ *
+ * @param dir  direction of transform
+ * @param nf   number of fields
+ * @param data pointer to interleaved data
+ */
+   virtual void transformMany(DirType dir, int nf, fftw_complex* data);
+
+   /** Interleaved data for batch transforms */
+   fftw_complex* batchIn;
+
+   /** Interleaved transforms kept during batch convolutions */
+   fftw_complex* batchSpec;
+
+   /** Interleaved workspace for batch transforms */
+   fftw_complex* batchWork;
+
+   /** Number of fields the batch data structures hold */
+   int batchFields;
+
+   /** Transforms of kernels registered by addKernel */
+   std::vector<fftw_complex*> kernelSpecs;
+
+   /** Interleaved resident spectra from forwardSpectra */
+   fftw_complex* specData;
+
+   /** Number of spectra the specData structure holds */
+   int specFields;
+
+   /** Number of resident spectra */
+   int numSpectra;
+
    /** Internal input data structure */
    fftw_complex* in;
 
@@ -168,8 +378,69 @@ class PsFFTW : public virtual PsFFT<FLOATTYPE, NDIM> {
    /** Total number of local elements in data */
    int total_local_size;
 
+   /** Number of threads for each serial transform */
+   int numThreads;
+
  private:
 
+   /** Input structures of workspaces from addWorkspace */
+   std::vector<fftw_complex*> wsIn;
+
+   /** Output structures of workspaces from addWorkspace */
+   std::vector<fftw_complex*> wsOut;
+
+/**
+ * Serial scaled FFT pair through the given structures
+ *
+ * @param data1   pointer to REAL data to transform
+ * @param data2   pointer to data for Im part, NULL for none
+ * @param kdata   pointer to data to scale transform
+ * @param resPtr1 pointer to Re[result]
+ * @param resPtr2 pointer to Im[result], NULL for none
+ * @param src     input structure
+ * @param dst     output structure
+ */
+   void scaledPair(const FLOATTYPE* data1, const FLOATTYPE* data2,
+       const FLOATTYPE* kdata, FLOATTYPE* resPtr1, FLOATTYPE* resPtr2,
+       fftw_complex* src, fftw_complex* dst);
+
+/**
+ * Allocate batch data structures for at least nf fields
+ *
+ * @param nf number of fields
+ */
+   void setBatchMem(int nf);
+
+/**
+ * Load REAL (or IMAGINARY) data sets and forward transform into
+ * batchIn. A single data set is transformed once and copied to all
+ * nf fields.
+ *
+ * @param data pointers to data to transform
+ * @param nf   number of fields
+ * @param imag true to load data as IMAGINARY part
+ */
+   void forwardMany(const std::vector<const FLOATTYPE*>& data, int nf,
+       bool imag);
+
+/**
+ * Scale batchIn by kdata, backward transform and unload Re parts
+ *
+ * @param kdata   pointers to data to scale transforms
+ * @param resPtrs pointers to Re[result]
+ */
+   void backwardMany(const std::vector<const FLOATTYPE*>& kdata,
+       const std::vector<FLOATTYPE*>& resPtrs);
+
+/**
+ * Execute serial transform, with FFTW threads if numThreads > 1
+ *
+ * @param plan FFTW plan
+ * @param src  pointer to data to transform
+ * @param dst  pointer to result
+ */
+   void executeOne(planType plan, fftw_complex* src, fftw_complex* dst);
+
    /** FFTW plan for forward transforms */
    planType forwardPlan;
 
@@ -0,0 +1,1066 @@
+/**
+ *
+ * @file    PsFFTW3.cpp
+ *
+ * @brief   Fourier transform using the FFTW3 interface
+ *
+ * @version $Id: PsFFTW3.cpp 6319 2006-11-14 22:39:46Z swsides $
+ *
+ * Copyright &copy; 2008-2020, Tech-X Corporation, Boulder, CO.
+ * All rights reserved.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+// std includes
+#include <cstdio>
+#include <algorithm>
+
+#ifdef HAVE_MPI
+#define MPICH_IGNORE_CXX_SEEK
+#include <mpi.h>
+#include <fftw3-mpi.h>
+#else
+#include <fftw3.h>
+#endif
+
+// psfft includes
+#include <PsFFTW3.h>
+
+//
+// Library level setup is done once for all FFTW3 objects
+//
+static bool fftw3Initialized = false;
+
+static void initFFTW3() {
+  if (fftw3Initialized) return;
+#ifdef HAVE_FFTW3_THREADS
+  fftw_init_threads();
+#endif
+#ifdef HAVE_MPI
+  fftw_mpi_init();
+#endif
+  fftw3Initialized = true;
+}
+
+template <class FLOATTYPE, size_t NDIM>
+PsFFTW3<FLOATTYPE, NDIM>::PsFFTW3() {
+
+  plannerEffort = "estimate";
+  wisdomFile = "";
+  numThreads = 1;
+  transposeOrder = false;
+  transposeOrderSet = false;
+
+  localSize = 1;
+  localSpecSize = 1;
+
+  // Set pointers
+  cdata = NULL;
+  cdata2 = NULL;
+  forwardPlan3 = NULL;
+  backwardPlan3 = NULL;
+
+  // Batch plans made on first use of each size
+  batchData = NULL;
+  batchSpec = NULL;
+  batchFields = 0;
+  batchAlloc = 0;
+  forwardManyPlan3 = NULL;
+  backwardManyPlan3 = NULL;
+
+  // No resident spectra
+  specData = NULL;
+  specAlloc = 0;
+  numSpectra = 0;
+}
+
+template <class FLOATTYPE, size_t NDIM>
+PsFFTW3<FLOATTYPE, NDIM>::~PsFFTW3() {
+
+  if (forwardPlan3)  fftw_destroy_plan(forwardPlan3);
+  if (backwardPlan3) fftw_destroy_plan(backwardPlan3);
+  if (cdata)  fftw_free(cdata);
+  if (cdata2) fftw_free(cdata2);
+  typename std::map<size_t, BatchPlan>::iterator it;
+  for (it = batchPlans.begin(); it != batchPlans.end(); ++it) {
+    fftw_destroy_plan(it->second.forward);
+    fftw_destroy_plan(it->second.backward);
+    fftw_free(it->second.data);
+    fftw_free(it->second.spec);
+  }
+  for (size_t k=0; k<kernelSpecs.size(); ++k) fftw_free(kernelSpecs[k]);
+  if (specData) fftw_free(specData);
+  for (size_t w=0; w<wsData.size(); ++w) fftw_free(wsData[w]);
+}
+
+template <class FLOATTYPE, size_t NDIM>
+void PsFFTW3<FLOATTYPE, NDIM>::setAttrib(const TxHierAttribSetIntDbl& tas) {
+
+  // Scoping call to base class
+  PsFFT<FLOATTYPE, NDIM>::setAttrib(tas);
+
+  this->dbprt("PsFFTW3::setAttrib() ");
+
+  // Planner effort
+  if (tas.hasString("plannerEffort")) {
+    plannerEffort = tas.getString("plannerEffort");
+    if (plannerEffort != "estimate" && plannerEffort != "measure" &&
+        plannerEffort != "patient"  && plannerEffort != "exhaustive") {
+      TxDebugExcept tde("PsFFTW3::setAttrib: plannerEffort ");
+      tde << plannerEffort << " must be one of ";
+      tde << "estimate, measure, patient, exhaustive";
+      tde << " in <FFT " << this->getName() << " >";
+      throw tde;
+    }
+  }
+
+  // Wisdom file, read before and written after planning
+  if (tas.hasString("wisdomFile")) {
+    wisdomFile = tas.getString("wisdomFile");
+  }
+
+  // Threads per transform
+  if (tas.hasParam("numThreads")) {
+    numThreads = (int)tas.getParam("numThreads");
+    if (numThreads < 1) numThreads = 1;
+#ifndef HAVE_FFTW3_THREADS
+    if (numThreads > 1) {
+      TxDebugExcept tde("PsFFTW3::setAttrib: numThreads > 1 ");
+      tde << "but FFTW3 threads library not found";
+      tde << " in <FFT " << this->getName() << " >";
+      throw tde;
+    }
+#endif
+  }
+
+  // k-space order for MPI
+  if (tas.hasString("transposeOrder")) {
+    std::string tStr = tas.getString("transposeOrder");
+    transposeOrder = (tStr == "on");
+    transposeOrderSet = true;
+  }
+}
+
+template <class FLOATTYPE, size_t NDIM>
+void PsFFTW3<FLOATTYPE, NDIM>::buildData() {
+
+  // Scoping call to base class
+  PsFFT<FLOATTYPE, NDIM>::buildData();
+
+  this->dbprt("PsFFTW3::buildData() ");
+
+  initFFTW3();
+
+  // *************************************************
+  // Set rank/dimensions for plans
+  // *************************************************
+  std::vector<size_t> dims;
+  dims = this->globalDims;
+  int rank = (int)dims.size();
+
+#ifdef HAVE_MPI
+
+  // Default k-space order is the layout of the grid decomp, so
+  // objects on the transposed FFT grid get the transposed spectrum
+  if (!transposeOrderSet) {
+    transposeOrder = this->getGrid().getDecomp().isTransposed();
+  }
+  this->dbprt("transposeOrder = ", (int)transposeOrder);
+
+  ptrdiff_t* planDims = new ptrdiff_t[rank];
+  for (int n=0; n<rank; ++n) planDims[n] = dims[n];
+
+  ptrdiff_t local_n0, local_0_start;
+  ptrdiff_t local_n1, local_1_start;
+  ptrdiff_t alloc_local;
+  size_t inner = 1;
+  for (int n=2; n<rank; ++n) inner *= dims[n];
+
+  if (transposeOrder) {
+    alloc_local = fftw_mpi_local_size_transposed(rank, planDims,
+        this->getPlanComm(), &local_n0, &local_0_start,
+        &local_n1, &local_1_start);
+    localSpecSize = local_n1*dims[0]*inner;
+  }
+  else {
+    alloc_local = fftw_mpi_local_size(rank, planDims,
+        this->getPlanComm(), &local_n0, &local_0_start);
+    localSpecSize = local_n0*dims[1]*inner;
+  }
+  localSize = local_n0*dims[1]*inner;
+
+  // FFTW3 and the FFTW2 decomp must agree on the local slab
+  std::vector<size_t> gridCells =
+      this->getGrid().getDecomp().getNumCellsLocal();
+  size_t gridSize = 1;
+  for (size_t n=0; n<gridCells.size(); ++n) gridSize *= gridCells[n];
+  size_t expected = transposeOrder ? localSpecSize : localSize;
+  if (gridSize != expected) {
+    TxDebugExcept tde("PsFFTW3::buildData: FFTW3 local size ");
+    tde << expected << " does not match grid decomp size " << gridSize;
+    tde << " in <FFT " << this->getName() << " >";
+    throw tde;
+  }
+
+  cdata  = (double*) fftw_malloc(sizeof(fftw_complex)*alloc_local);
+  cdata2 = (double*) fftw_malloc(sizeof(fftw_complex)*alloc_local);
+
+#else
+
+  int* planDims = new int[rank];
+  for (int n=0; n<rank; ++n) planDims[n] = dims[n];
+
+  localSize = 1;
+  for (int n=0; n<rank; ++n) localSize *= dims[n];
+  localSpecSize = localSize;
+
+  cdata  = (double*) fftw_malloc(sizeof(fftw_complex)*localSize);
+  cdata2 = (double*) fftw_malloc(sizeof(fftw_complex)*localSize);
+
+#endif
+
+  this->dbprt("localSize = ", (int)localSize);
+
+  // Planning
+  importWisdom();
+
+#ifdef HAVE_FFTW3_THREADS
+  fftw_plan_with_nthreads(numThreads);
+#endif
+
+  unsigned flags = plannerFlag();
+  fftw_complex* buf = (fftw_complex*) cdata;
+
+#ifdef HAVE_MPI
+  unsigned fflags = flags;
+  unsigned bflags = flags;
+  if (transposeOrder) {
+    fflags |= FFTW_MPI_TRANSPOSED_OUT;
+    bflags |= FFTW_MPI_TRANSPOSED_IN;
+  }
+  forwardPlan3  = fftw_mpi_plan_dft(rank, planDims, buf, buf,
+      this->getPlanComm(), FFTW_FORWARD, fflags);
+  backwardPlan3 = fftw_mpi_plan_dft(rank, planDims, buf, buf,
+      this->getPlanComm(), FFTW_BACKWARD, bflags);
+#else
+  forwardPlan3  = fftw_plan_dft(rank, planDims, buf, buf,
+      FFTW_FORWARD, flags);
+  backwardPlan3 = fftw_plan_dft(rank, planDims, buf, buf,
+      FFTW_BACKWARD, flags);
+#endif
+
+  // Explicitly free local memory
+  delete[] planDims;
+
+  if (!forwardPlan3 || !backwardPlan3) {
+    TxDebugExcept tde("PsFFTW3::buildData: FFTW3 plan creation failed");
+    tde << " in <FFT " << this->getName() << " >";
+    throw tde;
+  }
+
+  // Wisdom is saved once here, batch plans made on use are not
+  // exported so the transform calls do no file I/O
+  exportWisdom();
+}
+
+template <class FLOATTYPE, size_t NDIM>
+void PsFFTW3<FLOATTYPE, NDIM>::buildSolvers() {
+
+  // Scoping call to base class
+  PsFFT<FLOATTYPE, NDIM>::buildSolvers();
+}
+
+//
+// Planner flag from input string
+//
+template <class FLOATTYPE, size_t NDIM>
+unsigned PsFFTW3<FLOATTYPE, NDIM>::plannerFlag() {
+
+  if (plannerEffort == "measure")    return FFTW_MEASURE;
+  if (plannerEffort == "patient")    return FFTW_PATIENT;
+  if (plannerEffort == "exhaustive") return FFTW_EXHAUSTIVE;
+  return FFTW_ESTIMATE;
+}
+
+//
+// Wisdom is read on rank 0 of the plan communicator and shared
+// over it. Plans on replicated grids are on MPI_COMM_SELF, so each
+// rank reads the file itself.
+//
+template <class FLOATTYPE, size_t NDIM>
+void PsFFTW3<FLOATTYPE, NDIM>::importWisdom() {
+
+  if (wisdomFile.empty()) return;
+
+  int found = 0;
+#ifdef HAVE_MPI
+  MPI_Comm planComm = this->getPlanComm();
+  int planRank = 0;
+  MPI_Comm_rank(planComm, &planRank);
+  if (planRank == 0) {
+    found = fftw_import_wisdom_from_filename(wisdomFile.c_str());
+  }
+  if (planComm != MPI_COMM_SELF) fftw_mpi_broadcast_wisdom(planComm);
+#else
+  found = fftw_import_wisdom_from_filename(wisdomFile.c_str());
+#endif
+
+  if (found) this->pprt("Loaded FFTW wisdom from ", wisdomFile);
+}
+
+//
+// Wisdom is gathered to rank 0 of the plan communicator and written.
+// With single-rank plans only the first world rank writes the file.
+//
+template <class FLOATTYPE, size_t NDIM>
+void PsFFTW3<FLOATTYPE, NDIM>::exportWisdom() {
+
+  if (wisdomFile.empty()) return;
+
+  bool writer = true;
+#ifdef HAVE_MPI
+  MPI_Comm planComm = this->getPlanComm();
+  if (planComm == MPI_COMM_SELF) {
+    writer = (this->getCommBase().getRank() == 0);
+  }
+  else {
+    fftw_mpi_gather_wisdom(planComm);
+    int planRank = 0;
+    MPI_Comm_rank(planComm, &planRank);
+    writer = (planRank == 0);
+  }
+#endif
+
+  if (writer) {
+    if (!fftw_export_wisdom_to_filename(wisdomFile.c_str())) {
+      this->pprt("Could not write FFTW wisdom to ", wisdomFile);
+    }
+  }
+}
+
+template <class FLOATTYPE, size_t NDIM>
+void PsFFTW3<FLOATTYPE, NDIM>::execute(fftw_plan_s* plan) {
+  fftw_execute(plan);
+}
+
+/*
+ * *************************
+ * FFTW3 calls
+ * *************************
+ */
+
+template <class FLOATTYPE, size_t NDIM>
+void PsFFTW3<FLOATTYPE, NDIM>::forwardFFTAbs(
+    const FLOATTYPE* data1, FLOATTYPE* resPtr) {
+
+  this->dbprt("PsFFTW3::forwardFFTAbs");
+
+  for (size_t n=0; n<localSize; ++n) {
+    cdata[2*n]   = data1[n];
+    cdata[2*n+1] = 0.0;
+  }
+
+  execute(forwardPlan3);
+
+  // Calculate absolute value
+  for (size_t n=0; n<localSpecSize; ++n) {
+    resPtr[n] = (cdata[2*n]*cdata[2*n]) + (cdata[2*n+1]*cdata[2*n+1]);
+  }
+}
+
+template <class FLOATTYPE, size_t NDIM>
+void PsFFTW3<FLOATTYPE, NDIM>::convolveRe(
+    const FLOATTYPE* data1, const FLOATTYPE* data2, FLOATTYPE* resPtr){
+
+  this->dbprt("PsFFTW3::convolveRe");
+
+  // Format data2 and transform into cdata2
+  for (size_t n=0; n<localSize; ++n) {
+    cdata2[2*n]   = data2[n];
+    cdata2[2*n+1] = 0.0;
+  }
+  fftw_execute_dft(forwardPlan3, (fftw_complex*) cdata2,
+      (fftw_complex*) cdata2);
+
+  for (size_t n=0; n<localSize; ++n) {
+    cdata[2*n]   = data1[n];
+    cdata[2*n+1] = 0.0;
+  }
+  execute(forwardPlan3);
+
+  // Multiply transforms
+  double re, im;
+  for (size_t n=0; n<localSpecSize; ++n) {
+    re = (cdata[2*n]*cdata2[2*n]) - (cdata[2*n+1]*cdata2[2*n+1]);
+    im = (cdata[2*n+1]*cdata2[2*n]) + (cdata[2*n]*cdata2[2*n+1]);
+    cdata[2*n]   = re;
+    cdata[2*n+1] = im;
+  }
+
+  execute(backwardPlan3);
+
+  for (size_t n=0; n<localSize; ++n)
+    resPtr[n] = cdata[2*n];
+}
+
+//
+// Utility method where by F(data)*kdata elementwise
+// ie. the real and imaginary parts of the transform of data is
+// scaled by the real kdata array
+//
+template <class FLOATTYPE, size_t NDIM>
+void PsFFTW3<FLOATTYPE, NDIM>::scaledFFTPair(
+    const FLOATTYPE* data, const FLOATTYPE* kdata, FLOATTYPE* resPtr){
+
+  this->dbprt("PsFFTW3::scaledFFTPair");
+  scaledPair(data, NULL, kdata, resPtr, NULL, cdata);
+}
+
+//
+// Two real data sets packed as Re/Im of one complex transform.
+// kdata is real and even so F^-1[k*F[a+ib]] = (k*a) + i(k*b)
+//
+template <class FLOATTYPE, size_t NDIM>
+void PsFFTW3<FLOATTYPE, NDIM>::scaledFFTPairTwo(
+    const FLOATTYPE* data1, const FLOATTYPE* data2,
+    const FLOATTYPE* kdata, FLOATTYPE* resPtr1, FLOATTYPE* resPtr2){
+
+  this->dbprt("PsFFTW3::scaledFFTPairTwo");
+  scaledPair(data1, data2, kdata, resPtr1, resPtr2, cdata);
+}
+
+//
+// Workspaces are aligned buffers for fftw_execute_dft on the
+// shared in-place plans, which is thread-safe for distinct data
+//
+template <class FLOATTYPE, size_t NDIM>
+size_t PsFFTW3<FLOATTYPE, NDIM>::addWorkspace() {
+
+  if (!hasWorkspaces()) return 0;
+
+  wsData.push_back((double*) fftw_malloc(sizeof(fftw_complex)*localSize));
+  return wsData.size();
+}
+
+template <class FLOATTYPE, size_t NDIM>
+void PsFFTW3<FLOATTYPE, NDIM>::scaledFFTPairWs(size_t ws,
+    const FLOATTYPE* data, const FLOATTYPE* kdata, FLOATTYPE* resPtr){
+
+  double* buf = cdata;
+  if (ws > 0 && ws <= wsData.size()) buf = wsData[ws-1];
+  scaledPair(data, NULL, kdata, resPtr, NULL, buf);
+}
+
+template <class FLOATTYPE, size_t NDIM>
+void PsFFTW3<FLOATTYPE, NDIM>::scaledFFTPairTwoWs(size_t ws,
+    const FLOATTYPE* data1, const FLOATTYPE* data2,
+    const FLOATTYPE* kdata, FLOATTYPE* resPtr1, FLOATTYPE* resPtr2){
+
+  double* buf = cdata;
+  if (ws > 0 && ws <= wsData.size()) buf = wsData[ws-1];
+  scaledPair(data1, data2, kdata, resPtr1, resPtr2, buf);
+}
+
+//
+// Polarization in-place on the workspace buffer, as the
+// PsFFTBase default without the temporary copies
+//
+template <class FLOATTYPE, size_t NDIM>
+void PsFFTW3<FLOATTYPE, NDIM>::crossSpectrumReWs(size_t ws,
+    const FLOATTYPE* data1, const FLOATTYPE* data2, FLOATTYPE* resPtr){
+
+  if (ws == 0 || ws > wsData.size()) {
+    this->crossSpectrumRe(data1, data2, resPtr);
+    return;
+  }
+  double* buf = wsData[ws-1];
+
+  for (size_t n=0; n<localSize; ++n) {
+    buf[2*n]   = data1[n] + data2[n];
+    buf[2*n+1] = 0.0;
+  }
+  fftw_execute_dft(forwardPlan3, (fftw_complex*) buf, (fftw_complex*) buf);
+  for (size_t n=0; n<localSpecSize; ++n)
+    resPtr[n] = 0.25*((buf[2*n]*buf[2*n]) + (buf[2*n+1]*buf[2*n+1]));
+
+  for (size_t n=0; n<localSize; ++n) {
+    buf[2*n]   = data1[n] - data2[n];
+    buf[2*n+1] = 0.0;
+  }
+  fftw_execute_dft(forwardPlan3, (fftw_complex*) buf, (fftw_complex*) buf);
+  for (size_t n=0; n<localSpecSize; ++n)
+    resPtr[n] -= 0.25*((buf[2*n]*buf[2*n]) + (buf[2*n+1]*buf[2*n+1]));
+}
+
+//
+// FFT pair in-place on buf (cdata or a workspace). data2 (if not
+// NULL) is packed as the Im part and returned through resPtr2
+//
+template <class FLOATTYPE, size_t NDIM>
+void PsFFTW3<FLOATTYPE, NDIM>::scaledPair(
+    const FLOATTYPE* data1, const FLOATTYPE* data2,
+    const FLOATTYPE* kdata, FLOATTYPE* resPtr1, FLOATTYPE* resPtr2,
+    double* buf){
+
+  for (size_t n=0; n<localSize; ++n) {
+    buf[2*n]   = data1[n];
+    buf[2*n+1] = data2 ? data2[n] : 0.0;
+  }
+
+  if (buf == cdata) execute(forwardPlan3);
+  else fftw_execute_dft(forwardPlan3, (fftw_complex*) buf,
+      (fftw_complex*) buf);
+
+  // Scale transform result by kdata (both Re/Im)
+  for (size_t n=0; n<localSpecSize; ++n) {
+    buf[2*n]   *= kdata[n];
+    buf[2*n+1] *= kdata[n];
+  }
+
+  if (buf == cdata) execute(backwardPlan3);
+  else fftw_execute_dft(backwardPlan3, (fftw_complex*) buf,
+      (fftw_complex*) buf);
+
+  for (size_t n=0; n<localSize; ++n)
+    resPtr1[n] = buf[2*n];
+  if (resPtr2) {
+    for (size_t n=0; n<localSize; ++n)
+      resPtr2[n] = buf[2*n+1];
+  }
+}
+
+template <class FLOATTYPE, size_t NDIM>
+void PsFFTW3<FLOATTYPE, NDIM>::scaledFFTPairIm(
+    const FLOATTYPE* data, const FLOATTYPE* kdata, FLOATTYPE* resPtr){
+
+  this->dbprt("PsFFTW3::scaledFFTPairIm");
+
+  for (size_t n=0; n<localSize; ++n) {
+    cdata[2*n]   = 0.0;
+    cdata[2*n+1] = data[n];
+  }
+
+  execute(forwardPlan3);
+
+  // Scale transform result by kdata (both Re/Im)
+  for (size_t n=0; n<localSpecSize; ++n) {
+    cdata[2*n]   *= kdata[n];
+    cdata[2*n+1] *= kdata[n];
+  }
+
+  execute(backwardPlan3);
+
+  for (size_t n=0; n<localSize; ++n)
+    resPtr[n] = cdata[2*n];
+}
+
+template <class FLOATTYPE, size_t NDIM>
+void PsFFTW3<FLOATTYPE, NDIM>::calcForwardFFT(const FLOATTYPE* data,
+    FLOATTYPE* resPtr) {
+
+  this->dbprt("PsFFTW3::calcForwardFFT");
+
+  for (size_t n=0; n<localSize; ++n) {
+    cdata[2*n]   = data[n];
+    cdata[2*n+1] = 0.0;
+  }
+
+  execute(forwardPlan3);
+
+  for (size_t n=0; n<localSpecSize; ++n)
+    resPtr[n] = cdata[2*n];
+}
+
+template <class FLOATTYPE, size_t NDIM>
+void PsFFTW3<FLOATTYPE, NDIM>::calcBackwardFFT(const FLOATTYPE* data,
+    FLOATTYPE* resPtr) {
+
+  this->dbprt("PsFFTW3::calcBackwardFFT");
+
+  for (size_t n=0; n<localSpecSize; ++n) {
+    cdata[2*n]   = data[n];
+    cdata[2*n+1] = 0.0;
+  }
+
+  execute(backwardPlan3);
+
+  for (size_t n=0; n<localSize; ++n)
+    resPtr[n] = cdata[2*n];
+}
+
+/*
+ * *************************
+ * FFTW3 batch (many-field) calls
+ * *************************
+ */
+
+template <class FLOATTYPE, size_t NDIM>
+void PsFFTW3<FLOATTYPE, NDIM>::scaledFFTPairMany(
+    const std::vector<const FLOATTYPE*>& data,
+    const std::vector<const FLOATTYPE*>& kdata,
+    const std::vector<FLOATTYPE*>& resPtrs) {
+
+  this->dbprt("PsFFTW3::scaledFFTPairMany");
+
+  size_t nf = resPtrs.size();
+  this->checkManySize("PsFFTW3::scaledFFTPairMany", data.size(), nf);
+  this->checkManySize("PsFFTW3::scaledFFTPairMany", kdata.size(), nf);
+  if (nf == 0) return;
+
+  forwardMany(data, nf, false);
+  backwardMany(kdata, resPtrs);
+}
+
+template <class FLOATTYPE, size_t NDIM>
+void PsFFTW3<FLOATTYPE, NDIM>::scaledFFTPairImMany(
+    const std::vector<const FLOATTYPE*>& data,
+    const std::vector<const FLOATTYPE*>& kdata,
+    const std::vector<FLOATTYPE*>& resPtrs) {
+
+  this->dbprt("PsFFTW3::scaledFFTPairImMany");
+
+  size_t nf = resPtrs.size();
+  this->checkManySize("PsFFTW3::scaledFFTPairImMany", data.size(), nf);
+  this->checkManySize("PsFFTW3::scaledFFTPairImMany", kdata.size(), nf);
+  if (nf == 0) return;
+
+  forwardMany(data, nf, true);
+  backwardMany(kdata, resPtrs);
+}
+
+template <class FLOATTYPE, size_t NDIM>
+void PsFFTW3<FLOATTYPE, NDIM>::convolveReMany(
+    const std::vector<const FLOATTYPE*>& data1,
+    const std::vector<const FLOATTYPE*>& data2,
+    const std::vector<FLOATTYPE*>& resPtrs) {
+
+  this->dbprt("PsFFTW3::convolveReMany");
+
+  size_t nf = resPtrs.size();
+  this->checkManySize("PsFFTW3::convolveReMany", data1.size(), nf);
+  this->checkManySize("PsFFTW3::convolveReMany", data2.size(), nf);
+  if (nf == 0) return;
+
+  // Keep transforms of data2 while data1 is transformed
+  forwardMany(data2, nf, false);
+  std::swap(batchData, batchSpec);
+  forwardMany(data1, nf, false);
+
+  // Multiply transforms
+  double re, im;
+  size_t nsize = localSpecSize*nf;
+  for (size_t n=0; n<nsize; ++n) {
+    re = (batchData[2*n]*batchSpec[2*n]) -
+        (batchData[2*n+1]*batchSpec[2*n+1]);
+    im = (batchData[2*n+1]*batchSpec[2*n]) +
+        (batchData[2*n]*batchSpec[2*n+1]);
+    batchData[2*n]   = re;
+    batchData[2*n+1] = im;
+  }
+
+  executeMany(backwardManyPlan3, batchData);
+
+  for (size_t f=0; f<nf; ++f) {
+    FLOATTYPE* resPtr = resPtrs[f];
+    for (size_t n=0; n<localSize; ++n)
+      resPtr[n] = batchData[2*(n*nf + f)];
+  }
+}
+
+template <class FLOATTYPE, size_t NDIM>
+void PsFFTW3<FLOATTYPE, NDIM>::calcForwardFFTMany(
+    const std::vector<const FLOATTYPE*>& data,
+    const std::vector<FLOATTYPE*>& resPtrs) {
+
+  this->dbprt("PsFFTW3::calcForwardFFTMany");
+
+  size_t nf = resPtrs.size();
+  this->checkManySize("PsFFTW3::calcForwardFFTMany", data.size(), nf);
+  if (nf == 0) return;
+
+  forwardMany(data, nf, false);
+
+  for (size_t f=0; f<nf; ++f) {
+    FLOATTYPE* resPtr = resPtrs[f];
+    for (size_t n=0; n<localSpecSize; ++n)
+      resPtr[n] = batchData[2*(n*nf + f)];
+  }
+}
+
+/*
+ * *************************
+ * FFTW3 registered kernel calls
+ * *************************
+ */
+
+template <class FLOATTYPE, size_t NDIM>
+size_t PsFFTW3<FLOATTYPE, NDIM>::addKernel(const FLOATTYPE* kdata) {
+
+  this->dbprt("PsFFTW3::addKernel");
+
+  for (size_t n=0; n<localSize; ++n) {
+    cdata[2*n]   = kdata[n];
+    cdata[2*n+1] = 0.0;
+  }
+  execute(forwardPlan3);
+
+  // Kernel transform stays resident for convolutions
+  double* kspec = (double*) fftw_malloc(sizeof(fftw_complex)*localSpecSize);
+  for (size_t n=0; n<2*localSpecSize; ++n) kspec[n] = cdata[n];
+  kernelSpecs.push_back(kspec);
+
+  return kernelSpecs.size() - 1;
+}
+
+template <class FLOATTYPE, size_t NDIM>
+void PsFFTW3<FLOATTYPE, NDIM>::convolveKernel(const FLOATTYPE* data,
+    size_t kernel, FLOATTYPE* resPtr) {
+
+  this->dbprt("PsFFTW3::convolveKernel");
+
+  this->checkKernel("PsFFTW3::convolveKernel", kernel, kernelSpecs.size());
+  const double* kspec = kernelSpecs[kernel];
+
+  for (size_t n=0; n<localSize; ++n) {
+    cdata[2*n]   = data[n];
+    cdata[2*n+1] = 0.0;
+  }
+  execute(forwardPlan3);
+
+  // Multiply transforms
+  double re, im;
+  for (size_t n=0; n<localSpecSize; ++n) {
+    re = (cdata[2*n]*kspec[2*n]) - (cdata[2*n+1]*kspec[2*n+1]);
+    im = (cdata[2*n+1]*kspec[2*n]) + (cdata[2*n]*kspec[2*n+1]);
+    cdata[2*n]   = re;
+    cdata[2*n+1] = im;
+  }
+
+  execute(backwardPlan3);
+
+  for (size_t n=0; n<localSize; ++n)
+    resPtr[n] = cdata[2*n];
+}
+
+template <class FLOATTYPE, size_t NDIM>
+void PsFFTW3<FLOATTYPE, NDIM>::convolveKernelMany(
+    const std::vector<const FLOATTYPE*>& data,
+    const std::vector<size_t>& kernels,
+    const std::vector<FLOATTYPE*>& resPtrs) {
+
+  this->dbprt("PsFFTW3::convolveKernelMany");
+
+  size_t nf = resPtrs.size();
+  this->checkManySize("PsFFTW3::convolveKernelMany", data.size(), nf);
+  this->checkManySize("PsFFTW3::convolveKernelMany", kernels.size(), nf);
+  for (size_t f=0; f<kernels.size(); ++f) {
+    this->checkKernel("PsFFTW3::convolveKernelMany", kernels[f],
+        kernelSpecs.size());
+  }
+  if (nf == 0) return;
+
+  forwardMany(data, nf, false);
+
+  // Multiply transforms
+  double re, im;
+  for (size_t f=0; f<nf; ++f) {
+    const double* kspec =
+        kernelSpecs[kernels[this->manyIndex(kernels.size(), f)]];
+    for (size_t n=0; n<localSpecSize; ++n) {
+      double* b = &batchData[2*(n*nf + f)];
+      re = (b[0]*kspec[2*n]) - (b[1]*kspec[2*n+1]);
+      im = (b[1]*kspec[2*n]) + (b[0]*kspec[2*n+1]);
+      b[0] = re;
+      b[1] = im;
+    }
+  }
+
+  executeMany(backwardManyPlan3, batchData);
+
+  for (size_t f=0; f<nf; ++f) {
+    FLOATTYPE* resPtr = resPtrs[f];
+    for (size_t n=0; n<localSize; ++n)
+      resPtr[n] = batchData[2*(n*nf + f)];
+  }
+}
+
+/*
+ * *************************
+ * FFTW3 resident spectra calls
+ * *************************
+ */
+
+template <class FLOATTYPE, size_t NDIM>
+void PsFFTW3<FLOATTYPE, NDIM>::forwardSpectra(
+    const std::vector<const FLOATTYPE*>& data) {
+
+  this->dbprt("PsFFTW3::forwardSpectra");
+
+  size_t nf = data.size();
+  numSpectra = 0;
+  if (nf == 0) return;
+
+  setBatchPlans(nf);
+  if (specAlloc < batchAlloc) {
+    if (specData) fftw_free(specData);
+    specAlloc = batchAlloc;
+    specData = (double*) fftw_malloc(sizeof(fftw_complex)*specAlloc);
+  }
+
+  for (size_t f=0; f<nf; ++f) {
+    const FLOATTYPE* dataPtr = data[f];
+    for (size_t n=0; n<localSize; ++n) {
+      specData[2*(n*nf + f)]   = dataPtr[n];
+      specData[2*(n*nf + f)+1] = 0.0;
+    }
+  }
+
+  executeMany(forwardManyPlan3, specData);
+  numSpectra = nf;
+}
+
+template <class FLOATTYPE, size_t NDIM>
+void PsFFTW3<FLOATTYPE, NDIM>::getSpectrumAbs(size_t spec,
+    FLOATTYPE* resPtr) {
+
+  this->checkSpectrum("PsFFTW3::getSpectrumAbs", spec, numSpectra);
+
+  // Calculate absolute value
+  for (size_t n=0; n<localSpecSize; ++n) {
+    const double* c = &specData[2*(n*numSpectra + spec)];
+    resPtr[n] = (c[0]*c[0]) + (c[1]*c[1]);
+  }
+}
+
+template <class FLOATTYPE, size_t NDIM>
+void PsFFTW3<FLOATTYPE, NDIM>::scaleSpectrum(size_t spec,
+    const FLOATTYPE* kdata) {
+
+  this->checkSpectrum("PsFFTW3::scaleSpectrum", spec, numSpectra);
+
+  // Scale transform result by kdata (both Re/Im)
+  for (size_t n=0; n<localSpecSize; ++n) {
+    specData[2*(n*numSpectra + spec)]   *= kdata[n];
+    specData[2*(n*numSpectra + spec)+1] *= kdata[n];
+  }
+}
+
+template <class FLOATTYPE, size_t NDIM>
+void PsFFTW3<FLOATTYPE, NDIM>::backwardSpectra(
+    const std::vector<FLOATTYPE*>& resPtrs) {
+
+  this->dbprt("PsFFTW3::backwardSpectra");
+
+  size_t nf = numSpectra;
+  if (resPtrs.size() != nf) {
+    TxDebugExcept tde("PsFFTW3::backwardSpectra: ");
+    tde << resPtrs.size() << " results for " << nf;
+    tde << " spectra in <FFT " << this->getName() << " >";
+    throw tde;
+  }
+  if (nf == 0) return;
+
+  // Other batch sizes may have been selected in between
+  setBatchPlans(nf);
+  executeMany(backwardManyPlan3, specData);
+  numSpectra = 0;
+
+  for (size_t f=0; f<nf; ++f) {
+    FLOATTYPE* resPtr = resPtrs[f];
+    for (size_t n=0; n<localSize; ++n)
+      resPtr[n] = specData[2*(n*nf + f)];
+  }
+}
+
+//
+// Many-field plans use the same decomposition as the single-field
+// plans with the fields interleaved (stride nf, distance 1). Plans
+// are made before the data is loaded as FFTW_MEASURE and above
+// overwrite the arrays. Plans for each nf are kept, so callers
+// alternating batch sizes do not replan. Their wisdom is not
+// exported, see buildData.
+//
+template <class FLOATTYPE, size_t NDIM>
+void PsFFTW3<FLOATTYPE, NDIM>::setBatchPlans(size_t nf) {
+
+  if (nf == batchFields) return;
+
+  typename std::map<size_t, BatchPlan>::iterator it = batchPlans.find(nf);
+  if (it == batchPlans.end()) {
+
+    BatchPlan bp;
+    std::vector<size_t> dims = this->globalDims;
+    int rank = (int)dims.size();
+    int howmany = (int)nf;
+
+#ifdef HAVE_FFTW3_THREADS
+    fftw_plan_with_nthreads(numThreads);
+#endif
+    unsigned flags = plannerFlag();
+
+#ifdef HAVE_MPI
+
+    ptrdiff_t* planDims = new ptrdiff_t[rank];
+    for (int n=0; n<rank; ++n) planDims[n] = dims[n];
+
+    ptrdiff_t local_n0, local_0_start;
+    ptrdiff_t local_n1, local_1_start;
+    ptrdiff_t alloc_local;
+    if (transposeOrder) {
+      alloc_local = fftw_mpi_local_size_many_transposed(rank, planDims,
+          howmany, FFTW_MPI_DEFAULT_BLOCK, FFTW_MPI_DEFAULT_BLOCK,
+          this->getPlanComm(), &local_n0, &local_0_start,
+          &local_n1, &local_1_start);
+    }
+    else {
+      alloc_local = fftw_mpi_local_size_many(rank, planDims, howmany,
+          FFTW_MPI_DEFAULT_BLOCK, this->getPlanComm(),
+          &local_n0, &local_0_start);
+    }
+
+    bp.alloc = alloc_local;
+    bp.data = (double*) fftw_malloc(sizeof(fftw_complex)*bp.alloc);
+    bp.spec = (double*) fftw_malloc(sizeof(fftw_complex)*bp.alloc);
+    fftw_complex* buf = (fftw_complex*) bp.data;
+
+    unsigned fflags = flags;
+    unsigned bflags = flags;
+    if (transposeOrder) {
+      fflags |= FFTW_MPI_TRANSPOSED_OUT;
+      bflags |= FFTW_MPI_TRANSPOSED_IN;
+    }
+    bp.forward  = fftw_mpi_plan_many_dft(rank, planDims, howmany,
+        FFTW_MPI_DEFAULT_BLOCK, FFTW_MPI_DEFAULT_BLOCK, buf, buf,
+        this->getPlanComm(), FFTW_FORWARD, fflags);
+    bp.backward = fftw_mpi_plan_many_dft(rank, planDims, howmany,
+        FFTW_MPI_DEFAULT_BLOCK, FFTW_MPI_DEFAULT_BLOCK, buf, buf,
+        this->getPlanComm(), FFTW_BACKWARD, bflags);
+
+#else
+
+    int* planDims = new int[rank];
+    for (int n=0; n<rank; ++n) planDims[n] = dims[n];
+
+    bp.alloc = localSize*nf;
+    bp.data = (double*) fftw_malloc(sizeof(fftw_complex)*bp.alloc);
+    bp.spec = (double*) fftw_malloc(sizeof(fftw_complex)*bp.alloc);
+    fftw_complex* buf = (fftw_complex*) bp.data;
+
+    bp.forward  = fftw_plan_many_dft(rank, planDims, howmany,
+        buf, NULL, howmany, 1, buf, NULL, howmany, 1,
+        FFTW_FORWARD, flags);
+    bp.backward = fftw_plan_many_dft(rank, planDims, howmany,
+        buf, NULL, howmany, 1, buf, NULL, howmany, 1,
+        FFTW_BACKWARD, flags);
+
+#endif
+
+    // Explicitly free local memory
+    delete[] planDims;
+
+    if (!bp.forward || !bp.backward) {
+      if (bp.forward)  fftw_destroy_plan(bp.forward);
+      if (bp.backward) fftw_destroy_plan(bp.backward);
+      fftw_free(bp.data);
+      fftw_free(bp.spec);
+      TxDebugExcept tde("PsFFTW3::setBatchPlans: FFTW3 plan creation");
+      tde << " failed for " << howmany << " fields";
+      tde << " in <FFT " << this->getName() << " >";
+      throw tde;
+    }
+
+    this->dbprt("batch fields = ", howmany);
+    it = batchPlans.insert(std::make_pair(nf, bp)).first;
+  }
+
+  // The two buffers are interchangeable, convolveReMany swaps them
+  batchFields = nf;
+  batchData = it->second.data;
+  batchSpec = it->second.spec;
+  batchAlloc = it->second.alloc;
+  forwardManyPlan3  = it->second.forward;
+  backwardManyPlan3 = it->second.backward;
+}
+
+template <class FLOATTYPE, size_t NDIM>
+void PsFFTW3<FLOATTYPE, NDIM>::forwardMany(
+    const std::vector<const FLOATTYPE*>& data, size_t nf, bool imag) {
+
+  setBatchPlans(nf);
+
+  // One data set shared by all fields is only transformed once
+  if ( (data.size() == 1) && (nf > 1) ) {
+
+    const FLOATTYPE* dataPtr = data[0];
+    for (size_t n=0; n<localSize; ++n) {
+      cdata[2*n]   = imag ? 0.0 : dataPtr[n];
+      cdata[2*n+1] = imag ? dataPtr[n] : 0.0;
+    }
+    execute(forwardPlan3);
+
+    for (size_t n=0; n<localSpecSize; ++n) {
+      for (size_t f=0; f<nf; ++f) {
+        batchData[2*(n*nf + f)]   = cdata[2*n];
+        batchData[2*(n*nf + f)+1] = cdata[2*n+1];
+      }
+    }
+    return;
+  }
+
+  for (size_t f=0; f<nf; ++f) {
+    const FLOATTYPE* dataPtr = data[f];
+    for (size_t n=0; n<localSize; ++n) {
+      batchData[2*(n*nf + f)]   = imag ? 0.0 : dataPtr[n];
+      batchData[2*(n*nf + f)+1] = imag ? dataPtr[n] : 0.0;
+    }
+  }
+  executeMany(forwardManyPlan3, batchData);
+}
+
+template <class FLOATTYPE, size_t NDIM>
+void PsFFTW3<FLOATTYPE, NDIM>::backwardMany(
+    const std::vector<const FLOATTYPE*>& kdata,
+    const std::vector<FLOATTYPE*>& resPtrs) {
+
+  size_t nf = resPtrs.size();
+
+  // Scale transform results by kdata (both Re/Im)
+  for (size_t f=0; f<nf; ++f) {
+    const FLOATTYPE* kPtr = kdata[this->manyIndex(kdata.size(), f)];
+    for (size_t n=0; n<localSpecSize; ++n) {
+      batchData[2*(n*nf + f)]   *= kPtr[n];
+      batchData[2*(n*nf + f)+1] *= kPtr[n];
+    }
+  }
+
+  executeMany(backwardManyPlan3, batchData);
+
+  for (size_t f=0; f<nf; ++f) {
+    FLOATTYPE* resPtr = resPtrs[f];
+    for (size_t n=0; n<localSize; ++n)
+      resPtr[n] = batchData[2*(n*nf + f)];
+  }
+}
+
+//
+// batchData and batchSpec are swapped in convolutions and the
+// resident spectra have their own array, so the plan is applied
+// to the array passed in (all are fftw_malloc'd with batchAlloc)
+//
+template <class FLOATTYPE, size_t NDIM>
+void PsFFTW3<FLOATTYPE, NDIM>::executeMany(fftw_plan_s* plan,
+    double* data) {
+  fftw_complex* buf = (fftw_complex*) data;
+  fftw_execute_dft(plan, buf, buf);
+}
+
+template class PsFFTW3<float, 1>;
+template class PsFFTW3<float, 2>;
+template class PsFFTW3<float, 3>;
+
+template class PsFFTW3<double, 1>;
+template class PsFFTW3<double, 2>;
+template class PsFFTW3<double, 3>;
@@ -0,0 +1,479 @@
+/**
+ *
+ * @file    PsFFTW3.h
+ *
+ * @brief   Fourier transform using the FFTW3 interface
+ *
+ * @version $Id: PsFFTW3.h 8329 2007-09-21 16:12:04Z swsides $
+ *
+ * Copyright &copy; 2008-2020, Tech-X Corporation, Boulder, CO.
+ * All rights reserved.
+ */
+
+#ifndef PS_FFTW3_H
+#define PS_FFTW3_H
+
+// std includes
+#include <string>
+#include <vector>
+#include <map>
+
+// configure stuff
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+// psfft includes
+#include <PsFFT.h>
+
+//
+// The FFTW3 header is only included in the .cpp so users of this
+// class do not see the FFTW3 fftw_complex. FFTW2 is not linked in
+// FFTW3 builds (see ENABLE_FFTW3), the plan handle is opaque.
+//
+struct fftw_plan_s;
+
+/**
+ * Fastest Fourier-transform in the West interface class for the
+ * FFTW3 library. Serial, threaded and MPI transforms are available.
+ * The planner effort is set in the input file and the plans can be
+ * saved/loaded with FFTW wisdom so expensive plans are only made once.
+ *
+ * With MPI and transposeOrder = on the spectrum is left in the
+ * transposed (y-slab) order used by the transposefftw objects, so
+ * this object should be built on the transpose grid. If not set,
+ * transposeOrder follows the decomp of the grid (transposeFlag).
+ * FFTW3 builds make these objects for the FFTW2 kinds as well.
+ */
+template <class FLOATTYPE, size_t NDIM>
+class PsFFTW3 : public virtual PsFFT<FLOATTYPE, NDIM> {
+
+ public:
+
+/**
+ * constructor
+ */
+  PsFFTW3();
+
+/**
+ * Destructor
+ */
+  virtual ~PsFFTW3();
+
+/**
+ * Store the data needed to build this object.
+ *
+ * @param tas the attribute set containing
+ *            the initial conditions
+ */
+    virtual void setAttrib(const TxHierAttribSetIntDbl& tas);
+
+/**
+ * Build the data for this object
+ */
+    virtual void buildData();
+
+/**
+ * Build the solvers for this object
+ */
+    virtual void buildSolvers();
+
+/**
+ * Get size of data transform
+ */
+   virtual size_t getFFTSize() {
+     return localSize;
+   }
+
+/**
+ * Get number of local k-space elements
+ */
+   virtual size_t getSpecSize() {
+     return localSpecSize;
+   }
+
+/**
+ * Spectrum is in transposed order with MPI and transposeOrder on
+ */
+   virtual bool isTransposedOrder() {
+#ifdef HAVE_MPI
+     return transposeOrder;
+#else
+     return false;
+#endif
+   }
+
+/**
+ * Forward transform real input data and
+ * return |a+bi| elementwise
+ *
+ * @param data1  pointer to REAL data to transform
+ * @param resPtr pointer to Re[result] (also supplied by caller)
+ */
+   virtual void forwardFFTAbs(const FLOATTYPE* data1,
+       FLOATTYPE* resPtr);
+
+/**
+ * Forward transform real input data, multiply elementwise
+ * and backward transform
+ *
+ * @param data1  pointer to REAL data to transform
+ * @param data2  pointer to REAL to scale transform
+ * @param resPtr pointer to Re[result] (also supplied by caller)
+ */
+   virtual void convolveRe(const FLOATTYPE* data1,
+       const FLOATTYPE* data2, FLOATTYPE* resPtr);
+
+/**
+ * Perform multi-dimensional FFT pair, scaling the
+ * result by kdata in-between transform pair
+ *
+ * @param data  pointer to REAL data to transform
+ * @param kdata pointer to data to scale transform
+ * @param resPtr pointer to Re[result] (also supplied by caller)
+ */
+   virtual void scaledFFTPair(const FLOATTYPE* data,
+       const FLOATTYPE* kdata, FLOATTYPE* resPtr);
+
+/**
+ * Perform multi-dimensional FFT pair on two REAL data sets packed
+ * into the Re/Im parts of one complex transform
+ *
+ * @param data1   pointer to first REAL data to transform
+ * @param data2   pointer to second REAL data to transform
+ * @param kdata   pointer to real, even data to scale transform
+ * @param resPtr1 pointer to first Re[result] (also supplied by caller)
+ * @param resPtr2 pointer to second Re[result] (also supplied by caller)
+ */
+   virtual void scaledFFTPairTwo(const FLOATTYPE* data1,
+       const FLOATTYPE* data2, const FLOATTYPE* kdata,
+       FLOATTYPE* resPtr1, FLOATTYPE* resPtr2);
+
+/**
+ * MPI transforms are collective and have no workspaces,
+ * serial transforms do
+ */
+   virtual bool hasWorkspaces() {
+#ifdef HAVE_MPI
+     return false;
+#else
+     return true;
+#endif
+   }
+
+/**
+ * Add a buffer on the shared plans for one concurrent caller
+ *
+ * @return index of workspace
+ */
+   virtual size_t addWorkspace();
+
+/**
+ * Perform scaledFFTPair in a workspace from addWorkspace
+ *
+ * @param ws     index of workspace
+ * @param data   pointer to REAL data to transform
+ * @param kdata  pointer to data to scale transform
+ * @param resPtr pointer to Re[result] (also supplied by caller)
+ */
+   virtual void scaledFFTPairWs(size_t ws, const FLOATTYPE* data,
+       const FLOATTYPE* kdata, FLOATTYPE* resPtr);
+
+/**
+ * Perform scaledFFTPairTwo in a workspace from addWorkspace
+ *
+ * @param ws      index of workspace
+ * @param data1   pointer to first REAL data to transform
+ * @param data2   pointer to second REAL data to transform
+ * @param kdata   pointer to real, even data to scale transform
+ * @param resPtr1 pointer to first Re[result] (also supplied by caller)
+ * @param resPtr2 pointer to second Re[result] (also supplied by caller)
+ */
+   virtual void scaledFFTPairTwoWs(size_t ws, const FLOATTYPE* data1,
+       const FLOATTYPE* data2, const FLOATTYPE* kdata,
+       FLOATTYPE* resPtr1, FLOATTYPE* resPtr2);
+
+/**
+ * Perform crossSpectrumRe in a workspace from addWorkspace
+ *
+ * @param ws     index of workspace
+ * @param data1  pointer to first REAL data to transform
+ * @param data2  pointer to second REAL data to transform
+ * @param resPtr pointer to result in k-space (also supplied by caller)
+ */
+   virtual void crossSpectrumReWs(size_t ws, const FLOATTYPE* data1,
+       const FLOATTYPE* data2, FLOATTYPE* resPtr);
+
+/**
+ * Perform multi-dimensional FFT pair, scaling the
+ * result by kdata in-between transform pair
+ *
+ * @param data  pointer to IMAGINARY data to transform
+ * @param kdata pointer to data to scale transform
+ * @param resPtr pointer to Re[result] (also supplied by caller)
+ */
+   virtual void scaledFFTPairIm(const FLOATTYPE* data,
+       const FLOATTYPE* kdata, FLOATTYPE* resPtr);
+
+/**
+ * Perform forward multi-dimensional FFT:
+ *
+ * @param data pointer to REAL data to transform
+ * @param resPtr pointer to Re[result] (also supplied by caller)
+ */
+   virtual void calcForwardFFT(const FLOATTYPE* data,
+       FLOATTYPE* resPtr);
+
+/**
+ * Perform backward (inverse) multi-dimensional FFT:
+ *
+ * @param data pointer to REAL data to transform
+ * @param resPtr pointer to Re[result] (also supplied by caller)
+ */
+   virtual void calcBackwardFFT(const FLOATTYPE* data,
+       FLOATTYPE* resPtr);
+
+/**
+ * Perform multi-dimensional FFT pairs on several REAL data sets
+ * with one many-field plan each way
+ *
+ * @param data    pointers to REAL data to transform
+ * @param kdata   pointers to data to scale transforms
+ * @param resPtrs pointers to Re[result] (also supplied by caller)
+ */
+   virtual void scaledFFTPairMany(const std::vector<const FLOATTYPE*>& data,
+       const std::vector<const FLOATTYPE*>& kdata,
+       const std::vector<FLOATTYPE*>& resPtrs);
+
+/**
+ * Perform multi-dimensional FFT pairs on several IMAGINARY data sets
+ * with one many-field plan each way
+ *
+ * @param data    pointers to IMAGINARY data to transform
+ * @param kdata   pointers to data to scale transforms
+ * @param resPtrs pointers to Re[result] (also supplied by caller)
+ */
+   virtual void scaledFFTPairImMany(const std::vector<const FLOATTYPE*>& data,
+       const std::vector<const FLOATTYPE*>& kdata,
+       const std::vector<FLOATTYPE*>& resPtrs);
+
+/**
+ * Convolve several pairs of REAL data sets with many-field plans
+ *
+ * @param data1   pointers to REAL data to transform
+ * @param data2   pointers to REAL data to scale transforms
+ * @param resPtrs pointers to Re[result] (also supplied by caller)
+ */
+   virtual void convolveReMany(const std::vector<const FLOATTYPE*>& data1,
+       const std::vector<const FLOATTYPE*>& data2,
+       const std::vector<FLOATTYPE*>& resPtrs);
+
+/**
+ * Perform forward multi-dimensional FFT on several REAL data sets
+ * with one many-field plan
+ *
+ * @param data    pointers to REAL data to transform
+ * @param resPtrs pointers to Re[result] (also supplied by caller)
+ */
+   virtual void calcForwardFFTMany(const std::vector<const FLOATTYPE*>& data,
+       const std::vector<FLOATTYPE*>& resPtrs);
+
+/**
+ * Register a REAL kernel, its transform is kept for convolveKernel
+ *
+ * @param kdata pointer to REAL kernel data
+ * @return index of kernel for convolveKernel calls
+ */
+   virtual size_t addKernel(const FLOATTYPE* kdata);
+
+/**
+ * Convolve REAL data with a registered kernel, one transform
+ * each way
+ *
+ * @param data   pointer to REAL data to transform
+ * @param kernel index of kernel from addKernel
+ * @param resPtr pointer to Re[result] (also supplied by caller)
+ */
+   virtual void convolveKernel(const FLOATTYPE* data, size_t kernel,
+       FLOATTYPE* resPtr);
+
+/**
+ * Convolve REAL data sets with registered kernels, one
+ * many-field plan each way
+ *
+ * @param data    pointers to REAL data to transform
+ * @param kernels indices of kernels from addKernel
+ * @param resPtrs pointers to Re[result] (also supplied by caller)
+ */
+   virtual void convolveKernelMany(const std::vector<const FLOATTYPE*>& data,
+       const std::vector<size_t>& kernels,
+       const std::vector<FLOATTYPE*>& resPtrs);
+
+/**
+ * Forward transform REAL data sets with one many-field plan
+ * and keep the spectra resident
+ *
+ * @param data pointers to REAL data to transform
+ */
+   virtual void forwardSpectra(const std::vector<const FLOATTYPE*>& data);
+
+/**
+ * Get |a+bi| elementwise of a resident spectrum
+ *
+ * @param spec   index of spectrum from forwardSpectra
+ * @param resPtr pointer to result in k-space (also supplied by caller)
+ */
+   virtual void getSpectrumAbs(size_t spec, FLOATTYPE* resPtr);
+
+/**
+ * Scale a resident spectrum elementwise (both Re/Im)
+ *
+ * @param spec  index of spectrum from forwardSpectra
+ * @param kdata pointer to data to scale spectrum
+ */
+   virtual void scaleSpectrum(size_t spec, const FLOATTYPE* kdata);
+
+/**
+ * Backward transform all resident spectra with one many-field plan
+ *
+ * @param resPtrs pointers to Re[result], one per spectrum
+ */
+   virtual void backwardSpectra(const std::vector<FLOATTYPE*>& resPtrs);
+
+ protected:
+
+   /**
+    * Internal data structure, interleaved Re/Im pairs
+    * (layout of fftw_complex in FFTW3), transforms are in-place
+    */
+   double* cdata;
+
+   /** Second internal data structure for convolutions */
+   double* cdata2;
+
+   /** Number of local elements in data */
+   size_t localSize;
+
+   /** Number of local elements in k-space */
+   size_t localSpecSize;
+
+ private:
+
+   /** FFTW planner flag from plannerEffort string */
+   unsigned plannerFlag();
+
+   /** Load wisdom file (if set) before planning */
+   void importWisdom();
+
+   /** Save accumulated wisdom (if set) after planning */
+   void exportWisdom();
+
+   /** Execute plan in-place on cdata */
+   void execute(fftw_plan_s* plan);
+
+   /**
+    * Scaled FFT pair in-place on buf (cdata or a workspace), data2
+    * and resPtr2 (if not NULL) are the Im parts
+    */
+   void scaledPair(const FLOATTYPE* data1, const FLOATTYPE* data2,
+       const FLOATTYPE* kdata, FLOATTYPE* resPtr1, FLOATTYPE* resPtr2,
+       double* buf);
+
+   /** Buffers of workspaces from addWorkspace (Re/Im pairs) */
+   std::vector<double*> wsData;
+
+   /**
+    * Select the interleaved batch data and many-field plans for nf
+    * fields, made on the first request for nf and kept for reuse
+    */
+   void setBatchPlans(size_t nf);
+
+   /**
+    * Load REAL (or IMAGINARY) data sets and forward transform into
+    * batchData. A single data set is transformed once and copied to
+    * all nf fields.
+    */
+   void forwardMany(const std::vector<const FLOATTYPE*>& data, size_t nf,
+       bool imag);
+
+   /** Scale batchData by kdata, backward transform and unload Re */
+   void backwardMany(const std::vector<const FLOATTYPE*>& kdata,
+       const std::vector<FLOATTYPE*>& resPtrs);
+
+   /** Execute many-field plan in-place on interleaved data */
+   void executeMany(fftw_plan_s* plan, double* data);
+
+   /** Planner effort: estimate, measure, patient, exhaustive */
+   std::string plannerEffort;
+
+   /** Name of FFTW wisdom file, not used if empty */
+   std::string wisdomFile;
+
+   /** Number of threads for each transform */
+   int numThreads;
+
+   /** Flag for transposed k-space order with MPI */
+   bool transposeOrder;
+
+   /** Flag for transposeOrder given in input, else set from decomp */
+   bool transposeOrderSet;
+
+   /** FFTW plan for forward transforms */
+   fftw_plan_s* forwardPlan3;
+
+   /** FFTW plan for backward transforms */
+   fftw_plan_s* backwardPlan3;
+
+   /** Many-field plans and buffers for one number of fields */
+   struct BatchPlan {
+     double* data;
+     double* spec;
+     size_t alloc;
+     fftw_plan_s* forward;
+     fftw_plan_s* backward;
+   };
+
+   /** Batch plans by number of fields, owned here */
+   std::map<size_t, BatchPlan> batchPlans;
+
+   /**
+    * Interleaved data for batch transforms, element n of
+    * field f is the Re/Im pair at 2*(n*batchFields + f)
+    */
+   double* batchData;
+
+   /** Interleaved transforms kept during batch convolutions */
+   double* batchSpec;
+
+   /** Number of fields in selected batch plans */
+   size_t batchFields;
+
+   /** Number of complex elements allocated for batch data */
+   size_t batchAlloc;
+
+   /** Selected FFTW many-field plan for forward transforms */
+   fftw_plan_s* forwardManyPlan3;
+
+   /** Selected FFTW many-field plan for backward transforms */
+   fftw_plan_s* backwardManyPlan3;
+
+   /** Transforms of kernels registered by addKernel (Re/Im pairs) */
+   std::vector<double*> kernelSpecs;
+
+   /** Interleaved resident spectra from forwardSpectra */
+   double* specData;
+
+   /** Number of complex elements allocated for specData */
+   size_t specAlloc;
+
+   /** Number of resident spectra */
+   size_t numSpectra;
+
+   /** Make private to prevent use */
+   PsFFTW3(const PsFFTW3<FLOATTYPE, NDIM>& psf);
+
+   /** Make private to prevent use */
+   PsFFTW3<FLOATTYPE, NDIM>& operator=(const PsFFTW3<FLOATTYPE, NDIM>& psf);
+};
+
+#endif // PS_FFTW3_H
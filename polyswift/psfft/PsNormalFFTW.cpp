@@ -63,10 +63,10 @@ void PsNormalFFTW<FLOATTYPE, NDIM>::buildData() {
   int* planDims = new int[rank];
   for (int n=0; n<rank; ++n) planDims[n] = dims[n];
 
-  forwardNPlan = fftwnd_mpi_create_plan(MPI_COMM_WORLD,
+  forwardNPlan = fftwnd_mpi_create_plan(this->getPlanComm(),
       rank, planDims, FFTW_FORWARD, FFTW_ESTIMATE);
 
-  backwardNPlan = fftwnd_mpi_create_plan(MPI_COMM_WORLD,
+  backwardNPlan = fftwnd_mpi_create_plan(this->getPlanComm(),
       rank, planDims, FFTW_BACKWARD, FFTW_ESTIMATE);
   // Explicitly free local memory
   delete[] planDims;
@@ -155,8 +155,8 @@ template <class FLOATTYPE, size_t NDIM>
 void PsNormalFFTW<FLOATTYPE, NDIM>::convolveRe(
     const FLOATTYPE* data1, const FLOATTYPE* data2, FLOATTYPE* resPtr){
 
-  // Local space... must be managed by this method
-  fftw_complex* in2 = new fftw_complex[this->total_local_size];
+  // Second transform held in "out" (unused by in-place MPI calls)
+  fftw_complex* in2 = this->out;
   fftw_complex tmp;
 
   this->dbprt("PsNormalFFTW::convolveRe MPI called");
@@ -187,8 +187,6 @@ void PsNormalFFTW<FLOATTYPE, NDIM>::convolveRe(
   // Format data for output
   for (int n=0; n<this->total_local_size; ++n)
     resPtr[n] = this->in[n].re;
-
-  delete[] in2;
 }
 
 //
@@ -226,6 +224,43 @@ void PsNormalFFTW<FLOATTYPE, NDIM>::scaledFFTPair(
 
 }
 
+//
+// Two real data sets packed as Re/Im of one complex transform.
+// kdata is real and even so F^-1[k*F[a+ib]] = (k*a) + i(k*b)
+//
+template <class FLOATTYPE, size_t NDIM>
+void PsNormalFFTW<FLOATTYPE, NDIM>::scaledFFTPairTwo(
+    const FLOATTYPE* data1, const FLOATTYPE* data2,
+    const FLOATTYPE* kdata, FLOATTYPE* resPtr1, FLOATTYPE* resPtr2){
+
+  this->dbprt("PsNormalFFTW::scaledFFTPairTwo MPI ");
+
+  // Format data for fft_complex data type
+  for (int n=0; n<this->total_local_size; ++n) {
+    this->in[n].re = data1[n];
+    this->in[n].im = data2[n];
+  }
+
+  // FFT returned in-place to the "in" arrary
+  fftwnd_mpi(forwardNPlan, this->n_fields, this->in, this->work, FFTW_NORMAL_ORDER);
+
+  // Scale transform result by kdata
+  for (int n=0; n<this->total_local_size; ++n) {
+    this->in[n].re = this->in[n].re * kdata[n];
+    this->in[n].im = this->in[n].im * kdata[n];
+  }
+
+  // FFT returned in-place to the "in" arrary
+  fftwnd_mpi(backwardNPlan, this->n_fields, this->in, this->work, FFTW_NORMAL_ORDER);
+
+  // Format data for output
+  for (int n=0; n<this->total_local_size; ++n) {
+    resPtr1[n] = this->in[n].re;
+    resPtr2[n] = this->in[n].im;
+  }
+
+}
+
 template <class FLOATTYPE, size_t NDIM>
 void PsNormalFFTW<FLOATTYPE, NDIM>::scaledFFTPairIm(
     const FLOATTYPE* data, const FLOATTYPE* kdata, FLOATTYPE* resPtr){
@@ -304,6 +339,19 @@ void PsNormalFFTW<FLOATTYPE, NDIM>::calcBackwardFFT(const FLOATTYPE* data,
   }
 
 }
+
+//
+// Batch transforms use the n_fields interleaved layout of fftwnd_mpi
+//
+template <class FLOATTYPE, size_t NDIM>
+void PsNormalFFTW<FLOATTYPE, NDIM>::transformMany(DirType dir, int nf,
+    fftw_complex* data) {
+
+  planTypeNormal fftPlan = (dir == FORWARD) ? forwardNPlan : backwardNPlan;
+
+  // FFT returned in-place to the "data" array
+  fftwnd_mpi(fftPlan, nf, data, this->batchWork, FFTW_NORMAL_ORDER);
+}
 #endif // HAVE_MPI
 
 #ifndef HAVE_MPI
@@ -342,6 +390,16 @@ void PsNormalFFTW<FLOATTYPE, NDIM>::scaledFFTPair(
   PsFFTW<FLOATTYPE, NDIM>::scaledFFTPair(data, kdata, resPtr);
 }
 
+template <class FLOATTYPE, size_t NDIM>
+void PsNormalFFTW<FLOATTYPE, NDIM>::scaledFFTPairTwo(
+    const FLOATTYPE* data1, const FLOATTYPE* data2,
+    const FLOATTYPE* kdata, FLOATTYPE* resPtr1, FLOATTYPE* resPtr2){
+
+  // Scoping call for common serial methods
+  PsFFTW<FLOATTYPE, NDIM>::scaledFFTPairTwo(data1, data2, kdata,
+      resPtr1, resPtr2);
+}
+
 template <class FLOATTYPE, size_t NDIM>
 void PsNormalFFTW<FLOATTYPE, NDIM>::scaledFFTPairIm(
     const FLOATTYPE* data, const FLOATTYPE* kdata, FLOATTYPE* resPtr){
@@ -366,6 +424,14 @@ void PsNormalFFTW<FLOATTYPE, NDIM>::calcBackwardFFT(const FLOATTYPE* data,
   PsFFTW<FLOATTYPE, NDIM>::calcBackwardFFT(data, resPtr);
 }
 
+template <class FLOATTYPE, size_t NDIM>
+void PsNormalFFTW<FLOATTYPE, NDIM>::transformMany(DirType dir, int nf,
+    fftw_complex* data) {
+
+  // Scoping call for common serial methods
+  PsFFTW<FLOATTYPE, NDIM>::transformMany(dir, nf, data);
+}
+
 #endif // SERIAL
 
 template class PsNormalFFTW<float, 1>;
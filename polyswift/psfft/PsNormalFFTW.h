@@ -71,6 +71,18 @@ class PsNormalFFTW : public virtual PsFFTW<FLOATTYPE, NDIM> {
  */
     virtual void buildSolvers();
 
+/**
+ * The fftwnd_mpi transforms are collective and have no
+ * workspaces, serial transforms do
+ */
+   virtual bool hasWorkspaces() {
+#ifdef HAVE_MPI
+     return false;
+#else
+     return true;
+#endif
+   }
+
 /**
  * Forward transform real input data and return |a+bi| elementwise
  *
@@ -102,6 +114,20 @@ class PsNormalFFTW : public virtual PsFFTW<FLOATTYPE, NDIM> {
    virtual void scaledFFTPair(const FLOATTYPE* data,
        const FLOATTYPE* kdata, FLOATTYPE* resPtr);
 
+/**
+ * Perform multi-dimensional FFT pair on two REAL data sets packed
+ * into the Re/Im parts of one complex transform
+ *
+ * @param data1   pointer to first REAL data to transform
+ * @param data2   pointer to second REAL data to transform
+ * @param kdata   pointer to real, even data to scale transform
+ * @param resPtr1 pointer to first Re[result] (also supplied by caller)
+ * @param resPtr2 pointer to second Re[result] (also supplied by caller)
+ */
+   virtual void scaledFFTPairTwo(const FLOATTYPE* data1,
+       const FLOATTYPE* data2, const FLOATTYPE* kdata,
+       FLOATTYPE* resPtr1, FLOATTYPE* resPtr2);
+
 /**
  * Perform multi-dimensional FFT pair, scaling the
  * result by kdata in-between transform pair
@@ -133,6 +159,16 @@ class PsNormalFFTW : public virtual PsFFTW<FLOATTYPE, NDIM> {
 
  protected:
 
+/**
+ * Transform nf interleaved fields in-place with one
+ * many-field (n_fields) transform
+ *
+ * @param dir  direction of transform
+ * @param nf   number of fields
+ * @param data pointer to interleaved data
+ */
+   virtual void transformMany(DirType dir, int nf, fftw_complex* data);
+
  private:
 
    /** FFTW plan for forward transforms */
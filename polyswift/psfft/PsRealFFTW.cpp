@@ -0,0 +1,410 @@
+/**
+ *
+ * @file    PsRealFFTW.cpp
+ *
+ * @brief   Real-to-complex Fourier transform using FFTW
+ *
+ * @version $Id: PsRealFFTW.cpp 6319 2006-11-14 22:39:46Z swsides $
+ *
+ * Copyright &copy; 2008-2020, Tech-X Corporation, Boulder, CO.
+ * All rights reserved.
+ */
+
+#ifdef HAVE_MPI
+#define MPICH_IGNORE_CXX_SEEK
+#include <mpi.h>
+#include <rfftw_mpi.h>
+#else
+#include <rfftw.h>
+#endif
+
+// psfft includes
+#include <PsRealFFTW.h>
+
+#if defined(HAVE_FFTW_THREADS) && !defined(HAVE_MPI)
+#include <rfftw_threads.h>
+
+//
+// Library level setup is done once for all threaded RFFTW objects
+//
+static bool rfftwThreadsInitialized = false;
+
+static void initRFFTWThreads() {
+  if (rfftwThreadsInitialized) return;
+  fftw_threads_init();
+  rfftwThreadsInitialized = true;
+}
+#endif
+
+template <class FLOATTYPE, size_t NDIM>
+PsRealFFTW<FLOATTYPE, NDIM>::PsRealFFTW() {
+
+  // Number of data sets to transform
+  n_fields = 1;
+
+  // Threads per serial transform
+  numThreads = 1;
+
+  // Sizes set in buildData
+  local_real_size = 1;
+  local_spec_size = 1;
+  nLast = 1;
+  nLastPad = 1;
+
+  // Set pointers
+  rdata = NULL;
+  cdata = NULL;
+  work  = NULL;
+}
+
+template <class FLOATTYPE, size_t NDIM>
+PsRealFFTW<FLOATTYPE, NDIM>::~PsRealFFTW() {
+
+#ifdef HAVE_MPI
+  // cdata is in-place view of rdata
+  delete[] rdata;
+  delete[] work;
+  rfftwnd_mpi_destroy_plan(forwardRPlan);
+  rfftwnd_mpi_destroy_plan(backwardRPlan);
+#else
+  delete[] rdata;
+  delete[] cdata;
+  rfftwnd_destroy_plan(forwardRPlan);
+  rfftwnd_destroy_plan(backwardRPlan);
+#endif
+}
+
+template <class FLOATTYPE, size_t NDIM>
+void PsRealFFTW<FLOATTYPE, NDIM>::setAttrib(const TxHierAttribSetIntDbl& tas) {
+
+  // Scoping call to base class
+  PsFFT<FLOATTYPE, NDIM>::setAttrib(tas);
+
+  this->dbprt("PsRealFFTW::setAttrib() ");
+
+  // Threads per transform, rfftwnd_mpi is not threaded
+  if (tas.hasParam("numThreads")) {
+    numThreads = (int)tas.getParam("numThreads");
+    if (numThreads < 1) numThreads = 1;
+#if defined(HAVE_MPI) || !defined(HAVE_FFTW_THREADS)
+    if (numThreads > 1) {
+      TxDebugExcept tde("PsRealFFTW::setAttrib: numThreads > 1 ");
+#ifdef HAVE_MPI
+      tde << "not supported by FFTW2 MPI transforms, threads with MPI";
+      tde << " need a build with ENABLE_FFTW3";
+#else
+      tde << "but FFTW threads library not found";
+#endif
+      tde << " in <FFT " << this->getName() << " >";
+      throw tde;
+    }
+#endif
+  }
+}
+
+template <class FLOATTYPE, size_t NDIM>
+void PsRealFFTW<FLOATTYPE, NDIM>::buildData() {
+
+  // Scoping call to base class
+  PsFFT<FLOATTYPE, NDIM>::buildData();
+
+  this->dbprt("PsRealFFTW::buildData() ");
+
+  // *************************************************
+  // Set rank/dimensions for plans
+  // *************************************************
+  std::vector<size_t> dims;
+  dims = this->globalDims;
+  int rank = (int)dims.size();
+
+  int* planDims = new int[rank];
+  for (int n=0; n<rank; ++n) planDims[n] = dims[n];
+
+  // Last dimension is cut in half in k-space
+  nLast = planDims[rank-1];
+  int nLastSpec = nLast/2 + 1;
+
+#ifdef HAVE_MPI
+
+  // Backward plan takes the same dimensions as forward, the
+  // transposed order is handled internally for real transforms
+  forwardRPlan = rfftwnd_mpi_create_plan(this->getPlanComm(),
+      rank, planDims, FFTW_REAL_TO_COMPLEX, FFTW_ESTIMATE);
+  backwardRPlan = rfftwnd_mpi_create_plan(this->getPlanComm(),
+      rank, planDims, FFTW_COMPLEX_TO_REAL, FFTW_ESTIMATE);
+
+  // Local sizes, decomp sets everything else
+  int local_nx;
+  int local_x_start = 0;
+  int local_ny_after_transpose;
+  int local_y_start_after_transpose = 0;
+  int total_size = 0;
+
+  rfftwnd_mpi_local_sizes(forwardRPlan, &local_nx, &local_x_start,
+      &local_ny_after_transpose, &local_y_start_after_transpose,
+      &total_size);
+
+  // In-place transform needs padding in last dimension
+  nLastPad = 2*nLastSpec;
+
+  // Real data is slab in first dimension
+  local_real_size = local_nx;
+  for (int n=1; n<rank; ++n) local_real_size *= planDims[n];
+
+  // Spectrum is slab in second dimension (transposed order)
+  local_spec_size = local_ny_after_transpose*planDims[0];
+  for (int n=2; n<rank; ++n) {
+    if (n == rank-1) local_spec_size *= nLastSpec;
+    else             local_spec_size *= planDims[n];
+  }
+
+  // Setup internal work spaces, spectrum is in-place
+  rdata = new fftw_real[total_size];
+  work  = new fftw_real[total_size];
+  cdata = (fftw_complex*) rdata;
+
+#else
+
+#ifdef HAVE_FFTW_THREADS
+  if (numThreads > 1) initRFFTWThreads();
+#endif
+
+  forwardRPlan  = rfftwnd_create_plan(rank, planDims,
+      FFTW_REAL_TO_COMPLEX, FFTW_ESTIMATE);
+  backwardRPlan = rfftwnd_create_plan(rank, planDims,
+      FFTW_COMPLEX_TO_REAL, FFTW_ESTIMATE);
+
+  // Out-of-place transform, no padding
+  nLastPad = nLast;
+
+  local_real_size = 1;
+  for (int n=0; n<rank; ++n) local_real_size *= planDims[n];
+  local_spec_size = (local_real_size/nLast)*nLastSpec;
+
+  // Setup internal work spaces
+  rdata = new fftw_real[local_real_size];
+  cdata = new fftw_complex[local_spec_size];
+
+#endif
+
+  // Explicitly free local memory
+  delete[] planDims;
+
+  this->dbprt("local_real_size = ", local_real_size);
+  this->dbprt("local_spec_size = ", local_spec_size);
+}
+
+template <class FLOATTYPE, size_t NDIM>
+void PsRealFFTW<FLOATTYPE, NDIM>::buildSolvers() {
+
+  // Scoping call to base class
+  PsFFT<FLOATTYPE, NDIM>::buildSolvers();
+}
+
+//
+// Local helpers for padded layout and plan execution
+//
+template <class FLOATTYPE, size_t NDIM>
+void PsRealFFTW<FLOATTYPE, NDIM>::packReal(const FLOATTYPE* data) {
+
+  size_t nrows = local_real_size/nLast;
+  for (size_t r=0; r<nrows; ++r) {
+    fftw_real* rrow = rdata + r*nLastPad;
+    const FLOATTYPE* drow = data + r*nLast;
+    for (int k=0; k<nLast; ++k) rrow[k] = drow[k];
+  }
+}
+
+template <class FLOATTYPE, size_t NDIM>
+void PsRealFFTW<FLOATTYPE, NDIM>::unpackReal(FLOATTYPE* resPtr) {
+
+  size_t nrows = local_real_size/nLast;
+  for (size_t r=0; r<nrows; ++r) {
+    const fftw_real* rrow = rdata + r*nLastPad;
+    FLOATTYPE* drow = resPtr + r*nLast;
+    for (int k=0; k<nLast; ++k) drow[k] = rrow[k];
+  }
+}
+
+template <class FLOATTYPE, size_t NDIM>
+void PsRealFFTW<FLOATTYPE, NDIM>::forwardRealFFT() {
+#ifdef HAVE_MPI
+  rfftwnd_mpi(forwardRPlan, n_fields, rdata, work, FFTW_TRANSPOSED_ORDER);
+#elif defined(HAVE_FFTW_THREADS)
+  if (numThreads > 1) {
+    rfftwnd_threads_one_real_to_complex(numThreads, forwardRPlan,
+        rdata, cdata);
+  }
+  else {
+    rfftwnd_one_real_to_complex(forwardRPlan, rdata, cdata);
+  }
+#else
+  rfftwnd_one_real_to_complex(forwardRPlan, rdata, cdata);
+#endif
+}
+
+template <class FLOATTYPE, size_t NDIM>
+void PsRealFFTW<FLOATTYPE, NDIM>::backwardRealFFT() {
+#ifdef HAVE_MPI
+  rfftwnd_mpi(backwardRPlan, n_fields, rdata, work, FFTW_TRANSPOSED_ORDER);
+#elif defined(HAVE_FFTW_THREADS)
+  if (numThreads > 1) {
+    rfftwnd_threads_one_complex_to_real(numThreads, backwardRPlan,
+        cdata, rdata);
+  }
+  else {
+    rfftwnd_one_complex_to_real(backwardRPlan, cdata, rdata);
+  }
+#else
+  rfftwnd_one_complex_to_real(backwardRPlan, cdata, rdata);
+#endif
+}
+
+/*
+ * *************************
+ * FFTW calls
+ * *************************
+ */
+
+template <class FLOATTYPE, size_t NDIM>
+void PsRealFFTW<FLOATTYPE, NDIM>::forwardFFTAbs(
+    const FLOATTYPE* data1, FLOATTYPE* resPtr) {
+
+  TxDebugExcept tde("PsRealFFTW::forwardFFTAbs");
+  tde << " full spectrum not available for half-spectrum transform";
+  tde << " in <FFT " << this->getName() << " >";
+  throw tde;
+}
+
+template <class FLOATTYPE, size_t NDIM>
+void PsRealFFTW<FLOATTYPE, NDIM>::crossSpectrumRe(
+    const FLOATTYPE* data1, const FLOATTYPE* data2, FLOATTYPE* resPtr){
+
+  this->dbprt("PsRealFFTW::crossSpectrumRe");
+
+  // Local space... must be managed by this method
+  fftw_complex* spec1 = new fftw_complex[local_spec_size];
+
+  // Transform data1 and hold spectrum
+  packReal(data1);
+  forwardRealFFT();
+  for (int n=0; n<local_spec_size; ++n) spec1[n] = cdata[n];
+
+  // Transform data2
+  packReal(data2);
+  forwardRealFFT();
+
+  for (int n=0; n<local_spec_size; ++n)
+    resPtr[n] = (spec1[n].re * cdata[n].re) + (spec1[n].im * cdata[n].im);
+
+  delete[] spec1;
+}
+
+template <class FLOATTYPE, size_t NDIM>
+void PsRealFFTW<FLOATTYPE, NDIM>::convolveRe(
+    const FLOATTYPE* data1, const FLOATTYPE* data2, FLOATTYPE* resPtr){
+
+  this->dbprt("PsRealFFTW::convolveRe");
+
+  // Local space... must be managed by this method
+  fftw_complex* spec2 = new fftw_complex[local_spec_size];
+
+  // Transform data2 and hold spectrum
+  packReal(data2);
+  forwardRealFFT();
+  for (int n=0; n<local_spec_size; ++n) spec2[n] = cdata[n];
+
+  // Transform data1
+  packReal(data1);
+  forwardRealFFT();
+
+  // Multiply transforms
+  fftw_complex tmp;
+  for (int n=0; n<local_spec_size; ++n) {
+    tmp.re = (cdata[n].re * spec2[n].re) - (cdata[n].im * spec2[n].im);
+    tmp.im = (cdata[n].im * spec2[n].re) + (cdata[n].re * spec2[n].im);
+    cdata[n].re = tmp.re;
+    cdata[n].im = tmp.im;
+  }
+
+  backwardRealFFT();
+  unpackReal(resPtr);
+
+  delete[] spec2;
+}
+
+//
+// Utility method where by F(data)*kdata elementwise
+// ie. the real and imaginary parts of the transform of data is
+// scaled by the real kdata array (half-spectrum layout)
+//
+template <class FLOATTYPE, size_t NDIM>
+void PsRealFFTW<FLOATTYPE, NDIM>::scaledFFTPair(
+    const FLOATTYPE* data, const FLOATTYPE* kdata, FLOATTYPE* resPtr){
+
+  this->dbprt("PsRealFFTW::scaledFFTPair");
+
+  packReal(data);
+  forwardRealFFT();
+
+  // Scale transform result by kdata (both Re/Im)
+  for (int n=0; n<local_spec_size; ++n) {
+    cdata[n].re = cdata[n].re * kdata[n];
+    cdata[n].im = cdata[n].im * kdata[n];
+  }
+
+  backwardRealFFT();
+  unpackReal(resPtr);
+}
+
+//
+// F[i*data] = i*F[data] so the imaginary input is folded into the
+// scaling step: (a+bi)*i*kdata = (-b*kdata) + (a*kdata)i
+//
+template <class FLOATTYPE, size_t NDIM>
+void PsRealFFTW<FLOATTYPE, NDIM>::scaledFFTPairIm(
+    const FLOATTYPE* data, const FLOATTYPE* kdata, FLOATTYPE* resPtr){
+
+  this->dbprt("PsRealFFTW::scaledFFTPairIm");
+
+  packReal(data);
+  forwardRealFFT();
+
+  fftw_real tmp;
+  for (int n=0; n<local_spec_size; ++n) {
+    tmp = cdata[n].re;
+    cdata[n].re = -cdata[n].im * kdata[n];
+    cdata[n].im = tmp * kdata[n];
+  }
+
+  backwardRealFFT();
+  unpackReal(resPtr);
+}
+
+template <class FLOATTYPE, size_t NDIM>
+void PsRealFFTW<FLOATTYPE, NDIM>::calcForwardFFT(const FLOATTYPE* data,
+    FLOATTYPE* resPtr) {
+
+  TxDebugExcept tde("PsRealFFTW::calcForwardFFT");
+  tde << " full spectrum not available for half-spectrum transform";
+  tde << " in <FFT " << this->getName() << " >";
+  throw tde;
+}
+
+template <class FLOATTYPE, size_t NDIM>
+void PsRealFFTW<FLOATTYPE, NDIM>::calcBackwardFFT(const FLOATTYPE* data,
+    FLOATTYPE* resPtr) {
+
+  TxDebugExcept tde("PsRealFFTW::calcBackwardFFT");
+  tde << " full spectrum not available for half-spectrum transform";
+  tde << " in <FFT " << this->getName() << " >";
+  throw tde;
+}
+
+template class PsRealFFTW<float, 1>;
+template class PsRealFFTW<float, 2>;
+template class PsRealFFTW<float, 3>;
+
+template class PsRealFFTW<double, 1>;
+template class PsRealFFTW<double, 2>;
+template class PsRealFFTW<double, 3>;
@@ -0,0 +1,250 @@
+/**
+ *
+ * @file    PsRealFFTW.h
+ *
+ * @brief   Real-to-complex Fourier transform using FFTW
+ *
+ * @version $Id: PsRealFFTW.h 8329 2007-09-21 16:12:04Z swsides $
+ *
+ * Copyright &copy; 2008-2020, Tech-X Corporation, Boulder, CO.
+ * All rights reserved.
+ */
+
+#ifndef PS_REAL_FFTW_H
+#define PS_REAL_FFTW_H
+
+// std includes
+#include <string>
+
+// configure stuff
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+// psfft includes
+#include <PsFFT.h>
+
+// include MPI/FFTW
+#ifdef HAVE_MPI
+#define MPICH_IGNORE_CXX_SEEK
+#include <mpi.h>
+#include <rfftw_mpi.h>
+typedef rfftwnd_mpi_plan planTypeReal;
+#else
+#include <rfftw.h>
+typedef rfftwnd_plan     planTypeReal;
+#endif
+
+/**
+ * Fastest Fourier-transform in the West interface class using the
+ * real-to-complex transforms. Only the Hermitian half-spectrum is
+ * stored so the last k-space dimension is (n/2 + 1) long. For MPI
+ * the spectrum is left in transposed order (ie. the data layout
+ * from the transposefftw objects with the last dimension cut in half)
+ * so this object should be built on the transpose grid. Serial
+ * transforms use numThreads FFTW threads as PsFFTW.
+ */
+template <class FLOATTYPE, size_t NDIM>
+class PsRealFFTW : public virtual PsFFT<FLOATTYPE, NDIM> {
+
+ public:
+
+/**
+ * constructor
+ */
+  PsRealFFTW();
+
+/**
+ * Destructor
+ */
+  virtual ~PsRealFFTW();
+
+/**
+ * Store the data needed to build this object.
+ *
+ * @param tas the attribute set containing
+ *            the initial conditions
+ */
+    virtual void setAttrib(const TxHierAttribSetIntDbl& tas);
+
+/**
+ * Build the data for this object
+ */
+    virtual void buildData();
+
+/**
+ * Build the solvers for this object
+ */
+    virtual void buildSolvers();
+
+/**
+ * Get size of (real) data transform
+ */
+   virtual size_t getFFTSize() {
+     return (size_t)local_real_size;
+   }
+
+/**
+ * Get number of local elements in the half-spectrum
+ */
+   virtual size_t getSpecSize() {
+     return (size_t)local_spec_size;
+   }
+
+/**
+ * Only the Hermitian half-spectrum is stored
+ */
+   virtual bool hasHalfSpectrum() {
+     return true;
+   }
+
+/**
+ * MPI spectrum is in transposed order, serial in normal order
+ */
+   virtual bool isTransposedOrder() {
+#ifdef HAVE_MPI
+     return true;
+#else
+     return false;
+#endif
+   }
+
+/**
+ * Forward transform real input data and
+ * return |a+bi| elementwise (not available for half-spectrum)
+ *
+ * @param data1  pointer to REAL data to transform
+ * @param resPtr pointer to Re[result] (also supplied by caller)
+ */
+   virtual void forwardFFTAbs(const FLOATTYPE* data1,
+       FLOATTYPE* resPtr);
+
+/**
+ * Forward transform two REAL data sets and return Re[conj(a) b]
+ * elementwise on the half spectrum. Modes 0 < k < nz/2 in the
+ * last dimension stand for their conjugates as well.
+ *
+ * @param data1  pointer to first REAL data to transform
+ * @param data2  pointer to second REAL data to transform
+ * @param resPtr pointer to result in k-space (also supplied by caller)
+ */
+   virtual void crossSpectrumRe(const FLOATTYPE* data1,
+       const FLOATTYPE* data2, FLOATTYPE* resPtr);
+
+/**
+ * Forward transform real input data, multiply elementwise
+ * and backward transform
+ *
+ * @param data1  pointer to REAL data to transform
+ * @param data2  pointer to REAL to scale transform
+ * @param resPtr pointer to Re[result] (also supplied by caller)
+ */
+   virtual void convolveRe(const FLOATTYPE* data1,
+       const FLOATTYPE* data2, FLOATTYPE* resPtr);
+
+/**
+ * Perform multi-dimensional FFT pair, scaling the
+ * result by kdata in-between transform pair
+ *
+ * @param data  pointer to REAL data to transform
+ * @param kdata pointer to half-spectrum data to scale transform
+ * @param resPtr pointer to Re[result] (also supplied by caller)
+ */
+   virtual void scaledFFTPair(const FLOATTYPE* data,
+       const FLOATTYPE* kdata, FLOATTYPE* resPtr);
+
+/**
+ * Perform multi-dimensional FFT pair, scaling the
+ * result by kdata in-between transform pair
+ *
+ * @param data  pointer to IMAGINARY data to transform
+ * @param kdata pointer to half-spectrum data to scale transform
+ * @param resPtr pointer to Re[result] (also supplied by caller)
+ */
+   virtual void scaledFFTPairIm(const FLOATTYPE* data,
+       const FLOATTYPE* kdata, FLOATTYPE* resPtr);
+
+/**
+ * Perform forward multi-dimensional FFT (not available for half-spectrum)
+ *
+ * @param data pointer to REAL data to transform
+ * @param resPtr pointer to Re[result] (also supplied by caller)
+ */
+   virtual void calcForwardFFT(const FLOATTYPE* data,
+       FLOATTYPE* resPtr);
+
+/**
+ * Perform backward multi-dimensional FFT (not available for half-spectrum)
+ *
+ * @param data pointer to REAL data to transform
+ * @param resPtr pointer to Re[result] (also supplied by caller)
+ */
+   virtual void calcBackwardFFT(const FLOATTYPE* data,
+       FLOATTYPE* resPtr);
+
+ protected:
+
+/**
+ * Copy real data into (padded) transform array
+ *
+ * @param data pointer to REAL data
+ */
+   void packReal(const FLOATTYPE* data);
+
+/**
+ * Copy (padded) transform array into real data
+ *
+ * @param resPtr pointer to REAL result
+ */
+   void unpackReal(FLOATTYPE* resPtr);
+
+/** Forward transform of rdata into the half-spectrum */
+   void forwardRealFFT();
+
+/** Backward transform of the half-spectrum into rdata */
+   void backwardRealFFT();
+
+   /** Number of data arrays to transform */
+   int n_fields;
+
+   /** Number of threads for each serial transform */
+   int numThreads;
+
+   /** Number of local elements in real data */
+   int local_real_size;
+
+   /** Number of local elements in half-spectrum */
+   int local_spec_size;
+
+   /** Length of last dimension of real data */
+   int nLast;
+
+   /** Length of last dimension of padded real data, 2*(nLast/2+1) */
+   int nLastPad;
+
+   /** Internal real data structure (padded in-place for MPI) */
+   fftw_real* rdata;
+
+   /** Internal half-spectrum data structure */
+   fftw_complex* cdata;
+
+   /** Internal workspace data structure */
+   fftw_real* work;
+
+ private:
+
+   /** FFTW plan for forward transforms */
+   planTypeReal forwardRPlan;
+
+   /** FFTW plan for backward transforms */
+   planTypeReal backwardRPlan;
+
+   /** Make private to prevent use */
+   PsRealFFTW(const PsRealFFTW<FLOATTYPE, NDIM>& psf);
+
+   /** Make private to prevent use */
+   PsRealFFTW<FLOATTYPE, NDIM>& operator=(
+       const PsRealFFTW<FLOATTYPE, NDIM>& psf);
+};
+
+#endif // PS_REAL_FFTW_H
@@ -0,0 +1,578 @@
+/**
+ *
+ * @file    PsRealFFTW3.cpp
+ *
+ * @brief   Real-to-complex Fourier transform using the FFTW3 interface
+ *
+ * @version $Id: PsRealFFTW3.cpp 6319 2006-11-14 22:39:46Z swsides $
+ *
+ * Copyright &copy; 2008-2020, Tech-X Corporation, Boulder, CO.
+ * All rights reserved.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#ifdef HAVE_MPI
+#define MPICH_IGNORE_CXX_SEEK
+#include <mpi.h>
+#include <fftw3-mpi.h>
+#else
+#include <fftw3.h>
+#endif
+
+// psfft includes
+#include <PsRealFFTW3.h>
+
+//
+// Library level setup is done once for all real FFTW3 objects,
+// repeated calls (also from PsFFTW3) are harmless
+//
+static bool rfftw3Initialized = false;
+
+static void initRFFTW3() {
+  if (rfftw3Initialized) return;
+#ifdef HAVE_FFTW3_THREADS
+  fftw_init_threads();
+#endif
+#ifdef HAVE_MPI
+  fftw_mpi_init();
+#endif
+  rfftw3Initialized = true;
+}
+
+template <class FLOATTYPE, size_t NDIM>
+PsRealFFTW3<FLOATTYPE, NDIM>::PsRealFFTW3() {
+
+  plannerEffort = "estimate";
+  wisdomFile = "";
+  numThreads = 1;
+  transposeOrder = false;
+  transposeOrderSet = false;
+
+  // Sizes set in buildData
+  localRealSize = 1;
+  localSpecSize = 1;
+  nLast = 1;
+  nLastPad = 1;
+  allocSize = 0;
+
+  // Set pointers
+  rdata = NULL;
+  forwardRPlan3 = NULL;
+  backwardRPlan3 = NULL;
+}
+
+template <class FLOATTYPE, size_t NDIM>
+PsRealFFTW3<FLOATTYPE, NDIM>::~PsRealFFTW3() {
+
+  if (forwardRPlan3)  fftw_destroy_plan(forwardRPlan3);
+  if (backwardRPlan3) fftw_destroy_plan(backwardRPlan3);
+  if (rdata) fftw_free(rdata);
+  for (size_t w=0; w<wsData.size(); ++w) fftw_free(wsData[w]);
+}
+
+template <class FLOATTYPE, size_t NDIM>
+void PsRealFFTW3<FLOATTYPE, NDIM>::setAttrib(
+    const TxHierAttribSetIntDbl& tas) {
+
+  // Scoping call to base class
+  PsFFT<FLOATTYPE, NDIM>::setAttrib(tas);
+
+  this->dbprt("PsRealFFTW3::setAttrib() ");
+
+  // Planner effort
+  if (tas.hasString("plannerEffort")) {
+    plannerEffort = tas.getString("plannerEffort");
+    if (plannerEffort != "estimate" && plannerEffort != "measure" &&
+        plannerEffort != "patient"  && plannerEffort != "exhaustive") {
+      TxDebugExcept tde("PsRealFFTW3::setAttrib: plannerEffort ");
+      tde << plannerEffort << " must be one of ";
+      tde << "estimate, measure, patient, exhaustive";
+      tde << " in <FFT " << this->getName() << " >";
+      throw tde;
+    }
+  }
+
+  // Wisdom file, read before and written after planning
+  if (tas.hasString("wisdomFile")) {
+    wisdomFile = tas.getString("wisdomFile");
+  }
+
+  // Threads per transform
+  if (tas.hasParam("numThreads")) {
+    numThreads = (int)tas.getParam("numThreads");
+    if (numThreads < 1) numThreads = 1;
+#ifndef HAVE_FFTW3_THREADS
+    if (numThreads > 1) {
+      TxDebugExcept tde("PsRealFFTW3::setAttrib: numThreads > 1 ");
+      tde << "but FFTW3 threads library not found";
+      tde << " in <FFT " << this->getName() << " >";
+      throw tde;
+    }
+#endif
+  }
+
+  // k-space order for MPI
+  if (tas.hasString("transposeOrder")) {
+    std::string tStr = tas.getString("transposeOrder");
+    transposeOrder = (tStr == "on");
+    transposeOrderSet = true;
+  }
+}
+
+template <class FLOATTYPE, size_t NDIM>
+void PsRealFFTW3<FLOATTYPE, NDIM>::buildData() {
+
+  // Scoping call to base class
+  PsFFT<FLOATTYPE, NDIM>::buildData();
+
+  this->dbprt("PsRealFFTW3::buildData() ");
+
+  initRFFTW3();
+
+  // *************************************************
+  // Set rank/dimensions for plans
+  // *************************************************
+  std::vector<size_t> dims;
+  dims = this->globalDims;
+  int rank = (int)dims.size();
+
+  // Last dimension is cut in half in k-space, the real data
+  // rows are padded to hold the spectrum in-place
+  nLast = dims[rank-1];
+  size_t nLastSpec = nLast/2 + 1;
+  nLastPad = 2*nLastSpec;
+
+#ifdef HAVE_MPI
+
+  // Default k-space order is the layout of the grid decomp
+  if (!transposeOrderSet) {
+    transposeOrder = this->getGrid().getDecomp().isTransposed();
+  }
+  this->dbprt("transposeOrder = ", (int)transposeOrder);
+
+  // Local sizes are set from the complex dimensions
+  ptrdiff_t* planDims = new ptrdiff_t[rank];
+  ptrdiff_t* specDims = new ptrdiff_t[rank];
+  for (int n=0; n<rank; ++n) {
+    planDims[n] = dims[n];
+    specDims[n] = dims[n];
+  }
+  specDims[rank-1] = nLastSpec;
+
+  ptrdiff_t local_n0, local_0_start;
+  ptrdiff_t local_n1, local_1_start;
+  ptrdiff_t alloc_local;
+  size_t innerReal = 1;
+  size_t innerSpec = 1;
+  for (int n=2; n<rank; ++n) {
+    innerReal *= dims[n];
+    innerSpec *= specDims[n];
+  }
+
+  if (transposeOrder) {
+    alloc_local = fftw_mpi_local_size_transposed(rank, specDims,
+        this->getPlanComm(), &local_n0, &local_0_start,
+        &local_n1, &local_1_start);
+    localSpecSize = local_n1*dims[0]*innerSpec;
+  }
+  else {
+    alloc_local = fftw_mpi_local_size(rank, specDims,
+        this->getPlanComm(), &local_n0, &local_0_start);
+    local_n1 = 0;
+    localSpecSize = local_n0*dims[1]*innerSpec;
+  }
+  localRealSize = local_n0*dims[1]*innerReal;
+
+  // FFTW3 and the FFTW2 decomp must agree on the local slab
+  std::vector<size_t> gridCells =
+      this->getGrid().getDecomp().getNumCellsLocal();
+  size_t gridSize = 1;
+  for (size_t n=0; n<gridCells.size(); ++n) gridSize *= gridCells[n];
+  size_t expected = transposeOrder ? local_n1*dims[0]*innerReal :
+      localRealSize;
+  if (gridSize != expected) {
+    TxDebugExcept tde("PsRealFFTW3::buildData: FFTW3 local size ");
+    tde << expected << " does not match grid decomp size " << gridSize;
+    tde << " in <FFT " << this->getName() << " >";
+    throw tde;
+  }
+
+  allocSize = 2*alloc_local;
+  delete[] specDims;
+
+#else
+
+  int* planDims = new int[rank];
+  for (int n=0; n<rank; ++n) planDims[n] = dims[n];
+
+  localRealSize = 1;
+  for (int n=0; n<rank; ++n) localRealSize *= dims[n];
+  localSpecSize = (localRealSize/nLast)*nLastSpec;
+  allocSize = 2*localSpecSize;
+
+#endif
+
+  rdata = (double*) fftw_malloc(sizeof(double)*allocSize);
+  fftw_complex* cbuf = (fftw_complex*) rdata;
+
+  this->dbprt("localRealSize = ", (int)localRealSize);
+  this->dbprt("localSpecSize = ", (int)localSpecSize);
+
+  // Planning
+  importWisdom();
+
+#ifdef HAVE_FFTW3_THREADS
+  fftw_plan_with_nthreads(numThreads);
+#endif
+
+  unsigned flags = plannerFlag();
+
+#ifdef HAVE_MPI
+  unsigned fflags = flags;
+  unsigned bflags = flags;
+  if (transposeOrder) {
+    fflags |= FFTW_MPI_TRANSPOSED_OUT;
+    bflags |= FFTW_MPI_TRANSPOSED_IN;
+  }
+  forwardRPlan3  = fftw_mpi_plan_dft_r2c(rank, planDims, rdata, cbuf,
+      this->getPlanComm(), fflags);
+  backwardRPlan3 = fftw_mpi_plan_dft_c2r(rank, planDims, cbuf, rdata,
+      this->getPlanComm(), bflags);
+#else
+  forwardRPlan3  = fftw_plan_dft_r2c(rank, planDims, rdata, cbuf, flags);
+  backwardRPlan3 = fftw_plan_dft_c2r(rank, planDims, cbuf, rdata, flags);
+#endif
+
+  // Explicitly free local memory
+  delete[] planDims;
+
+  if (!forwardRPlan3 || !backwardRPlan3) {
+    TxDebugExcept tde("PsRealFFTW3::buildData: FFTW3 plan creation failed");
+    tde << " in <FFT " << this->getName() << " >";
+    throw tde;
+  }
+
+  exportWisdom();
+}
+
+template <class FLOATTYPE, size_t NDIM>
+void PsRealFFTW3<FLOATTYPE, NDIM>::buildSolvers() {
+
+  // Scoping call to base class
+  PsFFT<FLOATTYPE, NDIM>::buildSolvers();
+}
+
+//
+// Planner flag from input string
+//
+template <class FLOATTYPE, size_t NDIM>
+unsigned PsRealFFTW3<FLOATTYPE, NDIM>::plannerFlag() {
+
+  if (plannerEffort == "measure")    return FFTW_MEASURE;
+  if (plannerEffort == "patient")    return FFTW_PATIENT;
+  if (plannerEffort == "exhaustive") return FFTW_EXHAUSTIVE;
+  return FFTW_ESTIMATE;
+}
+
+//
+// Wisdom is read on rank 0 of the plan communicator and shared
+// over it, as for PsFFTW3
+//
+template <class FLOATTYPE, size_t NDIM>
+void PsRealFFTW3<FLOATTYPE, NDIM>::importWisdom() {
+
+  if (wisdomFile.empty()) return;
+
+  int found = 0;
+#ifdef HAVE_MPI
+  MPI_Comm planComm = this->getPlanComm();
+  int planRank = 0;
+  MPI_Comm_rank(planComm, &planRank);
+  if (planRank == 0) {
+    found = fftw_import_wisdom_from_filename(wisdomFile.c_str());
+  }
+  if (planComm != MPI_COMM_SELF) fftw_mpi_broadcast_wisdom(planComm);
+#else
+  found = fftw_import_wisdom_from_filename(wisdomFile.c_str());
+#endif
+
+  if (found) this->pprt("Loaded FFTW wisdom from ", wisdomFile);
+}
+
+//
+// Wisdom is gathered to rank 0 of the plan communicator and written.
+// With single-rank plans only the first world rank writes the file.
+//
+template <class FLOATTYPE, size_t NDIM>
+void PsRealFFTW3<FLOATTYPE, NDIM>::exportWisdom() {
+
+  if (wisdomFile.empty()) return;
+
+  bool writer = true;
+#ifdef HAVE_MPI
+  MPI_Comm planComm = this->getPlanComm();
+  if (planComm == MPI_COMM_SELF) {
+    writer = (this->getCommBase().getRank() == 0);
+  }
+  else {
+    fftw_mpi_gather_wisdom(planComm);
+    int planRank = 0;
+    MPI_Comm_rank(planComm, &planRank);
+    writer = (planRank == 0);
+  }
+#endif
+
+  if (writer) {
+    if (!fftw_export_wisdom_to_filename(wisdomFile.c_str())) {
+      this->pprt("Could not write FFTW wisdom to ", wisdomFile);
+    }
+  }
+}
+
+//
+// Local helpers for padded layout and plan execution. The
+// new-array execute calls are thread-safe for distinct buffers
+//
+template <class FLOATTYPE, size_t NDIM>
+void PsRealFFTW3<FLOATTYPE, NDIM>::packReal(const FLOATTYPE* data,
+    double* buf) {
+
+  size_t nrows = localRealSize/nLast;
+  for (size_t r=0; r<nrows; ++r) {
+    double* brow = buf + r*nLastPad;
+    const FLOATTYPE* drow = data + r*nLast;
+    for (size_t k=0; k<nLast; ++k) brow[k] = drow[k];
+  }
+}
+
+template <class FLOATTYPE, size_t NDIM>
+void PsRealFFTW3<FLOATTYPE, NDIM>::unpackReal(const double* buf,
+    FLOATTYPE* resPtr) {
+
+  size_t nrows = localRealSize/nLast;
+  for (size_t r=0; r<nrows; ++r) {
+    const double* brow = buf + r*nLastPad;
+    FLOATTYPE* drow = resPtr + r*nLast;
+    for (size_t k=0; k<nLast; ++k) drow[k] = brow[k];
+  }
+}
+
+template <class FLOATTYPE, size_t NDIM>
+void PsRealFFTW3<FLOATTYPE, NDIM>::forwardReal(double* buf) {
+#ifdef HAVE_MPI
+  fftw_mpi_execute_dft_r2c(forwardRPlan3, buf, (fftw_complex*) buf);
+#else
+  fftw_execute_dft_r2c(forwardRPlan3, buf, (fftw_complex*) buf);
+#endif
+}
+
+template <class FLOATTYPE, size_t NDIM>
+void PsRealFFTW3<FLOATTYPE, NDIM>::backwardReal(double* buf) {
+#ifdef HAVE_MPI
+  fftw_mpi_execute_dft_c2r(backwardRPlan3, (fftw_complex*) buf, buf);
+#else
+  fftw_execute_dft_c2r(backwardRPlan3, (fftw_complex*) buf, buf);
+#endif
+}
+
+/*
+ * *************************
+ * FFTW3 calls
+ * *************************
+ */
+
+template <class FLOATTYPE, size_t NDIM>
+void PsRealFFTW3<FLOATTYPE, NDIM>::forwardFFTAbs(
+    const FLOATTYPE* data1, FLOATTYPE* resPtr) {
+
+  TxDebugExcept tde("PsRealFFTW3::forwardFFTAbs");
+  tde << " full spectrum not available for half-spectrum transform";
+  tde << " in <FFT " << this->getName() << " >";
+  throw tde;
+}
+
+template <class FLOATTYPE, size_t NDIM>
+void PsRealFFTW3<FLOATTYPE, NDIM>::crossSpectrumRe(
+    const FLOATTYPE* data1, const FLOATTYPE* data2, FLOATTYPE* resPtr){
+
+  this->dbprt("PsRealFFTW3::crossSpectrumRe");
+  crossSpectrum(data1, data2, resPtr, rdata);
+}
+
+//
+// Spectrum of data1 is held in a local copy while data2
+// is transformed in buf
+//
+template <class FLOATTYPE, size_t NDIM>
+void PsRealFFTW3<FLOATTYPE, NDIM>::crossSpectrum(
+    const FLOATTYPE* data1, const FLOATTYPE* data2, FLOATTYPE* resPtr,
+    double* buf){
+
+  std::vector<double> spec1(2*localSpecSize);
+
+  packReal(data1, buf);
+  forwardReal(buf);
+  for (size_t n=0; n<2*localSpecSize; ++n) spec1[n] = buf[n];
+
+  packReal(data2, buf);
+  forwardReal(buf);
+
+  for (size_t n=0; n<localSpecSize; ++n) {
+    resPtr[n] = (spec1[2*n]*buf[2*n]) + (spec1[2*n+1]*buf[2*n+1]);
+  }
+}
+
+template <class FLOATTYPE, size_t NDIM>
+void PsRealFFTW3<FLOATTYPE, NDIM>::convolveRe(
+    const FLOATTYPE* data1, const FLOATTYPE* data2, FLOATTYPE* resPtr){
+
+  this->dbprt("PsRealFFTW3::convolveRe");
+
+  // Transform data2 and hold spectrum
+  std::vector<double> spec2(2*localSpecSize);
+  packReal(data2, rdata);
+  forwardReal(rdata);
+  for (size_t n=0; n<2*localSpecSize; ++n) spec2[n] = rdata[n];
+
+  // Transform data1
+  packReal(data1, rdata);
+  forwardReal(rdata);
+
+  // Multiply transforms
+  double re, im;
+  for (size_t n=0; n<localSpecSize; ++n) {
+    re = (rdata[2*n]*spec2[2*n]) - (rdata[2*n+1]*spec2[2*n+1]);
+    im = (rdata[2*n+1]*spec2[2*n]) + (rdata[2*n]*spec2[2*n+1]);
+    rdata[2*n]   = re;
+    rdata[2*n+1] = im;
+  }
+
+  backwardReal(rdata);
+  unpackReal(rdata, resPtr);
+}
+
+//
+// Utility method where by F(data)*kdata elementwise
+// ie. the real and imaginary parts of the transform of data is
+// scaled by the real kdata array (half-spectrum layout)
+//
+template <class FLOATTYPE, size_t NDIM>
+void PsRealFFTW3<FLOATTYPE, NDIM>::scaledFFTPair(
+    const FLOATTYPE* data, const FLOATTYPE* kdata, FLOATTYPE* resPtr){
+
+  this->dbprt("PsRealFFTW3::scaledFFTPair");
+  scaledPair(data, kdata, resPtr, rdata);
+}
+
+template <class FLOATTYPE, size_t NDIM>
+void PsRealFFTW3<FLOATTYPE, NDIM>::scaledPair(const FLOATTYPE* data,
+    const FLOATTYPE* kdata, FLOATTYPE* resPtr, double* buf){
+
+  packReal(data, buf);
+  forwardReal(buf);
+
+  // Scale transform result by kdata (both Re/Im)
+  for (size_t n=0; n<localSpecSize; ++n) {
+    buf[2*n]   *= kdata[n];
+    buf[2*n+1] *= kdata[n];
+  }
+
+  backwardReal(buf);
+  unpackReal(buf, resPtr);
+}
+
+//
+// Workspaces are padded buffers of the size of rdata
+//
+template <class FLOATTYPE, size_t NDIM>
+size_t PsRealFFTW3<FLOATTYPE, NDIM>::addWorkspace() {
+
+  if (!hasWorkspaces()) return 0;
+
+  wsData.push_back((double*) fftw_malloc(sizeof(double)*allocSize));
+  return wsData.size();
+}
+
+template <class FLOATTYPE, size_t NDIM>
+void PsRealFFTW3<FLOATTYPE, NDIM>::scaledFFTPairWs(size_t ws,
+    const FLOATTYPE* data, const FLOATTYPE* kdata, FLOATTYPE* resPtr){
+
+  double* buf = rdata;
+  if (ws > 0 && ws <= wsData.size()) buf = wsData[ws-1];
+  scaledPair(data, kdata, resPtr, buf);
+}
+
+template <class FLOATTYPE, size_t NDIM>
+void PsRealFFTW3<FLOATTYPE, NDIM>::scaledFFTPairTwoWs(size_t ws,
+    const FLOATTYPE* data1, const FLOATTYPE* data2,
+    const FLOATTYPE* kdata, FLOATTYPE* resPtr1, FLOATTYPE* resPtr2){
+
+  double* buf = rdata;
+  if (ws > 0 && ws <= wsData.size()) buf = wsData[ws-1];
+  scaledPair(data1, kdata, resPtr1, buf);
+  scaledPair(data2, kdata, resPtr2, buf);
+}
+
+template <class FLOATTYPE, size_t NDIM>
+void PsRealFFTW3<FLOATTYPE, NDIM>::crossSpectrumReWs(size_t ws,
+    const FLOATTYPE* data1, const FLOATTYPE* data2, FLOATTYPE* resPtr){
+
+  double* buf = rdata;
+  if (ws > 0 && ws <= wsData.size()) buf = wsData[ws-1];
+  crossSpectrum(data1, data2, resPtr, buf);
+}
+
+//
+// F[i*data] = i*F[data] so the imaginary input is folded into the
+// scaling step: (a+bi)*i*kdata = (-b*kdata) + (a*kdata)i
+//
+template <class FLOATTYPE, size_t NDIM>
+void PsRealFFTW3<FLOATTYPE, NDIM>::scaledFFTPairIm(
+    const FLOATTYPE* data, const FLOATTYPE* kdata, FLOATTYPE* resPtr){
+
+  this->dbprt("PsRealFFTW3::scaledFFTPairIm");
+
+  packReal(data, rdata);
+  forwardReal(rdata);
+
+  double tmp;
+  for (size_t n=0; n<localSpecSize; ++n) {
+    tmp = rdata[2*n];
+    rdata[2*n]   = -rdata[2*n+1]*kdata[n];
+    rdata[2*n+1] = tmp*kdata[n];
+  }
+
+  backwardReal(rdata);
+  unpackReal(rdata, resPtr);
+}
+
+template <class FLOATTYPE, size_t NDIM>
+void PsRealFFTW3<FLOATTYPE, NDIM>::calcForwardFFT(const FLOATTYPE* data,
+    FLOATTYPE* resPtr) {
+
+  TxDebugExcept tde("PsRealFFTW3::calcForwardFFT");
+  tde << " full spectrum not available for half-spectrum transform";
+  tde << " in <FFT " << this->getName() << " >";
+  throw tde;
+}
+
+template <class FLOATTYPE, size_t NDIM>
+void PsRealFFTW3<FLOATTYPE, NDIM>::calcBackwardFFT(const FLOATTYPE* data,
+    FLOATTYPE* resPtr) {
+
+  TxDebugExcept tde("PsRealFFTW3::calcBackwardFFT");
+  tde << " full spectrum not available for half-spectrum transform";
+  tde << " in <FFT " << this->getName() << " >";
+  throw tde;
+}
+
+template class PsRealFFTW3<float, 1>;
+template class PsRealFFTW3<float, 2>;
+template class PsRealFFTW3<float, 3>;
+
+template class PsRealFFTW3<double, 1>;
+template class PsRealFFTW3<double, 2>;
+template class PsRealFFTW3<double, 3>;
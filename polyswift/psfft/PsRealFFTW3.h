@@ -0,0 +1,322 @@
+/**
+ *
+ * @file    PsRealFFTW3.h
+ *
+ * @brief   Real-to-complex Fourier transform using the FFTW3 interface
+ *
+ * @version $Id: PsRealFFTW3.h 8329 2007-09-21 16:12:04Z swsides $
+ *
+ * Copyright &copy; 2008-2020, Tech-X Corporation, Boulder, CO.
+ * All rights reserved.
+ */
+
+#ifndef PS_REAL_FFTW3_H
+#define PS_REAL_FFTW3_H
+
+// std includes
+#include <string>
+#include <vector>
+
+// configure stuff
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+// psfft includes
+#include <PsFFT.h>
+
+//
+// The FFTW3 header is only included in the .cpp (see PsFFTW3.h)
+//
+struct fftw_plan_s;
+
+/**
+ * Fastest Fourier-transform in the West interface class using the
+ * FFTW3 real-to-complex transforms, the realfftw kind of FFTW3
+ * builds. Only the Hermitian half-spectrum is stored so the last
+ * k-space dimension is (n/2 + 1) long. The k-space order follows
+ * the decomp of the grid as for PsFFTW3 (transposeOrder), so on the
+ * transpose grid the layout is that of PsRealFFTW. The planner
+ * effort, wisdom file and threads are set as for the fftw3 kind.
+ */
+template <class FLOATTYPE, size_t NDIM>
+class PsRealFFTW3 : public virtual PsFFT<FLOATTYPE, NDIM> {
+
+ public:
+
+/**
+ * constructor
+ */
+  PsRealFFTW3();
+
+/**
+ * Destructor
+ */
+  virtual ~PsRealFFTW3();
+
+/**
+ * Store the data needed to build this object.
+ *
+ * @param tas the attribute set containing
+ *            the initial conditions
+ */
+    virtual void setAttrib(const TxHierAttribSetIntDbl& tas);
+
+/**
+ * Build the data for this object
+ */
+    virtual void buildData();
+
+/**
+ * Build the solvers for this object
+ */
+    virtual void buildSolvers();
+
+/**
+ * Get size of (real) data transform
+ */
+   virtual size_t getFFTSize() {
+     return localRealSize;
+   }
+
+/**
+ * Get number of local elements in the half-spectrum
+ */
+   virtual size_t getSpecSize() {
+     return localSpecSize;
+   }
+
+/**
+ * Only the Hermitian half-spectrum is stored
+ */
+   virtual bool hasHalfSpectrum() {
+     return true;
+   }
+
+/**
+ * Spectrum is in transposed order with MPI and transposeOrder on
+ */
+   virtual bool isTransposedOrder() {
+#ifdef HAVE_MPI
+     return transposeOrder;
+#else
+     return false;
+#endif
+   }
+
+/**
+ * Forward transform real input data and
+ * return |a+bi| elementwise (not available for half-spectrum)
+ *
+ * @param data1  pointer to REAL data to transform
+ * @param resPtr pointer to Re[result] (also supplied by caller)
+ */
+   virtual void forwardFFTAbs(const FLOATTYPE* data1,
+       FLOATTYPE* resPtr);
+
+/**
+ * Forward transform two REAL data sets and return Re[conj(a) b]
+ * elementwise on the half spectrum. Modes 0 < k < nz/2 in the
+ * last dimension stand for their conjugates as well.
+ *
+ * @param data1  pointer to first REAL data to transform
+ * @param data2  pointer to second REAL data to transform
+ * @param resPtr pointer to result in k-space (also supplied by caller)
+ */
+   virtual void crossSpectrumRe(const FLOATTYPE* data1,
+       const FLOATTYPE* data2, FLOATTYPE* resPtr);
+
+/**
+ * Forward transform real input data, multiply elementwise
+ * and backward transform
+ *
+ * @param data1  pointer to REAL data to transform
+ * @param data2  pointer to REAL to scale transform
+ * @param resPtr pointer to Re[result] (also supplied by caller)
+ */
+   virtual void convolveRe(const FLOATTYPE* data1,
+       const FLOATTYPE* data2, FLOATTYPE* resPtr);
+
+/**
+ * Perform multi-dimensional FFT pair, scaling the
+ * result by kdata in-between transform pair
+ *
+ * @param data  pointer to REAL data to transform
+ * @param kdata pointer to half-spectrum data to scale transform
+ * @param resPtr pointer to Re[result] (also supplied by caller)
+ */
+   virtual void scaledFFTPair(const FLOATTYPE* data,
+       const FLOATTYPE* kdata, FLOATTYPE* resPtr);
+
+/**
+ * MPI transforms are collective and have no workspaces,
+ * serial transforms do
+ */
+   virtual bool hasWorkspaces() {
+#ifdef HAVE_MPI
+     return false;
+#else
+     return true;
+#endif
+   }
+
+/**
+ * Add a padded buffer on the shared plans for one concurrent caller
+ *
+ * @return index of workspace
+ */
+   virtual size_t addWorkspace();
+
+/**
+ * Perform scaledFFTPair in a workspace from addWorkspace
+ *
+ * @param ws     index of workspace
+ * @param data   pointer to REAL data to transform
+ * @param kdata  pointer to half-spectrum data to scale transform
+ * @param resPtr pointer to Re[result] (also supplied by caller)
+ */
+   virtual void scaledFFTPairWs(size_t ws, const FLOATTYPE* data,
+       const FLOATTYPE* kdata, FLOATTYPE* resPtr);
+
+/**
+ * Perform scaledFFTPairTwo in a workspace from addWorkspace, the
+ * two data sets are transformed one after the other
+ *
+ * @param ws      index of workspace
+ * @param data1   pointer to first REAL data to transform
+ * @param data2   pointer to second REAL data to transform
+ * @param kdata   pointer to half-spectrum data to scale transform
+ * @param resPtr1 pointer to first Re[result] (also supplied by caller)
+ * @param resPtr2 pointer to second Re[result] (also supplied by caller)
+ */
+   virtual void scaledFFTPairTwoWs(size_t ws, const FLOATTYPE* data1,
+       const FLOATTYPE* data2, const FLOATTYPE* kdata,
+       FLOATTYPE* resPtr1, FLOATTYPE* resPtr2);
+
+/**
+ * Perform crossSpectrumRe in a workspace from addWorkspace
+ *
+ * @param ws     index of workspace
+ * @param data1  pointer to first REAL data to transform
+ * @param data2  pointer to second REAL data to transform
+ * @param resPtr pointer to result in k-space (also supplied by caller)
+ */
+   virtual void crossSpectrumReWs(size_t ws, const FLOATTYPE* data1,
+       const FLOATTYPE* data2, FLOATTYPE* resPtr);
+
+/**
+ * Perform multi-dimensional FFT pair, scaling the
+ * result by kdata in-between transform pair
+ *
+ * @param data  pointer to IMAGINARY data to transform
+ * @param kdata pointer to half-spectrum data to scale transform
+ * @param resPtr pointer to Re[result] (also supplied by caller)
+ */
+   virtual void scaledFFTPairIm(const FLOATTYPE* data,
+       const FLOATTYPE* kdata, FLOATTYPE* resPtr);
+
+/**
+ * Perform forward multi-dimensional FFT (not available for half-spectrum)
+ *
+ * @param data pointer to REAL data to transform
+ * @param resPtr pointer to Re[result] (also supplied by caller)
+ */
+   virtual void calcForwardFFT(const FLOATTYPE* data,
+       FLOATTYPE* resPtr);
+
+/**
+ * Perform backward multi-dimensional FFT (not available for half-spectrum)
+ *
+ * @param data pointer to REAL data to transform
+ * @param resPtr pointer to Re[result] (also supplied by caller)
+ */
+   virtual void calcBackwardFFT(const FLOATTYPE* data,
+       FLOATTYPE* resPtr);
+
+ protected:
+
+   /** Number of local elements in real data */
+   size_t localRealSize;
+
+   /** Number of local elements in half-spectrum */
+   size_t localSpecSize;
+
+   /** Length of last dimension of real data */
+   size_t nLast;
+
+   /** Length of last dimension of padded real data, 2*(nLast/2+1) */
+   size_t nLastPad;
+
+   /**
+    * Internal padded real data, the half-spectrum (Re/Im pairs)
+    * is in-place in the same array
+    */
+   double* rdata;
+
+ private:
+
+   /** FFTW planner flag from plannerEffort string */
+   unsigned plannerFlag();
+
+   /** Load wisdom file (if set) before planning */
+   void importWisdom();
+
+   /** Save accumulated wisdom (if set) after planning */
+   void exportWisdom();
+
+   /** Copy real data into padded buffer */
+   void packReal(const FLOATTYPE* data, double* buf);
+
+   /** Copy padded buffer into real data */
+   void unpackReal(const double* buf, FLOATTYPE* resPtr);
+
+   /** Scaled FFT pair in-place on buf (rdata or a workspace) */
+   void scaledPair(const FLOATTYPE* data, const FLOATTYPE* kdata,
+       FLOATTYPE* resPtr, double* buf);
+
+   /** Re[conj(a) b] of two transforms in-place on buf */
+   void crossSpectrum(const FLOATTYPE* data1, const FLOATTYPE* data2,
+       FLOATTYPE* resPtr, double* buf);
+
+   /** Execute forward (r2c) plan in-place on buf */
+   void forwardReal(double* buf);
+
+   /** Execute backward (c2r) plan in-place on buf */
+   void backwardReal(double* buf);
+
+   /** Number of doubles allocated for padded buffers */
+   size_t allocSize;
+
+   /** Buffers of workspaces from addWorkspace */
+   std::vector<double*> wsData;
+
+   /** Planner effort: estimate, measure, patient, exhaustive */
+   std::string plannerEffort;
+
+   /** Name of FFTW wisdom file, not used if empty */
+   std::string wisdomFile;
+
+   /** Number of threads for each transform */
+   int numThreads;
+
+   /** Flag for transposed k-space order with MPI */
+   bool transposeOrder;
+
+   /** Flag for transposeOrder given in input, else set from decomp */
+   bool transposeOrderSet;
+
+   /** FFTW plan for forward (real-to-complex) transforms */
+   fftw_plan_s* forwardRPlan3;
+
+   /** FFTW plan for backward (complex-to-real) transforms */
+   fftw_plan_s* backwardRPlan3;
+
+   /** Make private to prevent use */
+   PsRealFFTW3(const PsRealFFTW3<FLOATTYPE, NDIM>& psf);
+
+   /** Make private to prevent use */
+   PsRealFFTW3<FLOATTYPE, NDIM>& operator=(
+       const PsRealFFTW3<FLOATTYPE, NDIM>& psf);
+};
+
+#endif // PS_REAL_FFTW3_H
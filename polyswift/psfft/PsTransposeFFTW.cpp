@@ -75,10 +75,10 @@ void PsTransposeFFTW<FLOATTYPE, NDIM>::buildData() {
   planTransposeDims[1] = tmp;
 
   forwardTPlan =
-      fftwnd_mpi_create_plan(MPI_COMM_WORLD,rank,planDims,
+      fftwnd_mpi_create_plan(this->getPlanComm(),rank,planDims,
       FFTW_FORWARD, FFTW_ESTIMATE);
   backwardTPlan =
-      fftwnd_mpi_create_plan(MPI_COMM_WORLD,rank,planTransposeDims,
+      fftwnd_mpi_create_plan(this->getPlanComm(),rank,planTransposeDims,
       FFTW_BACKWARD, FFTW_ESTIMATE);
 
   // Explicitly free local memory
@@ -132,8 +132,8 @@ template <class FLOATTYPE, size_t NDIM>
 void PsTransposeFFTW<FLOATTYPE, NDIM>::convolveRe(
     const FLOATTYPE* data1, const FLOATTYPE* data2, FLOATTYPE* resPtr){
 
-  // Local space... must be managed by this method
-  fftw_complex* in2 = new fftw_complex[this->total_local_size];
+  // Second transform held in "out" (unused by in-place MPI calls)
+  fftw_complex* in2 = this->out;
   fftw_complex tmp;
 
   this->dbprt("PsTransposeFFTW::convolveRe MPI ");
@@ -166,8 +166,6 @@ void PsTransposeFFTW<FLOATTYPE, NDIM>::convolveRe(
   for (int n=0; n<this->total_local_size; ++n) {
     resPtr[n] = this->in[n].re;
   }
-
-  delete[] in2;
 }
 
 //
@@ -207,6 +205,45 @@ void PsTransposeFFTW<FLOATTYPE, NDIM>::scaledFFTPair(
 
 }
 
+//
+// Two real data sets packed as Re/Im of one complex transform.
+// kdata is real and even so F^-1[k*F[a+ib]] = (k*a) + i(k*b)
+//
+template <class FLOATTYPE, size_t NDIM>
+void PsTransposeFFTW<FLOATTYPE, NDIM>::scaledFFTPairTwo(
+    const FLOATTYPE* data1, const FLOATTYPE* data2,
+    const FLOATTYPE* kdata, FLOATTYPE* resPtr1, FLOATTYPE* resPtr2){
+
+  this->dbprt("PsTransposeFFTW::scaledFFTPairTwo MPI ");
+
+  // Format data for fft_complex data type
+  for (int n=0; n<this->total_local_size; ++n) {
+    this->in[n].re = data1[n];
+    this->in[n].im = data2[n];
+  }
+
+  // FFT returned in-place to the "in" arrary
+  fftwnd_mpi(forwardTPlan, this->n_fields, this->in, this->work,
+      FFTW_TRANSPOSED_ORDER);
+
+  // Scale transform result by kdata
+  for (int n=0; n<this->total_local_size; ++n) {
+    this->in[n].re = this->in[n].re * kdata[n];
+    this->in[n].im = this->in[n].im * kdata[n];
+  }
+
+  // FFT returned in-place to the "in" arrary
+  fftwnd_mpi(backwardTPlan, this->n_fields, this->in, this->work,
+      FFTW_TRANSPOSED_ORDER);
+
+  // Format data for output
+  for (int n=0; n<this->total_local_size; ++n) {
+    resPtr1[n] = this->in[n].re;
+    resPtr2[n] = this->in[n].im;
+  }
+
+}
+
 template <class FLOATTYPE, size_t NDIM>
 void PsTransposeFFTW<FLOATTYPE, NDIM>::scaledFFTPairIm(
     const FLOATTYPE* data, const FLOATTYPE* kdata, FLOATTYPE* resPtr){
@@ -284,6 +321,19 @@ void PsTransposeFFTW<FLOATTYPE, NDIM>::calcBackwardFFT(const FLOATTYPE* data, FL
   }
 
 }
+
+//
+// Batch transforms use the n_fields interleaved layout of fftwnd_mpi
+//
+template <class FLOATTYPE, size_t NDIM>
+void PsTransposeFFTW<FLOATTYPE, NDIM>::transformMany(DirType dir, int nf,
+    fftw_complex* data) {
+
+  planTypeTrans fftPlan = (dir == FORWARD) ? forwardTPlan : backwardTPlan;
+
+  // FFT returned in-place to the "data" array
+  fftwnd_mpi(fftPlan, nf, data, this->batchWork, FFTW_TRANSPOSED_ORDER);
+}
 #endif // HAVE_MPI
 
 #ifndef HAVE_MPI
@@ -322,6 +372,16 @@ void PsTransposeFFTW<FLOATTYPE, NDIM>::scaledFFTPair(
   PsFFTW<FLOATTYPE, NDIM>::scaledFFTPair(data, kdata, resPtr);
 }
 
+template <class FLOATTYPE, size_t NDIM>
+void PsTransposeFFTW<FLOATTYPE, NDIM>::scaledFFTPairTwo(
+    const FLOATTYPE* data1, const FLOATTYPE* data2,
+    const FLOATTYPE* kdata, FLOATTYPE* resPtr1, FLOATTYPE* resPtr2){
+
+  // Scoping call for common serial methods
+  PsFFTW<FLOATTYPE, NDIM>::scaledFFTPairTwo(data1, data2, kdata,
+      resPtr1, resPtr2);
+}
+
 template <class FLOATTYPE, size_t NDIM>
 void PsTransposeFFTW<FLOATTYPE, NDIM>::scaledFFTPairIm(
     const FLOATTYPE* data, const FLOATTYPE* kdata, FLOATTYPE* resPtr){
@@ -345,6 +405,15 @@ void PsTransposeFFTW<FLOATTYPE, NDIM>::calcBackwardFFT(const FLOATTYPE* data, FL
   PsFFTW<FLOATTYPE, NDIM>::calcBackwardFFT(data, resPtr);
 
 }
+
+template <class FLOATTYPE, size_t NDIM>
+void PsTransposeFFTW<FLOATTYPE, NDIM>::transformMany(DirType dir, int nf,
+    fftw_complex* data) {
+
+  // Scoping call to common serial methods
+  PsFFTW<FLOATTYPE, NDIM>::transformMany(dir, nf, data);
+}
+
 #endif // SERIAL
 
 template class PsTransposeFFTW<float, 1>;
@@ -70,6 +70,30 @@ class PsTransposeFFTW : public virtual PsFFTW<FLOATTYPE, NDIM> {
  */
     virtual void buildSolvers();
 
+/**
+ * MPI transforms use FFTW_TRANSPOSED_ORDER, serial transforms
+ * are in normal order
+ */
+   virtual bool isTransposedOrder() {
+#ifdef HAVE_MPI
+     return true;
+#else
+     return false;
+#endif
+   }
+
+/**
+ * The fftwnd_mpi transforms are collective and have no
+ * workspaces, serial transforms do
+ */
+   virtual bool hasWorkspaces() {
+#ifdef HAVE_MPI
+     return false;
+#else
+     return true;
+#endif
+   }
+
 /**
  * Forward transform real input data and return |a+bi| elementwise
  *
@@ -101,6 +125,20 @@ class PsTransposeFFTW : public virtual PsFFTW<FLOATTYPE, NDIM> {
    virtual void scaledFFTPair(const FLOATTYPE* data,
        const FLOATTYPE* kdata, FLOATTYPE* resPtr);
 
+/**
+ * Perform multi-dimensional FFT pair on two REAL data sets packed
+ * into the Re/Im parts of one complex transform
+ *
+ * @param data1   pointer to first REAL data to transform
+ * @param data2   pointer to second REAL data to transform
+ * @param kdata   pointer to real, even data to scale transform
+ * @param resPtr1 pointer to first Re[result] (also supplied by caller)
+ * @param resPtr2 pointer to second Re[result] (also supplied by caller)
+ */
+   virtual void scaledFFTPairTwo(const FLOATTYPE* data1,
+       const FLOATTYPE* data2, const FLOATTYPE* kdata,
+       FLOATTYPE* resPtr1, FLOATTYPE* resPtr2);
+
 /**
  * Perform multi-dimensional FFT pair, scaling the
  * result by kdata in-between transform pair
@@ -131,6 +169,16 @@ class PsTransposeFFTW : public virtual PsFFTW<FLOATTYPE, NDIM> {
 
  protected:
 
+/**
+ * Transform nf interleaved fields in-place with one
+ * many-field (n_fields) transform
+ *
+ * @param dir  direction of transform
+ * @param nf   number of fields
+ * @param data pointer to interleaved data
+ */
+   virtual void transformMany(DirType dir, int nf, fftw_complex* data);
+
  private:
 
    /** FFTW plan for forward transforms */
@@ -198,6 +198,16 @@ class PsGrid : public PsGridBase<FLOATTYPE, NDIM> {
       throw tde;
     }
 
+/**
+ * Set size of cells in each dimension
+ *
+ * @param cs vector of cell sizes
+ */
+    virtual void setCellSizes(const std::vector<FLOATTYPE>& cs) {
+      TxDebugExcept tde("PsGrid::setCellSizes() not implemented");
+      throw tde;
+    }
+
 /**
  * Get global real lengths for each dimension of uniform Cartesian
  *
@@ -190,6 +190,29 @@ std::vector<FLOATTYPE> PsUniCartGrid<FLOATTYPE, NDIM>::getGlobalLengths() {
   return lengths;
 }
 
+//
+template <class FLOATTYPE, size_t NDIM>
+void PsUniCartGrid<FLOATTYPE, NDIM>::setCellSizes(
+    const std::vector<FLOATTYPE>& cs) {
+
+  if (cs.size() != cellSizes.size()) {
+    TxDebugExcept tde("PsUniCartGrid::setCellSizes: number of cell sizes ");
+    tde << cs.size() << " not equal to " << cellSizes.size();
+    tde << " for <Grid " << this->getName() << " >";
+    throw tde;
+  }
+
+  for (size_t idim=0; idim<cs.size(); ++idim) {
+    if (cs[idim] <= 0.0) {
+      TxDebugExcept tde("PsUniCartGrid::setCellSizes: cell size <= 0");
+      tde << " in direction " << idim << " for <Grid " << this->getName() << " >";
+      throw tde;
+    }
+  }
+
+  cellSizes = cs;
+}
+
 //
 // Take a position in global grid and return corresponding local position
 //
@@ -127,6 +127,13 @@ class PsUniCartGrid : public PsGrid<FLOATTYPE, NDIM> {
       return cellSizes;
     }
 
+/**
+ * Set size of cells in each dimension for uniform Cartesian
+ *
+ * @param cs vector of cell sizes
+ */
+    virtual void setCellSizes(const std::vector<FLOATTYPE>& cs);
+
 /**
  * Get global real lengths for each dimension of uniform Cartesian
  *
@@ -13,6 +13,9 @@
 #include <config.h>
 #endif
 
+// psstd includes
+#include <PsSpectralInterp.h>
+
 // psphysf includes
 #include <PsPhysFldFuncs.h>
 
@@ -158,8 +161,14 @@ void PsPhysFldFuncs<FLOATTYPE, NDIM>::restore(TxIoBase* txIoPtr) {
   if ((txIoPtr->fileExists(fileName)) ) {
 
     TxIoNodeType fn = txIoPtr->openFile(fileName, "r");
-    readField(txIoPtr, fn, densFieldName, this->getDensField()  );
-    readField(txIoPtr, fn, conjFieldName, this->getConjgField() );
+    if (PsDynObjBase::getRestoreRefine() > 1) {
+      readRefinedField(txIoPtr, fn, densFieldName, this->getDensField()  );
+      readRefinedField(txIoPtr, fn, conjFieldName, this->getConjgField() );
+    }
+    else {
+      readField(txIoPtr, fn, densFieldName, this->getDensField()  );
+      readField(txIoPtr, fn, conjFieldName, this->getConjgField() );
+    }
     txIoPtr->closeFile(fn);
 
   } // file exists
@@ -246,6 +255,60 @@ void PsPhysFldFuncs<FLOATTYPE, NDIM>::readField(TxIoBase* txIoPtr,
   txIoPtr->closeDataSet(dw);
 }
 
+//
+// helper method for reading a field dumped on a grid coarser by
+// restoreRefine in each direction. Every rank reads the whole coarse
+// dataset and interpolates to its own slab (zero-padded spectrum)
+//
+template <class FLOATTYPE, size_t NDIM>
+void PsPhysFldFuncs<FLOATTYPE, NDIM>::readRefinedField(TxIoBase* txIoPtr,
+    TxIoNodeType fn,
+    const std::string name,
+    PsFieldBase<FLOATTYPE>& fld) {
+
+  size_t refine = PsDynObjBase::getRestoreRefine();
+
+  // Coarse sizes, only spatial directions with more than one cell
+  std::vector<size_t> coarseSize(dataSize.size(), 1);
+  std::vector<size_t> coarseBeg(dataSize.size(), 0);
+  size_t coarseTot = 1;
+  size_t fineTot = 1;
+  for (size_t d=0; d<dataSize.size(); ++d) {
+    coarseSize[d] = dataSize[d];
+    if ( (d < idim) && (dataSize[d] > 1) ) {
+      if (dataSize[d] % refine != 0) {
+        TxDebugExcept tde("PsPhysFldFuncs::readRefinedField: cells in ");
+        tde << "direction " << d << " (" << dataSize[d] << ")";
+        tde << " not divisible by restoreRefine = " << refine;
+        tde << " for <PhysField " << this->getName() << " >";
+        throw tde;
+      }
+      coarseSize[d] = dataSize[d]/refine;
+    }
+    coarseTot *= coarseSize[d];
+    fineTot *= dataLen[d];
+  }
+
+  if (fineTot != fld.getSize()) {
+    TxDebugExcept tde("PsPhysFldFuncs::readRefinedField: field size ");
+    tde << fld.getSize() << " not equal to IO size " << fineTot;
+    tde << " for <PhysField " << this->getName() << " >";
+    throw tde;
+  }
+
+  // Whole coarse dataset on every rank
+  std::vector<FLOATTYPE> coarseData(coarseTot);
+  TxIoNodeType dw = txIoPtr->readDataSet(fn, name,
+                                         coarseBeg, coarseSize,
+                                         &coarseData[0]);
+  txIoPtr->closeDataSet(dw);
+
+  // Spectral upsample into local slab
+  PsSpectralInterp<FLOATTYPE> interp;
+  interp.setDims(coarseSize, dataSize, dataBeg, dataLen);
+  interp.interpolate(&coarseData[0], fld.getDataPtr());
+}
+
 template <class FLOATTYPE, size_t NDIM>
 void PsPhysFldFuncs<FLOATTYPE, NDIM>::appendMetaDataset(TxIoBase* txIoPtr,
                                                         TxIoNodeType fn,
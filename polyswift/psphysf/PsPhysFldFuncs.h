@@ -315,6 +315,20 @@ class PsPhysFldFuncs : public virtual PsPhysField<FLOATTYPE, NDIM> {
                    const std::string name,
                    PsFieldBase<FLOATTYPE>& fld);
 
+/**
+ * Helper method to read a field dumped on a coarser grid
+ * and interpolate it spectrally onto this grid
+ *
+ * @param txIoPtr IO object pointer
+ * @param fn file node
+ * @param name string name of dataset
+ * @param fld  reference to field data
+ */
+    void readRefinedField(TxIoBase* txIoPtr,
+                          TxIoNodeType fn,
+                          const std::string name,
+                          PsFieldBase<FLOATTYPE>& fld);
+
 /**
  * Append metadata to a dataset common to all PhysFldFuncss
  *
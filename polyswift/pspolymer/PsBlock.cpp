@@ -14,6 +14,11 @@
 #include <config.h>
 #endif
 
+// std includes
+#include <cmath>
+#include <cstring>
+#include <algorithm>
+
 // txbase includes
 #include <TxTensor.h>
 
@@ -25,6 +30,16 @@
 //
 template <class FLOATTYPE, size_t NDIM, class QTYPE>
 PsBlock<FLOATTYPE, NDIM, QTYPE>::PsBlock() {
+  checkpointQ = false;
+  ckptInterval = 1;
+  qqtStreamed = false;
+  curSeg = 0;
+  mirrorPtr = NULL;
+  dupPtr = NULL;
+  dupFlipped = false;
+  prefixPtr = NULL;
+  prefixShared = false;
+  calcStress = false;
 }
 
 //
@@ -37,10 +52,6 @@ PsBlock<FLOATTYPE, NDIM, QTYPE>::~PsBlock() {
   // so destructor should be called automatically
   qHeadJnts.clear();
   qTailJnts.clear();
-
-  // Clear propagator lists
-  qs.clear();
-  qts.clear();
 }
 
 template <class FLOATTYPE, size_t NDIM, class QTYPE>
@@ -48,6 +59,12 @@ void PsBlock<FLOATTYPE, NDIM, QTYPE>::setAttrib(const TxHierAttribSetIntDbl& tas
 
   // Scoping call to base class
   PsBlockBase<FLOATTYPE, NDIM>::setAttrib(tas);
+
+  // Keep only checkpoint slices of forward propagator
+  if (tas.hasString("checkpointQ")) {
+    std::string cStr = tas.getString("checkpointQ");
+    if (cStr == "on") checkpointQ = true;
+  }
 }
 
 template <class FLOATTYPE, size_t NDIM, class QTYPE>
@@ -126,11 +143,75 @@ void PsBlock<FLOATTYPE, NDIM, QTYPE>::buildSolvers() {
     // qTailJnts[cntIndex] = q0;
   }
 
-  // Build qs/qts vectors
+  //
+  // Build qs contour slab. The qts slab is only allocated
+  // if a TAIL solve can not be streamed (see beginSolve), two
+  // work slices are enough otherwise
+  //
   //  std::cout << "block steps = " << this->blockSteps << std::endl;
-  for (size_t n=0; n<=this->blockSteps; ++n) {
-    qs.push_back(q0);
-    qts.push_back(q0);
+  if (!this->isRemote()) qtWork.resize(2, q0.getSize());
+
+  //
+  // Checkpoint mode keeps every ckptInterval'th forward slice
+  // (~sqrt(Ns) of them) plus one segment of work slices, so
+  // forward storage goes from Ns to ~2*sqrt(Ns) slices
+  //
+  if (this->isRemote()) {
+    this->dbprt("PsBlock::buildSolvers() remote block ", this->getName());
+  }
+  else if (checkpointQ) {
+    ckptInterval = (size_t)std::ceil(std::sqrt((double)this->blockSteps));
+    if (ckptInterval < 2) ckptInterval = 2;
+    size_t numCkpts = this->blockSteps/ckptInterval + 1;
+    qs.resize(numCkpts, q0.getSize());
+    qSeg.resize(ckptInterval+1, q0.getSize());
+    this->dbprt("PsBlock::buildSolvers() checkpoint slices = ", (int)numCkpts);
+  }
+  else {
+    qs.resize(this->blockSteps+1, q0.getSize());
+  }
+
+  //
+  // Quadrature weight for each contour slice. Method: Extended
+  // Simpson's rule: for three-point interval x1 --> x3 the
+  // integral is approximated by
+  //         (1/3) * dx * [ f(x1) + 4*f(x2) + f(x3) ]
+  //
+  // For N(odd) points the overlapping ends of all the
+  // three-point intervals gives an alternating sum w/coeff
+  // of 1,4,2,4,2,4....2,4,1 (inside [])
+  //
+  // For N(even) points use same algorithm for N-1 intervals
+  // and then use trapezoidal rule for last interval.
+  //
+  size_t numSsteps = this->blockSteps + 1;
+  size_t npts = numSsteps - 1;
+  size_t numStail;
+
+  // Set even/odd flag
+  bool even = 0;
+  FLOATTYPE modval = std::fmod((FLOATTYPE)numSsteps,(FLOATTYPE)2);
+  if (modval == 0.0) {
+    even = 1;
+    numStail = npts-3;
+  }
+  else {
+    even = 0;
+    numStail = npts-2;
+  }
+
+  sWeights.assign(numSsteps, 0.0);
+  for (size_t n=0; n<=numStail; n=n+2) {
+    sWeights[n]   += 1.0;
+    sWeights[n+1] += 4.0;
+    sWeights[n+2] += 1.0;
+  }
+  for (size_t n=0; n<numSsteps; ++n)
+    sWeights[n] *= 0.33333*this->ds;
+
+  if (even) {
+    sWeights[numSsteps-2] += 0.5*this->ds;
+    sWeights[numSsteps-1] += 0.5*this->ds;
   }
 }
 
@@ -141,6 +222,10 @@ void PsBlock<FLOATTYPE, NDIM, QTYPE>::reset() {
   PsBlockBase<FLOATTYPE, NDIM>::reset();
   this->dbprt("PsBlock::reset() ");
 
+  // Decided again at next TAIL solve
+  qqtStreamed = false;
+  if (this->isRemote()) return;
+
   // Set free ends...particular to flexible or semi-flexible
   // so q0 is stored in this class but is set by derived classes
   if (this->headCntTo.size() == 0) setInitialQ(HEAD,q0);
@@ -157,22 +242,10 @@ void PsBlock<FLOATTYPE, NDIM, QTYPE>::setPhysFields() {
   this->dbprt("... updating the densities in physField ",
               this->monoDensPhysFldPtr->getName() );
 
-  // Find model correction for a distribution of blocks
-  // For non-polydisperse models this will be 1.0.
-  // For polydisperse blocks in polydisperse models this
-  // will be the quadrature weight/normalization
-  FLOATTYPE densWt = this->getDensityWeight();
-
   // Update monomer densities... this method must "ADD" for multiple chains
-  // qqtIntegral includes bigQ normalization
   // Assumes that the density fields have been appropriately
   // initialized to zero, so they may act as counters.
-  FLOATTYPE vf = this->polymerObjPtr->getVolfrac();
-
-  // Set density
-  FLOATTYPE densFac = densWt*vf/(this->polymerObjPtr->getLengthRatio());
-  qqtDens = qqtIntegral;
-  qqtDens.scale(densFac);
+  calcDensity();
 
   // If tracking single block density then set field
   if (this->hasBlockField) {
@@ -195,6 +268,47 @@ void PsBlock<FLOATTYPE, NDIM, QTYPE>::setPhysFields() {
   maskField += 1.0;
 }
 
+//
+// Monomer density from qqtIntegral, which includes bigQ normalization
+//
+template <class FLOATTYPE, size_t NDIM, class QTYPE>
+const FLOATTYPE* PsBlock<FLOATTYPE, NDIM, QTYPE>::calcDensity() {
+
+  // Find model correction for a distribution of blocks
+  // For non-polydisperse models this will be 1.0.
+  // For polydisperse blocks in polydisperse models this
+  // will be the quadrature weight/normalization
+  FLOATTYPE densWt = this->getDensityWeight();
+  FLOATTYPE vf = this->polymerObjPtr->getVolfrac();
+
+  // Set density
+  FLOATTYPE densFac = densWt*vf/(this->polymerObjPtr->getLengthRatio());
+  // Duplicate arms take the representative's integral
+  if (dupPtr) qqtDens = dupPtr->qqtIntegral;
+  else        qqtDens = qqtIntegral;
+  qqtDens.scale(densFac);
+
+  return qqtDens.getConstDataPtr();
+}
+
+//
+// Same as setPhysFields for a density combined by the polymer,
+// sized as the simulation grid PhysFields
+//
+template <class FLOATTYPE, size_t NDIM, class QTYPE>
+void PsBlock<FLOATTYPE, NDIM, QTYPE>::addDensity(const FLOATTYPE* densData) {
+
+  if (this->hasBlockField) {
+    PsFieldBase<FLOATTYPE>& blockField = this->blockDensPhysFldPtr->getDensField();
+    FLOATTYPE* blockPtr = blockField.getDataPtr();
+    for (size_t n=0; n<blockField.getSize(); ++n) blockPtr[n] = densData[n];
+  }
+
+  PsFieldBase<FLOATTYPE>& densField = this->monoDensPhysFldPtr->getDensField();
+  FLOATTYPE* densPtr = densField.getDataPtr();
+  for (size_t n=0; n<densField.getSize(); ++n) densPtr[n] += densData[n];
+}
+
 //
 // This integrates q(r,s')*qt(r,s')*dr over volume where s'
 // is a specific location on the block. This is needed to
@@ -216,8 +330,7 @@ FLOATTYPE PsBlock<FLOATTYPE, NDIM, QTYPE>::calcBigQ() {
 
   // Get total volume (less constraint volume)
   size_t fieldSize = qHeadInitial.getSize(); // SWS: volume
-  FLOATTYPE localVol =
-    FLOATTYPE(fieldSize) - this->constraintFieldPtr->calcLocalVolume();
+  FLOATTYPE localVol = FLOATTYPE(fieldSize) - this->getWallVolume();
 
   // Sum for bigQ over all ranks
   size_t nprocs = this->getCommBase().getSize();
@@ -237,146 +350,310 @@ FLOATTYPE PsBlock<FLOATTYPE, NDIM, QTYPE>::calcBigQ() {
 }
 
 //
-// This collapses q(r,s)*qt(r,s) over s. To be used by
-// many observables' calculations.
-//
-// Method: Extended Simpson's rule:
-//         For three-point interval x1 --> x3 the integral is
-//         approximated by
-//         (1/3) * dx * [ f(x1) + 4*f(x2) + f(x3) ]
-//
-//         For N(odd) points the overlapping ends of all the
-//         three-point intervals gives an alternating sum w/coeff
-//         of 1,4,2,4,2,4....2,4,1 (inside [])
-//
-//         For N(even) points use same algorithm for N-1 intervals
-//         and then use trapezoidal rule for last interval.
+// This collapses q(r,s)*qt(r,s) over s with the Simpson weights
+// set in buildSolvers. To be used by many observables' calculations.
+// If the TAIL solve was streamed the sum is already in qqtIntegral
+// and only the normalization is left.
 //
 template <class FLOATTYPE, size_t NDIM, class QTYPE>
 void PsBlock<FLOATTYPE, NDIM, QTYPE>::setCalcQQTIntegral(FLOATTYPE bQ) {
 
   this->dbprt("calling PsBlock::setCalcQQTIntegral ");
 
-  // Local q data holders
-  QTYPE q1;
-  QTYPE q2;
-  QTYPE q3;
-  QTYPE qt1;
-  QTYPE qt2;
-  QTYPE qt3;
+  // Duplicate arm, integral is read from representative in setPhysFields
+  if (dupPtr) return;
+
+  // A prefix block reads both propagators off the longer block
+  PsBlock<FLOATTYPE, NDIM, QTYPE>* srcPtr = (prefixPtr) ? prefixPtr : this;
+
+  if (!qqtStreamed) {
+
+    //  qqtIntegral.reset(0.0);
+    PsFieldBase<FLOATTYPE>& qqB = *(qqtIntegral.getBasePtr());
+    qqB.reset(0.0);
+    if (calcStress) stressSums.assign(stressSums.size(), 0.0);
+
+    //
+    // Sum q(X,s)*qt(X,N-s) reading slices in place,
+    // flips the order on qt 'by hand'. For a mirror block
+    // qt(X,s) is the mirror's forward q(X,s), for a prefix
+    // block N is this block's length in the longer slabs
+    //
+    size_t numSsteps = this->blockSteps + 1;
+    curSeg = numSsteps;
+    for (size_t n=0; n<numSsteps; ++n) {
+      if (sWeights[n] == 0.0) continue;
+      const FLOATTYPE* qt = (mirrorPtr) ?
+        mirrorPtr->getForwardSlice(numSsteps-n-1) :
+        srcPtr->qts.getSlice(numSsteps-n-1);
+      addQQTSlice(sWeights[n], srcPtr->getForwardSlice(n), qt);
+    }
+  }
 
-  PsGridBaseItr* gItr = &this->getGridBase();
-  q1.setGrid(gItr);
-  q2.setGrid(gItr);
-  q3.setGrid(gItr);
-  qt1.setGrid(gItr);
-  qt2.setGrid(gItr);
-  qt3.setGrid(gItr);
-
-  // Assuming q(X) are same size for all s
-  size_t numSsteps = qs.size();
-  size_t npts = numSsteps - 1;
-  size_t numStail;
+  // Include normalization bigQ factor
+  qqtIntegral.scale(1.0/bQ);
 
-  // Set even/odd flag
-  bool even = 0;
-  FLOATTYPE modval = std::fmod((FLOATTYPE)numSsteps,(FLOATTYPE)2);
-  if (modval == 0.0) {
-    even = 1;
-    numStail = npts-3;
+  // Box-length derivatives, summed over ranks and normalized the same way
+  if (calcStress) {
+    stress.assign(stressSums.size(), 0.0);
+    this->getCommBase().allReduceSumVec(&stressSums[0], stressSums.size(),
+                                        &stress[0]);
+    for (size_t i=0; i<stress.size(); ++i) stress[i] /= bQ;
+  }
+}
+
+//
+// Prepare storage before a solve from end. A TAIL solve is streamed
+// into qqtIntegral if the HEAD solve for this update is already done
+// (its final q at the TAIL is set), which is the usual order for the
+// PsBlockCopolymer update loop. Otherwise, or if prefix blocks read
+// the slabs, the qts slab is used.
+//
+template <class FLOATTYPE, size_t NDIM, class QTYPE>
+void PsBlock<FLOATTYPE, NDIM, QTYPE>::beginSolve(BlockEndType end) {
+
+  if (end == HEAD) return;
+
+  if (this->qTailFinalSet && !prefixShared) {
+    qqtStreamed = true;
+    curSeg = this->blockSteps + 1;
+    PsFieldBase<FLOATTYPE>& qqB = *(qqtIntegral.getBasePtr());
+    qqB.reset(0.0);
+    if (calcStress) stressSums.assign(stressSums.size(), 0.0);
   }
   else {
-    even = 0;
-    numStail = npts-2;
+    qqtStreamed = false;
+    if (qts.getNumSlices() == 0) {
+      this->dbprt("PsBlock::beginSolve() allocating qts for ", this->getName());
+      qts.resize(this->blockSteps+1, q0.getSize());
+    }
+  }
+}
+
+//
+// Storage for contour step ss of the propagator solved from end.
+// Without checkpoints this is just the slab slice. With checkpoints
+// the forward steps on an interval boundary go to the checkpoint
+// slab and all others alternate between two qSeg scratch slices,
+// which never overwrites the slice the solver reads from. Streamed
+// TAIL solves alternate between the two qtWork slices the same way.
+//
+template <class FLOATTYPE, size_t NDIM, class QTYPE>
+FLOATTYPE* PsBlock<FLOATTYPE, NDIM, QTYPE>::getSolveSlice(BlockEndType end,
+                                                         size_t ss) {
+  if (end == TAIL) {
+    if (qqtStreamed) return qtWork.getSlice(ss % 2);
+    return qts.getSlice(ss);
   }
+  if (!checkpointQ) return qs.getSlice(ss);
+
+  if (ss % ckptInterval == 0)
+    return qs.getSlice(ss/ckptInterval);
+  else
+    return qSeg.getSlice(ss % 2);
+}
+
+//
+// Add qt(X,ss)*q(X,N-ss) to the running contour integral
+// once the solver has finished step ss of a streamed TAIL solve
+//
+template <class FLOATTYPE, size_t NDIM, class QTYPE>
+void PsBlock<FLOATTYPE, NDIM, QTYPE>::endSolveStep(BlockEndType end,
+                                                  size_t ss) {
 
-  // Should check that qs and qts same size,
-  // will be changed when size is explicitly set
-  // Flips the order on qt 'by hand'
-  size_t step1, step2, step3, stept1, stept2, stept3;
+  if (end == HEAD || !qqtStreamed) return;
 
-  //  qqtIntegral.reset(0.0);
-  PsFieldBase<FLOATTYPE>& qqB = *(qqtIntegral.getBasePtr());
-  qqB.reset(0.0);
+  size_t n = this->blockSteps - ss;
+  if (sWeights[n] == 0.0) return;
+  addQQTSlice(sWeights[n], getForwardSlice(n), qtWork.getSlice(ss % 2));
+}
 
-  // Sum over sets of length 3 intervals
-  for (size_t n=0; n<=numStail; n=n+2) {
+//
+// Forward slice q(X,n). With checkpoints the segment holding n is
+// recomputed from its checkpoint with stepQ into qSeg, and kept
+// there until a slice from another segment is asked for, so both
+// ascending and descending sweeps recompute each segment once.
+//
+template <class FLOATTYPE, size_t NDIM, class QTYPE>
+const FLOATTYPE* PsBlock<FLOATTYPE, NDIM, QTYPE>::getForwardSlice(size_t n) {
+
+  if (!checkpointQ) return qs.getSlice(n);
+  if (n % ckptInterval == 0) return qs.getSlice(n/ckptInterval);
+
+  size_t seg = n/ckptInterval;
+  if (seg != curSeg) {
+    size_t s0 = seg*ckptInterval;
+    size_t s1 = std::min(s0+ckptInterval-1, (size_t)this->blockSteps);
+    qSeg.setSlice(0, qs.getSlice(seg));
+    for (size_t s=s0+1; s<=s1; ++s)
+      stepQ(qSeg.getSlice(s-s0-1), qSeg.getSlice(s-s0));
+    curSeg = seg;
+  }
+
+  return qSeg.getSlice(n - seg*ckptInterval);
+}
+
+//
+// Mirror blocks must have the same number of steps (see isEquivalentTo)
+//
+template <class FLOATTYPE, size_t NDIM, class QTYPE>
+bool PsBlock<FLOATTYPE, NDIM, QTYPE>::setMirror(
+     PsBlockBase<FLOATTYPE, NDIM>* mb) {
 
-    step1 = n;
-    step2 = n+1;
-    step3 = n+2;
-
-    stept1 = numSsteps-n-1;
-    stept2 = numSsteps-n-2;
-    stept3 = numSsteps-n-3;
-
-    q1  = qs[step1];   q2  = qs[step2];   q3  = qs[step3];
-    qt1 = qts[stept1]; qt2 = qts[stept2]; qt3 = qts[stept3];
-
-    // Update over field variables sum on i
-    // Old: size_t fieldSize = qs[0].get Size();
-    /* for (size_t i=0; i<fieldSize; ++i) {
-        qqtIntegral(i) = qqtIntegral(i) +
-          (0.33333 * this->ds) * (
-            ( 1.0 * q1(i)*qt1(i) ) +
-            ( 4.0 * q2(i)*qt2(i) ) +
-            ( 1.0 * q3(i)*qt3(i) ) );
-    } */
-
-    PsFieldBase<FLOATTYPE>& q1B = *(q1.getBasePtr());
-    PsFieldBase<FLOATTYPE>& q2B = *(q2.getBasePtr());
-    PsFieldBase<FLOATTYPE>& q3B = *(q3.getBasePtr());
-    PsFieldBase<FLOATTYPE>& qt1B = *(qt1.getBasePtr());
-    PsFieldBase<FLOATTYPE>& qt2B = *(qt2.getBasePtr());
-    PsFieldBase<FLOATTYPE>& qt3B = *(qt3.getBasePtr());
-
-    q1B *= qt1B; q2B *= qt2B; q3B *= qt3B;
-    q2B *= 4.0;
-    qqB += q1B; qqB += q2B; qqB += q3B;
+  if (!mb) {
+    mirrorPtr = NULL;
+    return true;
   }
-  qqB *= 0.33333*this->ds;
 
-  // Add one trapezoidal interval at the end
-  // of even sized list
-  if (even) {
+  PsBlock<FLOATTYPE, NDIM, QTYPE>* mp =
+    dynamic_cast<PsBlock<FLOATTYPE, NDIM, QTYPE>*>(mb);
+  if (!mp || checkpointQ || mp->checkpointQ) return false;
+  if (mp->blockSteps != this->blockSteps) return false;
 
-    step1 = numSsteps-2;
-    step2 = numSsteps-1;
-
-    stept1 = 1;
-    stept2 = 0;
-
-    q1  = qs[step1];   q2  = qs[step2];
-    qt1 = qts[stept1]; qt2 = qts[stept2];
-
-    // Update over field variables
-    // Old: size_t fieldSize = qs[0].get Size();
-    /* for (size_t i=0; i<fieldSize; ++i) {
-        qqtIntegral(i) = qqtIntegral(i) +
-         0.50 * (
-         ( q1(i)*qt1(i)*this->ds ) +
-         ( q2(i)*qt2(i)*this->ds ) );
-     } */
-
-    PsFieldBase<FLOATTYPE>& q1B = *(q1.getBasePtr());
-    PsFieldBase<FLOATTYPE>& q2B = *(q2.getBasePtr());
-    PsFieldBase<FLOATTYPE>& qt1B = *(qt1.getBasePtr());
-    PsFieldBase<FLOATTYPE>& qt2B = *(qt2.getBasePtr());
-
-    // Reuse tmp q3 variable for counter
-    PsFieldBase<FLOATTYPE>& qTB = *(q3.getBasePtr());
-    qTB.reset(0.0);
-
-    q1B *= qt1B;
-    q2B *= qt2B;
-    qTB += q1B;
-    qTB += q2B;
-    qTB *= this->ds*0.5;
-    qqB += qTB;
-  } // if even
+  mirrorPtr = mp;
+  return true;
+}
 
-  // Include normalization bigQ factor
-  qqtIntegral.scale(1.0/bQ);
+//
+// Same as the result of solveQ(TAIL) for a mirror-symmetric chain
+//
+template <class FLOATTYPE, size_t NDIM, class QTYPE>
+void PsBlock<FLOATTYPE, NDIM, QTYPE>::setMirrorFinalQ() {
+
+  if (!mirrorPtr) {
+    TxDebugExcept tde("PsBlock::setMirrorFinalQ: mirror block not set");
+    tde << " in <Block " << this->getName() << " >";
+    throw tde;
+  }
+
+  qqtStreamed = false;
+  setFinalQ(HEAD, mirrorPtr->qTailFinal);
+}
+
+//
+// Duplicate arms need no propagator storage of their own
+//
+template <class FLOATTYPE, size_t NDIM, class QTYPE>
+bool PsBlock<FLOATTYPE, NDIM, QTYPE>::setDuplicateOf(
+     PsBlockBase<FLOATTYPE, NDIM>* rb, bool flipEnds) {
+
+  PsBlock<FLOATTYPE, NDIM, QTYPE>* rp =
+    dynamic_cast<PsBlock<FLOATTYPE, NDIM, QTYPE>*>(rb);
+  if (!rp || rp == this || rp->dupPtr || mirrorPtr) return false;
+
+  dupPtr = rp;
+  dupFlipped = flipEnds;
+
+  qs.resize(0, 0);
+  qts.resize(0, 0);
+  qSeg.resize(0, 0);
+  qtWork.resize(0, 0);
+
+  this->dbprt("PsBlock::setDuplicateOf() duplicate of ", rp->getName());
+  return true;
+}
+
+//
+// Same as the result of solving from the other end of this block
+//
+template <class FLOATTYPE, size_t NDIM, class QTYPE>
+void PsBlock<FLOATTYPE, NDIM, QTYPE>::copyDuplicateFinalQ(BlockEndType end) {
+
+  if (!dupPtr) {
+    TxDebugExcept tde("PsBlock::copyDuplicateFinalQ: representative not set");
+    tde << " in <Block " << this->getName() << " >";
+    throw tde;
+  }
+
+  BlockEndType repEnd = end;
+  if (dupFlipped) repEnd = this->getOtherEnd(end);
+
+  if (repEnd == HEAD) setFinalQ(end, dupPtr->qHeadFinal);
+  else                setFinalQ(end, dupPtr->qTailFinal);
+}
+
+//
+// Propagators of the same solver from the same initial q agree
+// over the shorter length, so this block's slices are the first
+// blockSteps+1 of the longer block's
+//
+template <class FLOATTYPE, size_t NDIM, class QTYPE>
+bool PsBlock<FLOATTYPE, NDIM, QTYPE>::setPrefixOf(
+     PsBlockBase<FLOATTYPE, NDIM>* lb) {
+
+  PsBlock<FLOATTYPE, NDIM, QTYPE>* lp =
+    dynamic_cast<PsBlock<FLOATTYPE, NDIM, QTYPE>*>(lb);
+  if (!lp || lp == this || lp->prefixPtr || prefixShared) return false;
+  if (mirrorPtr || dupPtr || lp->mirrorPtr || lp->dupPtr) return false;
+  if (checkpointQ || lp->checkpointQ) return false;
+  if (lp->blockSteps < this->blockSteps) return false;
+  if (!this->hasSameSolver(lb)) return false;
+
+  prefixPtr = lp;
+  lp->prefixShared = true;
+
+  qs.resize(0, 0);
+  qts.resize(0, 0);
+
+  this->dbprt("PsBlock::setPrefixOf() prefix of ", lp->getName());
+  return true;
+}
+
+//
+// Same as the results of solveQ(HEAD) and solveQ(TAIL), the longer
+// block's slabs hold this block's propagators at slice blockSteps
+//
+template <class FLOATTYPE, size_t NDIM, class QTYPE>
+void PsBlock<FLOATTYPE, NDIM, QTYPE>::setPrefixFinalQ() {
+
+  if (!prefixPtr) {
+    TxDebugExcept tde("PsBlock::setPrefixFinalQ: longer block not set");
+    tde << " in <Block " << this->getName() << " >";
+    throw tde;
+  }
+
+  size_t ns = this->blockSteps;
+  size_t nbytes = prefixPtr->qs.getSliceSize()*sizeof(FLOATTYPE);
+  FLOATTYPE* qData = qprod.getBasePtr()->getDataPtr();
+
+  std::memcpy(qData, prefixPtr->qs.getSlice(ns), nbytes);
+  setFinalQ(TAIL, qprod);
+
+  std::memcpy(qData, prefixPtr->qts.getSlice(ns), nbytes);
+  setFinalQ(HEAD, qprod);
+}
+
+//
+// Set in setCalcQQTIntegral, duplicate arms are never integrated
+//
+template <class FLOATTYPE, size_t NDIM, class QTYPE>
+std::vector<FLOATTYPE> PsBlock<FLOATTYPE, NDIM, QTYPE>::getStress() {
+
+  if (dupPtr) return dupPtr->getStress();
+
+  if (!calcStress) {
+    TxDebugExcept tde("PsBlock::getStress: setCalcStress not on");
+    tde << " in <Block " << this->getName() << " >";
+    throw tde;
+  }
+
+  return stress;
+}
+
+//
+// Weighted sum qqtIntegral += wt*q*qt for one contour slice
+//
+template <class FLOATTYPE, size_t NDIM, class QTYPE>
+void PsBlock<FLOATTYPE, NDIM, QTYPE>::addQQTSlice(FLOATTYPE wt,
+                                                 const FLOATTYPE* q,
+                                                 const FLOATTYPE* qt) {
+
+  FLOATTYPE* qqData = qqtIntegral.getBasePtr()->getDataPtr();
+  size_t sliceSize = qtWork.getSliceSize();
+  for (size_t i=0; i<sliceSize; ++i)
+    qqData[i] += wt*q[i]*qt[i];
+
+  if (calcStress) addStressSlice(wt, q, qt);
 }
 
 //
@@ -16,6 +16,7 @@
 // standard headers
 #include <list>
 #include <map>
+#include <vector>
 
 // configure stuff
 #ifdef HAVE_CONFIG_H
@@ -28,6 +29,7 @@
 
 // pspolymer includes
 #include <PsBlockBase.h>
+#include <PsPropagatorSlab.h>
 
 /**
  * A PsBlock object contains the spatial part of a block.
@@ -100,6 +102,20 @@ class PsBlock : public virtual PsBlockBase<FLOATTYPE, NDIM> {
  */
     virtual void setPhysFields();
 
+/**
+ * Scale the qqtIntegral result to the block monomer density
+ *
+ * @return density data (qqtDens)
+ */
+    virtual const FLOATTYPE* calcDensity();
+
+/**
+ * Add a block density on the simulation grid to the held PhysFields
+ *
+ * @param densData local part of the block density
+ */
+    virtual void addDensity(const FLOATTYPE* densData);
+
 /**
  * Get final q(X) field for head/tail
  *
@@ -131,6 +147,65 @@ class PsBlock : public virtual PsBlockBase<FLOATTYPE, NDIM> {
  */
     virtual void combineSetJnt(BlockEndType end);
 
+/**
+ * Serve the tail-solved propagator qt(X,s) of this block from the
+ * head-solved q(X,s) of mirror block mb. Not available with
+ * checkpointQ, because both slabs are read at the same time.
+ *
+ * @param mb pointer to mirror block (NULL to unset)
+ * @return true if mirror is set
+ */
+    virtual bool setMirror(PsBlockBase<FLOATTYPE, NDIM>* mb);
+
+/**
+ * Set final q at head from the mirror block's final q at tail
+ */
+    virtual void setMirrorFinalQ();
+
+/**
+ * Make this block a duplicate of the equivalent arm rb: it is not
+ * solved, its final q values and qqt integral are those of rb.
+ * Propagator storage of this block is released.
+ *
+ * @param rb       pointer to representative block
+ * @param flipEnds true if this block's HEAD corresponds to rb's TAIL
+ * @return true if duplicate is set
+ */
+    virtual bool setDuplicateOf(PsBlockBase<FLOATTYPE, NDIM>* rb,
+                                bool flipEnds);
+
+/**
+ * Set final q at end from the representative block, in place
+ * of a solve that starts at the other end
+ *
+ * @param end endtype of this block to set
+ */
+    virtual void copyDuplicateFinalQ(BlockEndType end);
+
+/**
+ * Make this block a prefix of the longer block lb: it is not solved,
+ * its propagators are the first blockSteps+1 slices of lb's. Needs
+ * the same solver (see hasSameSolver) and no checkpointQ on either.
+ * Propagator storage of this block is released.
+ *
+ * @param lb pointer to longer block
+ * @return true if prefix is set
+ */
+    virtual bool setPrefixOf(PsBlockBase<FLOATTYPE, NDIM>* lb);
+
+/**
+ * Set final q at both ends from the longer block's slices
+ */
+    virtual void setPrefixFinalQ();
+
+/**
+ * Get this block's part of L_i d(log bigQ)/dL_i, a duplicate arm
+ * returns its representative's
+ *
+ * @return vector of derivatives, one per grid direction
+ */
+    virtual std::vector<FLOATTYPE> getStress();
+
   protected:
 
     // SWS: set by derived, for build-cycle purposes ??
@@ -143,11 +218,98 @@ class PsBlock : public virtual PsBlockBase<FLOATTYPE, NDIM> {
     /** Work space for initial q values */
     QTYPE q0;
 
-    /** "Forward" q(s,X) propagator: for flexible --> q(r,s) */
-    std::vector< QTYPE > qs;
+    /**
+     * "Forward" q(s,X) propagator: for flexible --> q(r,s)
+     * One contiguous slab of (blockSteps+1) contour slices
+     */
+    PsPropagatorSlab<FLOATTYPE> qs;
 
-    /** "Backward" q(s,X) propagator for flexible --> qt(r,s) */
-    std::vector< QTYPE > qts;
+    /**
+     * "Backward" q(s,X) propagator for flexible --> qt(r,s)
+     * One contiguous slab of (blockSteps+1) contour slices, only
+     * allocated if a TAIL solve can not be streamed into qqtIntegral
+     */
+    PsPropagatorSlab<FLOATTYPE> qts;
+
+    /**
+     * Flag for checkpointed q(s,X): only every ckptInterval'th slice
+     * of the forward propagator is kept and the slices in between
+     * are recomputed segment by segment for the qqt integral
+     */
+    bool checkpointQ;
+
+    /** Number of contour steps between forward checkpoint slices */
+    size_t ckptInterval;
+
+    /**
+     * Work slices for one recomputed segment of q(s,X) in checkpoint
+     * mode, also used as scratch during the forward solve
+     */
+    PsPropagatorSlab<FLOATTYPE> qSeg;
+
+/**
+ * Prepare storage before solving the propagator from end. Decides
+ * if a TAIL solve is streamed into the qqt integral
+ *
+ * @param end endtype the solve starts from
+ */
+    void beginSolve(BlockEndType end);
+
+/**
+ * Get storage for contour step ss of the propagator solved from end.
+ * Solvers write each step here and may read the previous pointer
+ * back as the input to the next step.
+ *
+ * @param end endtype the solve started from
+ * @param ss  contour step index (0 is the initial condition)
+ * @return pointer to slice for step ss
+ */
+    FLOATTYPE* getSolveSlice(BlockEndType end, size_t ss);
+
+/**
+ * Signal that contour step ss (from getSolveSlice) is finished.
+ * For a streamed TAIL solve this adds its Simpson-weighted
+ * q*qt term to the qqt integral
+ *
+ * @param end endtype the solve started from
+ * @param ss  contour step index
+ */
+    void endSolveStep(BlockEndType end, size_t ss);
+
+/**
+ * Advance a propagator one contour step ds. Only needed by
+ * block models that support checkpointQ
+ *
+ * @param qin  pointer to q(X,s)
+ * @param qout pointer to q(X,s+ds) (supplied by caller)
+ */
+    virtual void stepQ(const FLOATTYPE* qin, FLOATTYPE* qout) {
+      TxDebugExcept tde("PsBlock::stepQ: not implemented for block model");
+      tde << " in <Block " << this->getName() << " >";
+      throw tde;
+    }
+
+/**
+ * Add the contour slice term of the box-length derivatives of
+ * bigQ into stressSums. Only needed by block models that
+ * support setCalcStress
+ *
+ * @param wt quadrature weight
+ * @param q  pointer to forward slice
+ * @param qt pointer to backward slice
+ */
+    virtual void addStressSlice(FLOATTYPE wt, const FLOATTYPE* q,
+                                const FLOATTYPE* qt) {
+      TxDebugExcept tde("PsBlock::addStressSlice: not implemented");
+      tde << " in <Block " << this->getName() << " >";
+      throw tde;
+    }
+
+    /** Flag for box-length derivatives in setCalcQQTIntegral */
+    bool calcStress;
+
+    /** Local sums for box-length derivatives, one per grid direction */
+    std::vector<FLOATTYPE> stressSums;
 
 /**
  * Get initial condition for q for head/tail
@@ -181,6 +343,53 @@ class PsBlock : public virtual PsBlockBase<FLOATTYPE, NDIM> {
 
   private:
 
+    /** Simpson/trapezoid quadrature weight for each contour slice */
+    std::vector<FLOATTYPE> sWeights;
+
+    /** Flag for qqtIntegral summed during this update's TAIL solve */
+    bool qqtStreamed;
+
+    /** Checkpoint segment currently recomputed in qSeg */
+    size_t curSeg;
+
+    /** Two work slices for a streamed TAIL solve */
+    PsPropagatorSlab<FLOATTYPE> qtWork;
+
+    /** Mirror block whose q(X,s) is this block's qt(X,s) (or NULL) */
+    PsBlock<FLOATTYPE, NDIM, QTYPE>* mirrorPtr;
+
+    /** Representative block if this block is a duplicate arm (or NULL) */
+    PsBlock<FLOATTYPE, NDIM, QTYPE>* dupPtr;
+
+    /** Flag for duplicate arm oriented opposite to representative */
+    bool dupFlipped;
+
+    /** Longer block whose propagators this block reads (or NULL) */
+    PsBlock<FLOATTYPE, NDIM, QTYPE>* prefixPtr;
+
+    /** Flag for slabs read by prefix blocks, qt(X,s) is never streamed */
+    bool prefixShared;
+
+    /** Box-length derivatives of log(bigQ) from last update */
+    std::vector<FLOATTYPE> stress;
+
+/**
+ * Get forward slice q(X,n), recomputed from checkpoints if needed
+ *
+ * @param n contour slice index
+ * @return pointer to slice n
+ */
+    const FLOATTYPE* getForwardSlice(size_t n);
+
+/**
+ * Add wt*q*qt to qqtIntegral
+ *
+ * @param wt quadrature weight
+ * @param q  pointer to forward slice
+ * @param qt pointer to backward slice
+ */
+    void addQQTSlice(FLOATTYPE wt, const FLOATTYPE* q, const FLOATTYPE* qt);
+
     /** Result holder for junctions */
     QTYPE qInit;
 
@@ -19,10 +19,16 @@
 // std includes
 #include <string>
 #include <sstream>
+#include <set>
+#include <functional>
 
 // Constructor
 template <class FLOATTYPE, size_t NDIM>
-PsBlockCopolymer<FLOATTYPE, NDIM>::PsBlockCopolymer() {}
+PsBlockCopolymer<FLOATTYPE, NDIM>::PsBlockCopolymer() {
+  numThreads = 1;
+  mirrorSolve = true;
+  dedupArms = true;
+}
 
 // Destructor
 template <class FLOATTYPE, size_t NDIM>
@@ -61,6 +67,24 @@ setAttrib(const TxHierAttribSetIntDbl& tas) {
     this->pprt("Found <Block ", blockNames[n], " >");
   }
 
+  // Solve one direction only for mirror-symmetric chains
+  if (tas.hasString("mirrorSolve")) {
+    std::string mStr = tas.getString("mirrorSolve");
+    if (mStr == "off") mirrorSolve = false;
+  }
+
+  // Threads for solving independent block ends concurrently
+  if (tas.hasOption("numThreads")) {
+    int nThreads = tas.getOption("numThreads");
+    if (nThreads > 1) numThreads = (size_t)nThreads;
+  }
+
+  // Solve equivalent star/branch arms once
+  if (tas.hasString("dedupArms")) {
+    std::string dStr = tas.getString("dedupArms");
+    if (dStr == "off") dedupArms = false;
+  }
+
 }
 
 template <class FLOATTYPE, size_t NDIM>
@@ -148,6 +172,151 @@ void PsBlockCopolymer<FLOATTYPE, NDIM>::buildSolvers() {
     buildCntBlockType(iblock,TAIL);
   }
 
+  // No prefix blocks unless set by derived containers, and no
+  // duplicate arms unless found below
+  prefixRep.resize(numBlocks);
+  armRep.resize(numBlocks);
+  armFlip.assign(numBlocks, false);
+  for (size_t i=0; i<numBlocks; ++i) {
+    prefixRep[i] = i;
+    armRep[i] = i;
+  }
+
+  // Pair blocks with their mirror images, or else
+  // find duplicate arms of stars/branched polymers
+  buildMirrorSymmetry();
+  if (mirrorOrder.size() == 0) buildArmDuplicates();
+
+  //
+  // Concurrent block solves need a transform workspace for each
+  // solved block. The distributed FFTW transforms are collective on
+  // one communicator and have none, so blocks on them are solved
+  // one at a time
+  //
+  if (numThreads > 1) {
+    size_t numConcurrent = 0;
+    for (size_t i=0; i<numBlocks; ++i) {
+      if (armRep[i] != i || blocks[i]->isRemote()) continue;
+      if (blocks[i]->buildSolveWorkspace()) numConcurrent++;
+    }
+    if (numConcurrent < 2) {
+      this->pprt("PsBlockCopolymer: numThreads ignored, blocks can not ",
+                 "be solved concurrently in <Polymer ", this->getName(), " >");
+      numThreads = 1;
+    }
+  }
+  threadPool.setNumThreads(numThreads);
+}
+
+//
+// An arm is a block with one free end. Arms joined at their other
+// end to the same junction that are equivalent (see
+// PsBlockBase::isEquivalentTo) see the same fields from both ends,
+// so their propagators are the same. The first one found is solved
+// and the others copy its final q values and density. Only
+// single-block arms are matched, arms of several blocks and
+// equivalent sub-trees are solved for each copy.
+//
+template <class FLOATTYPE, size_t NDIM>
+void PsBlockCopolymer<FLOATTYPE, NDIM>::buildArmDuplicates() {
+
+  if (!dedupArms) return;
+
+  // Free end of each arm (2 marks a non-arm)
+  std::vector<size_t> armFree(numBlocks, 2);
+  for (size_t i=0; i<numBlocks; ++i) {
+    bool freeHead = (blocks[i]->getCntTo(HEAD).size() == 0);
+    bool freeTail = (blocks[i]->getCntTo(TAIL).size() == 0);
+    if (freeHead && !freeTail) armFree[i] = HEAD;
+    if (freeTail && !freeHead) armFree[i] = TAIL;
+  }
+
+  for (size_t i=0; i<numBlocks; ++i) {
+
+    if (armFree[i] == 2 || armRep[i] != i) continue;
+
+    // Arms connected to the junction end of arm i
+    BlockEndType freeEnd = (BlockEndType)armFree[i];
+    BlockEndType jntEnd  = blocks[i]->getOtherEnd(freeEnd);
+    std::vector<std::pair<size_t, BlockEndType> > cntTo =
+      blocks[i]->getCntTo(jntEnd);
+
+    for (size_t n=0; n<cntTo.size(); ++n) {
+
+      size_t j = cntTo[n].first;
+      if (j <= i || armFree[j] == 2 || armRep[j] != j) continue;
+
+      BlockEndType jFreeEnd = (BlockEndType)armFree[j];
+      if (cntTo[n].second == jFreeEnd) continue;
+      if (!blocks[j]->isEquivalentTo(blocks[i])) continue;
+
+      bool flip = (jFreeEnd != freeEnd);
+      if (blocks[j]->setDuplicateOf(blocks[i], flip)) {
+        armRep[j] = i;
+        armFlip[j] = flip;
+        this->pprt("Block ", blockNames[j], " duplicates arm ", blockNames[i]);
+      }
+    }
+  }
+}
+
+//
+// A linear chain joined tail-->head from one free head to one
+// free tail is mirror-symmetric if block n and block (N-1-n) along
+// the chain are the same (see PsBlockBase::isEquivalentTo). Then the
+// tail-solved propagators are the head-solved ones of the mirror
+// blocks, eg. A-B-A triblocks and homopolymers
+//
+template <class FLOATTYPE, size_t NDIM>
+void PsBlockCopolymer<FLOATTYPE, NDIM>::buildMirrorSymmetry() {
+
+  mirrorOrder.clear();
+  if (!mirrorSolve) return;
+
+  // Find the single free head
+  size_t startBlock = numBlocks;
+  size_t numFreeHeads = 0;
+  for (size_t i=0; i<numBlocks; ++i) {
+    if (blocks[i]->getCntTo(HEAD).size() == 0) {
+      startBlock = i;
+      numFreeHeads++;
+    }
+  }
+  if (numFreeHeads != 1) return;
+
+  // Walk chain, each tail joined to exactly one head
+  std::vector<size_t> order;
+  size_t iblock = startBlock;
+  while (order.size() < numBlocks) {
+    order.push_back(iblock);
+    std::vector<std::pair<size_t, BlockEndType> > cntTo =
+      blocks[iblock]->getCntTo(TAIL);
+    if (cntTo.size() == 0) break;
+    if (cntTo.size() != 1 || cntTo[0].second != HEAD) return;
+    iblock = cntTo[0].first;
+    if (blocks[iblock]->getCntTo(HEAD).size() != 1) return;
+  }
+  if (order.size() != numBlocks) return;
+  if (blocks[order[numBlocks-1]]->getCntTo(TAIL).size() != 0) return;
+
+  // Compare blocks from both ends
+  for (size_t n=0; n<numBlocks; ++n) {
+    PsBlockBase<FLOATTYPE, NDIM>* mirrorPtr = blocks[order[numBlocks-1-n]];
+    if (!blocks[order[n]]->isEquivalentTo(mirrorPtr)) return;
+  }
+
+  // Set mirrors, unset all if any block does not support it
+  for (size_t n=0; n<numBlocks; ++n) {
+    PsBlockBase<FLOATTYPE, NDIM>* mirrorPtr = blocks[order[numBlocks-1-n]];
+    if (!blocks[order[n]]->setMirror(mirrorPtr)) {
+      for (size_t i=0; i<numBlocks; ++i) blocks[i]->setMirror(NULL);
+      return;
+    }
+  }
+
+  mirrorOrder = order;
+  this->pprt("Polymer ", this->getName(),
+             " is mirror-symmetric, solving propagators from head only");
 }
 
 //
@@ -200,6 +369,21 @@ void PsBlockCopolymer<FLOATTYPE, NDIM>::update(double t) {
     blocks[i]->reset();
   }
 
+  /*
+   * Mirror-symmetric chain: one sweep of head solves from the
+   * free head along the chain, the tail-solved propagators
+   * are then the head-solved ones of the mirror blocks
+   */
+  if (mirrorOrder.size() > 0) {
+    for (size_t n=0; n<numBlocks; ++n)
+      updateBlockQ(mirrorOrder[n],HEAD);
+    for (size_t n=0; n<numBlocks; ++n)
+      blocks[n]->setMirrorFinalQ();
+  }
+
+  // Concurrent solves of ready block ends (if numThreads > 1)
+  updateBlocksParallel();
+
   /*
    * Continue looping over blocks until all propagators are
    * calculated. Driver for helper method, updateBlockQ, which
@@ -208,6 +392,7 @@ void PsBlockCopolymer<FLOATTYPE, NDIM>::update(double t) {
   while (!areAllBlocksUpdated() ) {
     for (size_t nblock=0; nblock<numBlocks; ++nblock) {
       // Series of "blockPtr->solveQ(end)"
+      updateBlockQPair(nblock);
       updateBlockQ(nblock,HEAD);
       updateBlockQ(nblock,TAIL);
     }
@@ -258,6 +443,34 @@ void PsBlockCopolymer<FLOATTYPE, NDIM>::updateBlockQ(
     }
   }
 
+  // Duplicate arm: copy result from representative arm once
+  // it has solved from the corresponding end, then publish
+  if (armRep.size() > 0 && armRep[nblock] != nblock) {
+    PsBlockBase<FLOATTYPE, NDIM>* repPtr = blocks[armRep[nblock]];
+    BlockEndType repEnd = otherend;
+    if (armFlip[nblock]) repEnd = blockPtr->getOtherEnd(otherend);
+
+    if ( !blockPtr->isQSet(FINAL,otherend) &&
+         repPtr->isQSet(FINAL,repEnd) ) {
+      blockPtr->copyDuplicateFinalQ(otherend);
+      publishQFrom(otherend,nblock);
+    }
+    return;
+  }
+
+  // Prefix block: read both ends off the longer block once
+  // it is solved and both initial q values are set here
+  if (prefixRep.size() > 0 && prefixRep[nblock] != nblock) {
+    PsBlockBase<FLOATTYPE, NDIM>* longPtr = blocks[prefixRep[nblock]];
+    if ( !blockPtr->isBlockUpdated() && longPtr->isBlockUpdated() &&
+         blockPtr->isQSet(INITIAL,HEAD) && blockPtr->isQSet(INITIAL,TAIL) ) {
+      blockPtr->setPrefixFinalQ();
+      publishQFrom(TAIL,nblock);
+      publishQFrom(HEAD,nblock);
+    }
+    return;
+  }
+
   // If q at end of block set and
   // not already solved, then solve/publish
   if ( blockPtr->isQSet(INITIAL,end) &&
@@ -271,6 +484,141 @@ void PsBlockCopolymer<FLOATTYPE, NDIM>::updateBlockQ(
 
 }
 
+//
+// helper method for calculating both block propagators
+// in one pass. Only used if the block supports it and
+// the q values at both ends are available before either
+// end has been solved
+//
+template <class FLOATTYPE, size_t NDIM>
+void PsBlockCopolymer<FLOATTYPE, NDIM>::updateBlockQPair(size_t nblock) {
+
+  PsBlockBase<FLOATTYPE, NDIM>* blockPtr = blocks[nblock];
+  if (!blockPtr->canSolveQPair()) return;
+  if (armRep.size() > 0 && armRep[nblock] != nblock) return;
+  if (prefixRep.size() > 0 && prefixRep[nblock] != nblock) return;
+
+  // Check and set junction values at both ends
+  if (!blockPtr->isQSet(INITIAL,HEAD) && blockPtr->areJntsSet(HEAD))
+    blockPtr->combineSetJnt(HEAD);
+  if (!blockPtr->isQSet(INITIAL,TAIL) && blockPtr->areJntsSet(TAIL))
+    blockPtr->combineSetJnt(TAIL);
+
+  // Both ends ready and neither solved
+  if ( blockPtr->isQSet(INITIAL,HEAD) && blockPtr->isQSet(INITIAL,TAIL) &&
+      !blockPtr->isQSet(FINAL,HEAD)   && !blockPtr->isQSet(FINAL,TAIL) ) {
+
+    blockPtr->solveQPair();
+    publishQFrom(TAIL,nblock);
+    publishQFrom(HEAD,nblock);
+  }
+
+}
+
+//
+// Dependency-driven threaded version of the update loop. Block ends
+// whose initial q is ready are solved as one batch of tasks on the
+// thread pool, at most one per block (HEAD first so the TAIL solve
+// can stream) and per solve workspace. Junction bookkeeping, copies
+// for duplicate arms and publishing happen between batches on the
+// calling thread only.
+//
+template <class FLOATTYPE, size_t NDIM>
+void PsBlockCopolymer<FLOATTYPE, NDIM>::updateBlocksParallel() {
+
+  if (numThreads <= 1) return;
+
+  // Task kinds
+  enum SolveKind {SOLVE_HEAD, SOLVE_TAIL, SOLVE_PAIR};
+
+  while (!areAllBlocksUpdated() ) {
+
+    size_t numFinalStart = countFinalQ();
+    std::vector<size_t> taskBlock;
+    std::vector<SolveKind> taskKind;
+    std::vector<std::function<void()> > tasks;
+    std::set<const void*> busy;
+
+    for (size_t nblock=0; nblock<numBlocks; ++nblock) {
+
+      PsBlockBase<FLOATTYPE, NDIM>* blockPtr = blocks[nblock];
+
+      // Duplicate arms and prefix blocks only copy, no solve
+      if ((armRep.size() > 0 && armRep[nblock] != nblock) ||
+          (prefixRep.size() > 0 && prefixRep[nblock] != nblock)) {
+        updateBlockQ(nblock,HEAD);
+        updateBlockQ(nblock,TAIL);
+        continue;
+      }
+
+      // Check and set junction values at both ends
+      if (!blockPtr->isQSet(INITIAL,HEAD) && blockPtr->areJntsSet(HEAD))
+        blockPtr->combineSetJnt(HEAD);
+      if (!blockPtr->isQSet(INITIAL,TAIL) && blockPtr->areJntsSet(TAIL))
+        blockPtr->combineSetJnt(TAIL);
+
+      bool headReady = blockPtr->isQSet(INITIAL,HEAD) &&
+                      !blockPtr->isQSet(FINAL,TAIL);
+      bool tailReady = blockPtr->isQSet(INITIAL,TAIL) &&
+                      !blockPtr->isQSet(FINAL,HEAD);
+      if (!headReady && !tailReady) continue;
+
+      const void* resPtr = blockPtr->getSolveResource();
+      if (busy.count(resPtr) > 0) continue;
+      busy.insert(resPtr);
+
+      SolveKind kind = SOLVE_TAIL;
+      if (headReady) kind = SOLVE_HEAD;
+      if (headReady && tailReady && blockPtr->canSolveQPair())
+        kind = SOLVE_PAIR;
+
+      taskBlock.push_back(nblock);
+      taskKind.push_back(kind);
+      if (kind == SOLVE_PAIR)
+        tasks.push_back(std::bind(
+          &PsBlockBase<FLOATTYPE, NDIM>::solveQPair, blockPtr));
+      else
+        tasks.push_back(std::bind(
+          &PsBlockBase<FLOATTYPE, NDIM>::solveQ, blockPtr,
+          (kind == SOLVE_HEAD) ? HEAD : TAIL));
+    }
+
+    // Nothing to solve: either copies finished the update or made
+    // ends ready for the next pass, or the block graph has an end
+    // that is never set
+    if (tasks.size() == 0) {
+      if (areAllBlocksUpdated()) break;
+      if (countFinalQ() > numFinalStart) continue;
+      TxDebugExcept tde("PsBlockCopolymer::updateBlocksParallel:");
+      tde << " no block end ready to solve";
+      tde << " in <Polymer " << this->getName() << " >";
+      throw tde;
+    }
+
+    threadPool.run(tasks);
+
+    // Make connected blocks aware of results
+    for (size_t n=0; n<taskBlock.size(); ++n) {
+      if (taskKind[n] != SOLVE_TAIL) publishQFrom(TAIL,taskBlock[n]);
+      if (taskKind[n] != SOLVE_HEAD) publishQFrom(HEAD,taskBlock[n]);
+    }
+  }
+}
+
+//
+// Number of block ends with a final q for this update
+//
+template <class FLOATTYPE, size_t NDIM>
+size_t PsBlockCopolymer<FLOATTYPE, NDIM>::countFinalQ() {
+
+  size_t numFinal = 0;
+  for (size_t n=0; n<numBlocks; ++n) {
+    if (blocks[n]->isQSet(FINAL,HEAD)) numFinal++;
+    if (blocks[n]->isQSet(FINAL,TAIL)) numFinal++;
+  }
+  return numFinal;
+}
+
 /*
  * This is the method that communicates Q values from
  * one block to another
@@ -361,6 +709,43 @@ void PsBlockCopolymer<FLOATTYPE, NDIM>::convertQ(
   }
 }
 
+//
+// Every block model in the chain must support the derivatives
+//
+template <class FLOATTYPE, size_t NDIM>
+void PsBlockCopolymer<FLOATTYPE, NDIM>::setCalcStress(bool cs) {
+
+  for (size_t n=0; n<numBlocks; ++n) {
+    if (!blocks[n]->setCalcStress(cs)) {
+      TxDebugExcept tde("PsBlockCopolymer::setCalcStress: block model ");
+      tde << blocks[n]->getBlockType() << " of <Block ";
+      tde << blocks[n]->getName() << " > has no box-length derivatives";
+      throw tde;
+    }
+  }
+}
+
+//
+// Each block holds its part of the contour integral for log(bigQ)
+//
+template <class FLOATTYPE, size_t NDIM>
+std::vector<FLOATTYPE> PsBlockCopolymer<FLOATTYPE, NDIM>::getStress() {
+
+  std::vector<FLOATTYPE> stress;
+  for (size_t n=0; n<numBlocks; ++n) {
+    std::vector<FLOATTYPE> bStress = blocks[n]->getStress();
+    stress.resize(bStress.size(), 0.0);
+    for (size_t i=0; i<bStress.size(); ++i) stress[i] += bStress[i];
+  }
+  return stress;
+}
+
+//
+template <class FLOATTYPE, size_t NDIM>
+void PsBlockCopolymer<FLOATTYPE, NDIM>::rebuildKSpace() {
+  for (size_t n=0; n<numBlocks; ++n) blocks[n]->rebuildKSpace();
+}
+
 // Instantiate
 template class PsBlockCopolymer<float, 1>;
 template class PsBlockCopolymer<float, 2>;
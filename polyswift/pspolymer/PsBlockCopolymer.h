@@ -28,6 +28,9 @@
 #include <PsBlockBase.h>
 #include <PsBlockTypes.h>
 
+// psstd includes
+#include <PsThreadPool.h>
+
 /**
  * Solves for block copolymers, container class for PsBlock-s
  *
@@ -115,6 +118,25 @@ class PsBlockCopolymer : public PsPolymer<FLOATTYPE, NDIM> {
       return (FLOATTYPE) std::log(bigQ);
     }
 
+/**
+ * Turn on/off box-length derivatives in all blocks
+ *
+ * @param cs true to calculate
+ */
+    virtual void setCalcStress(bool cs);
+
+/**
+ * Get L_i d(log bigQ)/dL_i, summed over blocks
+ *
+ * @return vector of derivatives, one per grid direction
+ */
+    virtual std::vector<FLOATTYPE> getStress();
+
+/**
+ * Rebuild k-space operators of all blocks
+ */
+    virtual void rebuildKSpace();
+
   protected:
 
     /** Number of blocks */
@@ -150,11 +172,77 @@ class PsBlockCopolymer : public PsPolymer<FLOATTYPE, NDIM> {
      */
     virtual void updateBlockQ(size_t nblock, BlockEndType end);
 
+    /**
+     * Update both propagators of a single block in one pass if
+     * q values at both ends are available, helper for update()
+     *
+     * @param nblock index of block to update
+     */
+    virtual void updateBlockQPair(size_t nblock);
+
+    /**
+     * Threaded driver for the block solves, helper for update().
+     * Each pass solves every ready block end at the same time, one
+     * solve per block and per solve workspace, then publishes the
+     * results. Does nothing if numThreads is 1.
+     */
+    void updateBlocksParallel();
+
+    /**
+     * Index of the longer block each block reads its propagators
+     * off (itself if none), see PsBlockBase::setPrefixOf
+     */
+    std::vector<size_t> prefixRep;
+
   private:
 
     /** Single chain partition function */
     FLOATTYPE bigQ;
 
+    /** Number of threads for concurrent block solves */
+    size_t numThreads;
+
+    /** Worker threads for concurrent block solves */
+    PsThreadPool threadPool;
+
+    /** Flag allowing one-direction solves for mirror-symmetric chains */
+    bool mirrorSolve;
+
+    /**
+     * Block indices from free head to free tail if the chain is
+     * linear and mirror-symmetric, otherwise empty
+     */
+    std::vector<size_t> mirrorOrder;
+
+    /**
+     * Detect a linear chain that reads the same from either end
+     * and pair each block with its mirror: helper for buildSolvers()
+     */
+    void buildMirrorSymmetry();
+
+    /** Flag allowing single solves for equivalent arms */
+    bool dedupArms;
+
+    /** Index of representative block for each block (itself if none) */
+    std::vector<size_t> armRep;
+
+    /** Flag for each duplicate arm oriented opposite to its representative */
+    std::vector<bool> armFlip;
+
+    /**
+     * Count block ends with final q set, used by the threaded
+     * driver to detect passes that only copied results
+     *
+     * @return number of final q values set
+     */
+    size_t countFinalQ();
+
+    /**
+     * Find equivalent free-end arms on a common junction and make
+     * all but one of them duplicates: helper for buildSolvers()
+     */
+    void buildArmDuplicates();
+
     /**
      * Build connected block types: helper method for buildSolvers()
      *
@@ -13,6 +13,7 @@
 #include <PsBlockMakerMap.h>
 #include <PsBlockTypes.h>
 #include <PsFlexPseudoSpec.h>
+#include <PsFlexRQM4.h>
 #include <PsChargeFlexPseudoSpec.h>
 
 //#include <PsFlexCrankNic.h>
@@ -34,6 +35,9 @@ PsBlockMakerMap<FLOATTYPE, NDIM>::PsBlockMakerMap() {
   new TxMaker< PsFlexPseudoSpec<FLOATTYPE, NDIM, typename PsBlockTypes<FLOATTYPE,
      NDIM>::flexQType >, PsBlockBase<FLOATTYPE, NDIM> >("flexPseudoSpec");
 
+  new TxMaker< PsFlexRQM4<FLOATTYPE, NDIM, typename PsBlockTypes<FLOATTYPE,
+     NDIM>::flexQType >, PsBlockBase<FLOATTYPE, NDIM> >("flexRQM4");
+
   new TxMaker< PsChargeFlexPseudoSpec<FLOATTYPE, NDIM, typename PsBlockTypes<FLOATTYPE,
      NDIM>::flexQType >, PsBlockBase<FLOATTYPE, NDIM> >("chargeFlexPseudoSpec");
 
@@ -164,6 +164,22 @@ void PsChargeFlexPseudoSpec<FLOATTYPE, NDIM, QTYPE>::setPhysFields() {
   chargeField += setChargeField;
 }
 
+//
+// Solver check including charge strength/distribution
+//
+template <class FLOATTYPE, size_t NDIM, class QTYPE>
+bool PsChargeFlexPseudoSpec<FLOATTYPE, NDIM, QTYPE>::hasSameSolver(
+     PsBlockBase<FLOATTYPE, NDIM>* mb) {
+
+  if (!PsFlexPseudoSpec<FLOATTYPE, NDIM, QTYPE>::hasSameSolver(mb)) return false;
+
+  PsChargeFlexPseudoSpec<FLOATTYPE, NDIM, QTYPE>* cb =
+    dynamic_cast<PsChargeFlexPseudoSpec<FLOATTYPE, NDIM, QTYPE>*>(mb);
+  if (!cb) return false;
+
+  return (za == cb->za && alpha == cb->alpha);
+}
+
 // Instantiate classes (for flexible block model)
 template class PsChargeFlexPseudoSpec<float, 1, PsBlockTypes<float, 1>::flexQType >;
 template class PsChargeFlexPseudoSpec<float, 2, PsBlockTypes<float, 2>::flexQType >;
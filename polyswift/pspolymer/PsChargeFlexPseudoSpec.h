@@ -79,12 +79,35 @@ class PsChargeFlexPseudoSpec : public virtual PsFlexPseudoSpec<FLOATTYPE, NDIM,
  */
     virtual void reset();
 
+/**
+ * Charge densities are not combined over groups of ranks, so
+ * charged blocks are only solved on the simulation grid
+ *
+ * @param gridPtr replicated grid
+ * @param commPtr communicator of the group
+ */
+    virtual void setGroupGrid(PsGridBase<FLOATTYPE, NDIM>* gridPtr,
+                              PsCommBase<FLOATTYPE, NDIM>* commPtr) {
+      TxDebugExcept tde("PsChargeFlexPseudoSpec::setGroupGrid not implemented");
+      tde << " for <Block " << this->getName() << " >";
+      throw tde;
+    }
+
 /**
  * Uses result from monomer density (in PsBlock) to set charge contribution
  * from this charged block
  */
     virtual void setPhysFields();
 
+/**
+ * Check if block mb has the same contour solver,
+ * includes the charge parameters
+ *
+ * @param mb pointer to other block
+ * @return true if the blocks have the same solver
+ */
+    virtual bool hasSameSolver(PsBlockBase<FLOATTYPE, NDIM>* mb);
+
   protected:
 
   private:
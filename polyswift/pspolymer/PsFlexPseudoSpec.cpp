@@ -14,6 +14,11 @@
 #include <config.h>
 #endif
 
+// std includes
+#include <cstring>
+#include <sstream>
+#include <iomanip>
+
 // psbase includes
 #include <PsFieldBase.h>
 
@@ -31,13 +36,17 @@ PsFlexPseudoSpec<FLOATTYPE, NDIM, QTYPE>::PsFlexPseudoSpec() {
   this->blockTypeStr = "flexibleBlock";
 
   fftObjPtr = NULL;
+  fftWs = 0;
 
   k2     = NULL;
   wfac   = NULL;
   qw     = NULL;
-  resPtr = NULL;
+  qtw    = NULL;
+
+  pairSolve = false;
 
   fftSize = 0;
+  specSize = 0;
   scaleFFT = 0.0;
 
   bSegRatio = 1.0;
@@ -46,10 +55,9 @@ PsFlexPseudoSpec<FLOATTYPE, NDIM, QTYPE>::PsFlexPseudoSpec() {
 // Destructor
 template <class FLOATTYPE, size_t NDIM, class QTYPE>
 PsFlexPseudoSpec<FLOATTYPE, NDIM, QTYPE>::~PsFlexPseudoSpec() {
-  delete[] k2;
   delete[] wfac;
   delete[] qw;
-  delete[] resPtr;
+  delete[] qtw;
 }
 
 //
@@ -79,6 +87,12 @@ void PsFlexPseudoSpec<FLOATTYPE, NDIM, QTYPE>::setAttrib(
     // throw tde;
   }
 
+  // Solve head/tail propagators in one complex transform
+  if (tas.hasString("pairSolve")) {
+    std::string pStr = tas.getString("pairSolve");
+    if (pStr == "on") pairSolve = true;
+  }
+
 }
 
 //
@@ -100,10 +114,15 @@ void PsFlexPseudoSpec<FLOATTYPE, NDIM, QTYPE>::buildData() {
 
   // Allocate space for transform lists
   // qTotalSize is NOT total_local_size in FFTW
-  k2     = new FLOATTYPE[this->qTotalSize];
+  // (k2 is sized by the FFT object in buildSolvers)
   wfac   = new FLOATTYPE[this->qTotalSize];
   qw     = new FLOATTYPE[this->qTotalSize];
-  resPtr = new FLOATTYPE[this->qTotalSize];
+
+  // Extra space for second propagator in pair solve
+  if (pairSolve) {
+    qtX.setGrid(gItr);
+    qtw = new FLOATTYPE[this->qTotalSize];
+  }
 }
 
 //
@@ -124,6 +143,7 @@ void PsFlexPseudoSpec<FLOATTYPE, NDIM, QTYPE>::buildSolvers() {
   // Checking that propagator size is consistent with FFT buffer sizes
   // SWS: This check may be defeating FFTW functionality.... change?
   fftSize = fftObjPtr->getFFTSize();
+  specSize = fftObjPtr->getSpecSize();
   if (fftSize != this->qTotalSize) {
     TxDebugExcept tde("PsFlexPseudoSpec::buildSolvers: the FFT data struct size");
     tde << " in <PsFlexPseudoSpec " << this->getName() << " >";
@@ -135,18 +155,19 @@ void PsFlexPseudoSpec<FLOATTYPE, NDIM, QTYPE>::buildSolvers() {
 
   //
   // Build k2 list, only depends on ds and system size
-  // and for now is only built at beginning of build cycle
-  // If MPI is present then parallel is assumed and the
-  // scaledFFTPair routine will use the "TRANSPOSED_ORDER"
-  // to save communication time. If MPI not present then serial
-  // is assumed and the scaledFFTPair routine defaults to
-  // "NORMAL" data layout
+  // and for now is only built at beginning of build cycle.
+  // The layout is the spectrum order of the FFT object, the
+  // MPI transforms use "TRANSPOSED_ORDER" to save communication
+  // time, serial transforms use the "NORMAL" data layout.
+  // The list is kept by the FFT object, so blocks with the same
+  // ds b^2 (also in replica domains) build it only once
   //
-#ifdef HAVE_MPI
-  build_k2_transpose();
-#else
-  build_k2();
-#endif
+  bool newK2 = false;
+  k2 = fftObjPtr->getKTable(getKTableKey("k2"), newK2);
+  if (newK2) {
+    if (fftObjPtr->isTransposedOrder()) build_k2_transpose();
+    else build_k2();
+  }
 
   // Set FFT scaling
   scaleFFT = 1.0 / ((FLOATTYPE) this->getGridBase().getTotalCellsGlobal() );
@@ -160,18 +181,19 @@ void PsFlexPseudoSpec<FLOATTYPE, NDIM, QTYPE>::reset() {
 
   // Scoping call to base class
   PsBlock<FLOATTYPE, NDIM, QTYPE>::reset();
+  if (this->isRemote()) return;
 
   this->dbprt("PsFlexPseudoSpec::reset() ");
   this->dbprt(" ... setting w-fields with physField ",
               this->monoDensPhysFldPtr->getName() );
 
   // Get physField and the associated conjugate field
-  // Obtain data pointer from fieldBase
+  // (or its whole-grid copy for a block on a group grid)
   FLOATTYPE ds2 = -0.5*this->ds;
-  PsFieldBase<FLOATTYPE>& wField = this->monoDensPhysFldPtr->getConjgField();
-  const FLOATTYPE* wDataPtr = wField.getConstDataPtr();
+  const FLOATTYPE* wDataPtr = this->getConjgData();
 
   // Set w fields and scale by ds factor
+#pragma omp parallel for
   for (size_t n=0; n<fftSize; ++n) {
     wfac[n] = (FLOATTYPE)std::exp(ds2*wDataPtr[n]);
   }
@@ -180,6 +202,46 @@ void PsFlexPseudoSpec<FLOATTYPE, NDIM, QTYPE>::reset() {
   this->dbprt("wfac[2] = ", (int)wfac[2]);
 }
 
+//
+// Solver check, base class has already checked the derived types match
+//
+template <class FLOATTYPE, size_t NDIM, class QTYPE>
+bool PsFlexPseudoSpec<FLOATTYPE, NDIM, QTYPE>::hasSameSolver(
+     PsBlockBase<FLOATTYPE, NDIM>* mb) {
+
+  if (!PsBlock<FLOATTYPE, NDIM, QTYPE>::hasSameSolver(mb)) return false;
+
+  PsFlexPseudoSpec<FLOATTYPE, NDIM, QTYPE>* fb =
+    dynamic_cast<PsFlexPseudoSpec<FLOATTYPE, NDIM, QTYPE>*>(mb);
+  if (!fb) return false;
+
+  return (bSegRatio == fb->bSegRatio);
+}
+
+//
+// Own transform buffers on the shared plans of the FFT object,
+// so blocks on one FFT object can be solved concurrently
+//
+template <class FLOATTYPE, size_t NDIM, class QTYPE>
+bool PsFlexPseudoSpec<FLOATTYPE, NDIM, QTYPE>::buildSolveWorkspace() {
+
+  if (fftWs == 0) fftWs = fftObjPtr->addWorkspace();
+  return (fftWs > 0);
+}
+
+//
+// Lists of the FFT object depend on the block only through ds b^2
+//
+template <class FLOATTYPE, size_t NDIM, class QTYPE>
+std::string PsFlexPseudoSpec<FLOATTYPE, NDIM, QTYPE>::getKTableKey(
+    const std::string& nm) {
+
+  std::ostringstream key;
+  key << nm << " " << std::setprecision(17)
+      << (double)(this->ds*bSegRatio*bSegRatio);
+  return key.str();
+}
+
 //
 // helper method to calck2 list only depends on ds and system size
 // and for now is only built at beginning of build cycle
@@ -194,11 +256,15 @@ void PsFlexPseudoSpec<FLOATTYPE, NDIM, QTYPE>::build_k2() {
   k2Field.calck2();
 
   // Map k2 field values to normal order layout
-  // and form correct exp operator
+  // and form correct exp operator. Half-spectrum transforms
+  // only keep k < nz/2+1 in the last dimension
+  size_t nkLast = this->qDims[2];
+  if (fftObjPtr->hasHalfSpectrum()) nkLast = this->qDims[2]/2 + 1;
+
   size_t n=0;
   for (size_t i = 0; i < this->qDims[0]; ++i) {
   for (size_t j = 0; j< this->qDims[1]; ++j) {
-  for (size_t k = 0; k < this->qDims[2]; ++k) {
+  for (size_t k = 0; k < nkLast; ++k) {
     k2[n] = std::exp(-1.0*this->ds*k2Field(i, j, k, 0)*bSegRatio*bSegRatio);
     n++;
   }}}
@@ -222,16 +288,143 @@ void PsFlexPseudoSpec<FLOATTYPE, NDIM, QTYPE>::build_k2_transpose() {
   // Map k2 field values to transpose order layout
   // and form correct exp operator
   std::vector<size_t> kDims = fftGridPtr->getDecomp().getNumCellsLocal();
+  size_t nkLast = kDims[2];
+  if (fftObjPtr->hasHalfSpectrum()) nkLast = kDims[2]/2 + 1;
+
   size_t n=0;
   for (size_t j = 0; j< kDims[1]; ++j) {
   for (size_t i = 0; i < kDims[0]; ++i) {
-  for (size_t k = 0; k < kDims[2]; ++k) {
+  for (size_t k = 0; k < nkLast; ++k) {
     k2[n] = std::exp(-1.0*this->ds*k2Field(i, j, k, 0)*bSegRatio*bSegRatio);
     n++;
   }}}
 
 }
 
+//
+// helper method to calculate the k_i^2 lists in the same
+// order as k2 (spectrum order of FFT object, see buildSolvers).
+// For a half-spectrum transform the modes 0 < k < nz/2 of the
+// last dimension count twice, for their conjugates
+//
+template <class FLOATTYPE, size_t NDIM, class QTYPE>
+void PsFlexPseudoSpec<FLOATTYPE, NDIM, QTYPE>::build_kDir2() {
+
+  // Local holder for k_i^2 values
+  PsGridField<FLOATTYPE, NDIM> kField;
+  bool transposed = fftObjPtr->isTransposedOrder();
+  PsGridBaseItr* gItr = &this->getGridBase();
+  std::vector<size_t> kDims = this->qDims;
+  if (transposed) {
+    gItr = fftGridPtr;
+    kDims = fftGridPtr->getDecomp().getNumCellsLocal();
+  }
+  kField.setGrid(gItr);
+
+  size_t nkLast = kDims[2];
+  if (fftObjPtr->hasHalfSpectrum()) nkLast = kDims[2]/2 + 1;
+
+  std::vector<FLOATTYPE> kWt(nkLast, 1.0);
+  if (fftObjPtr->hasHalfSpectrum()) {
+    for (size_t k = 1; k < nkLast; ++k)
+      if (2*k != kDims[2]) kWt[k] = 2.0;
+  }
+
+  kDir2.assign(stressDirs.size()*specSize, 0.0);
+  for (size_t d=0; d<stressDirs.size(); ++d) {
+
+    kField.calckDir2(stressDirs[d]);
+    FLOATTYPE* kd = &kDir2[d*specSize];
+
+    size_t n=0;
+    if (transposed) {
+      for (size_t j = 0; j< kDims[1]; ++j) {
+      for (size_t i = 0; i < kDims[0]; ++i) {
+      for (size_t k = 0; k < nkLast; ++k) {
+        kd[n] = kWt[k]*kField(i, j, k, 0);
+        n++;
+      }}}
+    }
+    else {
+      for (size_t i = 0; i < kDims[0]; ++i) {
+      for (size_t j = 0; j< kDims[1]; ++j) {
+      for (size_t k = 0; k < nkLast; ++k) {
+        kd[n] = kWt[k]*kField(i, j, k, 0);
+        n++;
+      }}}
+    }
+  }
+}
+
+//
+// Box-length derivatives only for directions that can change
+//
+template <class FLOATTYPE, size_t NDIM, class QTYPE>
+bool PsFlexPseudoSpec<FLOATTYPE, NDIM, QTYPE>::setCalcStress(bool cs) {
+
+  this->calcStress = cs;
+  if (!cs) return true;
+
+  std::vector<size_t> globalDims = this->getGridBase().getNumCellsGlobal();
+  stressDirs.clear();
+  for (size_t d=0; d<globalDims.size(); ++d) {
+    if (globalDims[d] > 1) stressDirs.push_back(d);
+  }
+
+  this->stressSums.assign(globalDims.size(), 0.0);
+  stressRes.assign(specSize, 0.0);
+  build_kDir2();
+
+  return true;
+}
+
+//
+// Called after the cell sizes of both the block grid and the
+// FFT grid are changed, eg. by PsBoxRelaxUpdater. Blocks sharing
+// the k2 list each rebuild it to the same values
+//
+template <class FLOATTYPE, size_t NDIM, class QTYPE>
+void PsFlexPseudoSpec<FLOATTYPE, NDIM, QTYPE>::rebuildKSpace() {
+
+  this->dbprt("PsFlexPseudoSpec::rebuildKSpace() ");
+
+  std::vector<FLOATTYPE> cellSizes = this->getGridBase().getCellSizes();
+  if (cellSizes != fftGridPtr->getCellSizes()) {
+    TxDebugExcept tde("PsFlexPseudoSpec::rebuildKSpace: cell sizes of");
+    tde << " block grid and FFT grid differ";
+    tde << " in <PsFlexPseudoSpec " << this->getName() << " >";
+    throw tde;
+  }
+
+  if (fftObjPtr->isTransposedOrder()) build_k2_transpose();
+  else build_k2();
+  if (this->calcStress) build_kDir2();
+}
+
+//
+// The Laplacian factor is exp(-ds b^2 sum_i k_i^2) with
+// k_i ~ 1/L_i so L_i d/dL_i brings down 2 ds b^2 k_i^2. By
+// Parseval <qt F^-1[k_i^2 F[q]]> is a k-space sum over
+// Re[conj(F[q]) F[qt]], so q and qt are transformed once for
+// all directions
+//
+template <class FLOATTYPE, size_t NDIM, class QTYPE>
+void PsFlexPseudoSpec<FLOATTYPE, NDIM, QTYPE>::addStressSlice(FLOATTYPE wt,
+    const FLOATTYPE* q, const FLOATTYPE* qt) {
+
+  // Transform scaling and average over all cells
+  FLOATTYPE fac = 2.0*wt*bSegRatio*bSegRatio*scaleFFT*scaleFFT;
+
+  fftObjPtr->crossSpectrumReWs(fftWs, q, qt, &stressRes[0]);
+  for (size_t d=0; d<stressDirs.size(); ++d) {
+    const FLOATTYPE* kd = &kDir2[d*specSize];
+    double sum = 0.0;
+#pragma omp parallel for reduction(+:sum)
+    for (size_t n=0; n<specSize; ++n) sum += kd[n]*stressRes[n];
+    this->stressSums[stressDirs[d]] += fac*(FLOATTYPE)sum;
+  }
+}
+
 /*
  * Solve for q(r,s) starting from solveFromEnd and finish at otherEnd
  *
@@ -259,37 +452,119 @@ void PsFlexPseudoSpec<FLOATTYPE, NDIM, QTYPE>::solveQ(
 
   qX = this->getInitialQ(solveFromEnd);
 
-  // Store initial condition in full propagator
-  if (solveFromEnd == HEAD) this->qs[0]  = qX;
-  if (solveFromEnd == TAIL) this->qts[0] = qX;
+  // Store initial condition in full propagator, each step
+  // below is written directly into the next contour slice
+  this->beginSolve(solveFromEnd);
+  FLOATTYPE* qinit = this->getSolveSlice(solveFromEnd, 0);
+  std::memcpy(qinit, qX.getConstDataPtr(), fftSize*sizeof(FLOATTYPE));
+  this->endSolveStep(solveFromEnd, 0);
+  const FLOATTYPE* qprev = qinit;
 
   // Loop over steps in propagator
   for (size_t ss=1; ss<=this->blockSteps; ++ss) {
+    FLOATTYPE* qcur = this->getSolveSlice(solveFromEnd, ss);
+    stepQ(qprev, qcur);
+    this->endSolveStep(solveFromEnd, ss);
+    qprev = qcur;
+  }
 
-    // Get qX data and apply half-field factor to q(r,s)
-    // SWS: data access is dangerous...and should be refactored
-    FLOATTYPE* qdata = qX.getDataPtr();
-    for (size_t n=0; n<fftSize; ++n)
-      qw[n] = qdata[n]*wfac[n];
+  // Set holder for final q(r,s) field
+  std::memcpy(qX.getDataPtr(), qprev, fftSize*sizeof(FLOATTYPE));
+  this->setFinalQ(this->getOtherEnd(solveFromEnd),qX);
+}
 
-    // Perform pseudo-spectral transform pair:  F^-1[k2*F[q*w]]
-    fftObjPtr->scaledFFTPair(qw, k2, resPtr);
+//
+// Single contour step, shared by solveQ and the recompute
+// of checkpointed segments in PsBlock::setCalcQQTIntegral
+//
+template <class FLOATTYPE, size_t NDIM, class QTYPE>
+void PsFlexPseudoSpec<FLOATTYPE, NDIM, QTYPE>::stepQ(const FLOATTYPE* qin,
+                                                    FLOATTYPE* qout) {
+  splitStep(qin, qout, wfac, k2);
+}
+
+//
+// Split-operator step for the factor lists wf, kf
+//
+template <class FLOATTYPE, size_t NDIM, class QTYPE>
+void PsFlexPseudoSpec<FLOATTYPE, NDIM, QTYPE>::splitStep(const FLOATTYPE* qin,
+    FLOATTYPE* qout, const FLOATTYPE* wf, const FLOATTYPE* kf) {
+
+  // Apply half-field factor to q(r,s)
+#pragma omp parallel for
+  for (size_t n=0; n<fftSize; ++n)
+    qw[n] = qin[n]*wf[n];
+
+  // Perform pseudo-spectral transform pair:  F^-1[k2*F[q*w]]
+  // with result put into slice for s+ds
+  fftObjPtr->scaledFFTPairWs(fftWs, qw, kf, qout);
+
+  // Apply other half-field factor to q(r,s) and
+  // transform scale factor, global simulation size
+#pragma omp parallel for
+  for (size_t n=0; n<fftSize; ++n)
+    qout[n] = (qout[n]*wf[n])*scaleFFT;
+}
+
+/*
+ * Solve for q(r,s) from HEAD and qt(r,s) from TAIL together
+ *
+ * Both propagators are real and the k2 operator is real and even
+ * so q is packed in the real part and qt in the imaginary part of
+ * a single complex transform pair. Same result as solveQ(HEAD)
+ * followed by solveQ(TAIL) with half the number of transforms.
+ */
+template <class FLOATTYPE, size_t NDIM, class QTYPE>
+void PsFlexPseudoSpec<FLOATTYPE, NDIM, QTYPE>::solveQPair() {
+
+  this->dbprt("PsFlexPseudoSpec::solveQPair() ");
+
+  qX  = this->getInitialQ(HEAD);
+  qtX = this->getInitialQ(TAIL);
+
+  // Store initial conditions in full propagators, HEAD solve
+  // is not done yet so qt(r,s) is stored (not streamed)
+  this->beginSolve(HEAD);
+  this->beginSolve(TAIL);
+  FLOATTYPE* qinit  = this->getSolveSlice(HEAD, 0);
+  FLOATTYPE* qtinit = this->getSolveSlice(TAIL, 0);
+  std::memcpy(qinit,  qX.getConstDataPtr(),  fftSize*sizeof(FLOATTYPE));
+  std::memcpy(qtinit, qtX.getConstDataPtr(), fftSize*sizeof(FLOATTYPE));
+  const FLOATTYPE* qprev  = qinit;
+  const FLOATTYPE* qtprev = qtinit;
+
+  // Loop over steps in propagator
+  for (size_t ss=1; ss<=this->blockSteps; ++ss) {
+
+    // Apply half-field factor to q(r,s) and qt(r,s)
+#pragma omp parallel for
+    for (size_t n=0; n<fftSize; ++n) {
+      qw[n]  = qprev[n]*wfac[n];
+      qtw[n] = qtprev[n]*wfac[n];
+    }
 
-    // Apply other half-field factor to q(r,s) and
-    // put into qdata this effectively assigns data to qX
-    for (size_t n=0; n<fftSize; ++n)
-      qdata[n] = resPtr[n]*wfac[n];
+    // Pseudo-spectral transform pair for both:  F^-1[k2*F[q*w]]
+    FLOATTYPE* qcur  = this->getSolveSlice(HEAD, ss);
+    FLOATTYPE* qtcur = this->getSolveSlice(TAIL, ss);
+    fftObjPtr->scaledFFTPairTwoWs(fftWs, qw, qtw, k2, qcur, qtcur);
 
-    // Transform scale factor, global simulation size
-    // and put into full propagator
-    qX.scale(scaleFFT);
-    if (solveFromEnd == HEAD) this->qs[ss]  = qX;
-    if (solveFromEnd == TAIL) this->qts[ss] = qX;
+    // Apply other half-field factor and transform scale factor
+#pragma omp parallel for
+    for (size_t n=0; n<fftSize; ++n) {
+      qcur[n]  = (qcur[n]*wfac[n])*scaleFFT;
+      qtcur[n] = (qtcur[n]*wfac[n])*scaleFFT;
+    }
+
+    qprev  = qcur;
+    qtprev = qtcur;
 
   } // loop on blockSteps
 
-  // Set holder for final q(r,s) field
-  this->setFinalQ(this->getOtherEnd(solveFromEnd),qX);
+  // Set holders for final q(r,s) fields
+  std::memcpy(qX.getDataPtr(),  qprev,  fftSize*sizeof(FLOATTYPE));
+  std::memcpy(qtX.getDataPtr(), qtprev, fftSize*sizeof(FLOATTYPE));
+  this->setFinalQ(TAIL, qX);
+  this->setFinalQ(HEAD, qtX);
 }
 
 // Instantiate classes (for flexible block model)
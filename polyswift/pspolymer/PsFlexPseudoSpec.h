@@ -44,8 +44,9 @@
  *
  * For now, the solve methods are hard-wired for the
  * pseudo-spectral method... therefore the decomp is
- * that set by the FFT class.
- *
+ * that set by the FFT class. The pointwise loops of each contour
+ * step are OpenMP parallel in ENABLE_OPENMP builds, threads within
+ * the transforms are set on the FFT object (numThreads).
  *
  * @param FLOATTYPE numeric type of the data.
  * @param NDIM dimensionality of the physical space
@@ -99,8 +100,98 @@ class PsFlexPseudoSpec : public virtual PsBlock<FLOATTYPE, NDIM, QTYPE> {
  */
     virtual void solveQ(BlockEndType solveFromEnd);
 
+/**
+ * Check if forward/backward propagators can be solved together
+ *
+ * @return true if pairSolve set for this block (and not checkpointed)
+ */
+    virtual bool canSolveQPair() {
+      return (pairSolve && !this->checkpointQ);
+    }
+
+/**
+ * Update forward/backward propagators together, q(r,s) and
+ * qt(r,s) are packed into the Re/Im parts of one complex transform
+ */
+    virtual void solveQPair();
+
+/**
+ * Get the workspace used by solveQ: the block itself if it has its
+ * own transform workspace, else the shared FFT object (fftKind)
+ *
+ * @return pointer identifying the solve workspace
+ */
+    virtual const void* getSolveResource() {
+      if (fftWs > 0) return this;
+      return fftObjPtr;
+    }
+
+/**
+ * Add a transform workspace on the FFT object for this block
+ *
+ * @return true if the FFT object supports workspaces
+ */
+    virtual bool buildSolveWorkspace();
+
+/**
+ * Check if block mb has the same contour solver,
+ * includes the statistical segment length
+ *
+ * @param mb pointer to other block
+ * @return true if the blocks have the same solver
+ */
+    virtual bool hasSameSolver(PsBlockBase<FLOATTYPE, NDIM>* mb);
+
+/**
+ * Accumulate L_i d(log bigQ)/dL_i in setCalcQQTIntegral. Builds
+ * the k_i^2 lists, costs two forward transforms per contour
+ * slice for all grid directions with more than one cell
+ *
+ * @param cs true to accumulate
+ * @return true
+ */
+    virtual bool setCalcStress(bool cs);
+
+/**
+ * Rebuild the Laplacian factor (and k_i^2 lists) from the
+ * current grid cell sizes
+ */
+    virtual void rebuildKSpace();
+
   protected:
 
+/**
+ * Add 2 b^2 wt <qt F^-1[ k_i^2 F[q] ]> for each direction i,
+ * the derivative of the Laplacian factor with respect to L_i
+ *
+ * @param wt quadrature weight
+ * @param q  pointer to forward slice
+ * @param qt pointer to backward slice
+ */
+    virtual void addStressSlice(FLOATTYPE wt, const FLOATTYPE* q,
+                                const FLOATTYPE* qt);
+
+/**
+ * Advance a propagator one contour step ds with the split-operator
+ * q(r,s+ds) = e^{-w ds/2} F^-1[ e^{-k2 ds} F[ e^{-w ds/2} q(r,s) ] ]
+ *
+ * @param qin  pointer to q(r,s)
+ * @param qout pointer to q(r,s+ds) (supplied by caller)
+ */
+    virtual void stepQ(const FLOATTYPE* qin, FLOATTYPE* qout);
+
+/**
+ * Split-operator step with given field/Laplacian factor lists,
+ * qout = wf*F^-1[ kf*F[ wf*qin ] ]
+ *
+ * @param qin  pointer to q(r,s)
+ * @param qout pointer to result (supplied by caller)
+ * @param wf   pointer to field factor list (fftSize)
+ * @param kf   pointer to Laplacian factor list (specSize)
+ */
+    void splitStep(const FLOATTYPE* qin, FLOATTYPE* qout,
+                   const FLOATTYPE* wf, const FLOATTYPE* kf);
+
     //
     // General data
     //
@@ -111,12 +202,32 @@ class PsFlexPseudoSpec : public virtual PsBlock<FLOATTYPE, NDIM, QTYPE> {
     /** Size of the k2, wfac lists to be FFT'd */
     size_t fftSize;
 
+    /** Size of the k2 list (smaller for half-spectrum transforms) */
+    size_t specSize;
+
     /** The field factor (exponentiated) */
     FLOATTYPE* wfac;
 
     /** FFT grid object pointer */
     PsGridBase<FLOATTYPE, NDIM>* fftGridPtr;
 
+    /** Flag for solving head/tail propagators together */
+    bool pairSolve;
+
+    /** Backward propagator qt(r) function for pair solve */
+    QTYPE qtX;
+
+    /** The Laplacian factor, list kept by the FFT object */
+    FLOATTYPE*  k2;
+
+/**
+ * Key of a k-space list of the FFT object for this block
+ *
+ * @param nm name of the list
+ * @return nm and the ds b^2 of this block
+ */
+    std::string getKTableKey(const std::string& nm);
+
   private:
 
     /** Ratio of statistical segment length reference b0 */
@@ -131,8 +242,8 @@ class PsFlexPseudoSpec : public virtual PsBlock<FLOATTYPE, NDIM, QTYPE> {
     /** Pointer to FFT interface object */
     PsFFTBase<FLOATTYPE, NDIM>* fftObjPtr;
 
-    /** The Laplacian factor */
-    FLOATTYPE*  k2;
+    /** Index of transform workspace on fftObjPtr, 0 for shared */
+    size_t fftWs;
 
     /** Initialize the "Laplacian" list */
     void build_k2();
@@ -140,11 +251,23 @@ class PsFlexPseudoSpec : public virtual PsBlock<FLOATTYPE, NDIM, QTYPE> {
     /** Initialize the "Laplacian" list */
     void build_k2_transpose();
 
+    /** Initialize the k_i^2 lists in the layout of k2 */
+    void build_kDir2();
+
+    /** Grid directions with more than one cell */
+    std::vector<size_t> stressDirs;
+
+    /** The k_i^2 lists (half-spectrum weighted) for stressDirs */
+    std::vector<FLOATTYPE> kDir2;
+
+    /** Re[conj(F[q]) F[qt]] of one contour slice */
+    std::vector<FLOATTYPE> stressRes;
+
     /** The product list for q(r,s)*w(r) */
     FLOATTYPE* qw;
 
-    /** A result holder for safety */
-    FLOATTYPE* resPtr;
+    /** The product list for qt(r,s)*w(r) for pair solve */
+    FLOATTYPE* qtw;
 
     /** Make private to prevent use */
     PsFlexPseudoSpec(const PsFlexPseudoSpec<FLOATTYPE, NDIM, QTYPE>& psfb);
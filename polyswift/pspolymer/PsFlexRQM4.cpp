@@ -0,0 +1,129 @@
+/**
+ * @file    PsFlexRQM4.cpp
+ *
+ * @brief   Class for solving propagators for flexible Gaussian blocks
+ *          with the fourth-order (Richardson) pseudo-spectral algorithm
+ *
+ * @version $Id: PsFlexRQM4.cpp 8257 2007-09-12 22:05:20Z swsides $
+ *
+ * Copyright &copy; 2008-2020, Tech-X Corporation, Boulder, CO.
+ * All rights reserved.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+// std includes
+#include <cmath>
+
+// pspolymer includes
+#include <PsFlexRQM4.h>
+
+// Constructor
+template <class FLOATTYPE, size_t NDIM, class QTYPE>
+PsFlexRQM4<FLOATTYPE, NDIM, QTYPE>::PsFlexRQM4() {
+
+  // Same q(r,s) rank as flexPseudoSpec for convertQ in PsBlockBase
+  this->blockTypeStr = "flexibleBlock";
+
+  wfacHalf = NULL;
+  k2Half   = NULL;
+  qFull    = NULL;
+  qHalf    = NULL;
+}
+
+// Destructor
+template <class FLOATTYPE, size_t NDIM, class QTYPE>
+PsFlexRQM4<FLOATTYPE, NDIM, QTYPE>::~PsFlexRQM4() {
+  delete[] wfacHalf;
+  delete[] qFull;
+  delete[] qHalf;
+}
+
+//
+// build data
+//
+template <class FLOATTYPE, size_t NDIM, class QTYPE>
+void PsFlexRQM4<FLOATTYPE, NDIM, QTYPE>::buildData() {
+
+  // Scoping call to base class
+  PsFlexPseudoSpec<FLOATTYPE, NDIM, QTYPE>::buildData();
+  this->dbprt("PsFlexRQM4::buildData() ");
+
+  wfacHalf = new FLOATTYPE[this->qTotalSize];
+  qFull    = new FLOATTYPE[this->qTotalSize];
+  qHalf    = new FLOATTYPE[this->qTotalSize];
+}
+
+//
+// Half-step Laplacian factor exp(-ds/2 k2 b^2) is the square root
+// of the full-step one, so it uses the same layout as k2
+//
+template <class FLOATTYPE, size_t NDIM, class QTYPE>
+void PsFlexRQM4<FLOATTYPE, NDIM, QTYPE>::buildSolvers() {
+
+  // Scoping call to base class
+  PsFlexPseudoSpec<FLOATTYPE, NDIM, QTYPE>::buildSolvers();
+  this->dbprt("PsFlexRQM4::buildSolvers() ");
+
+  bool newK2 = false;
+  k2Half = this->fftObjPtr->getKTable(this->getKTableKey("k2Half"), newK2);
+  if (newK2) {
+    for (size_t n=0; n<this->specSize; ++n)
+      k2Half[n] = std::sqrt(this->k2[n]);
+  }
+}
+
+//
+// New cell sizes, half-step factor follows the full-step one
+//
+template <class FLOATTYPE, size_t NDIM, class QTYPE>
+void PsFlexRQM4<FLOATTYPE, NDIM, QTYPE>::rebuildKSpace() {
+
+  // Scoping call to base class
+  PsFlexPseudoSpec<FLOATTYPE, NDIM, QTYPE>::rebuildKSpace();
+
+  for (size_t n=0; n<this->specSize; ++n)
+    k2Half[n] = std::sqrt(this->k2[n]);
+}
+
+//
+// Half-step field factor exp(-ds/4 w) from the full-step
+// exp(-ds/2 w), so any derived field contributions are included
+//
+template <class FLOATTYPE, size_t NDIM, class QTYPE>
+void PsFlexRQM4<FLOATTYPE, NDIM, QTYPE>::reset() {
+
+  // Scoping call to base class, sets wfac
+  PsFlexPseudoSpec<FLOATTYPE, NDIM, QTYPE>::reset();
+  this->dbprt("PsFlexRQM4::reset() ");
+
+  for (size_t n=0; n<this->fftSize; ++n)
+    wfacHalf[n] = std::sqrt(this->wfac[n]);
+}
+
+//
+// Richardson combination of one full step and two half steps
+//
+template <class FLOATTYPE, size_t NDIM, class QTYPE>
+void PsFlexRQM4<FLOATTYPE, NDIM, QTYPE>::stepQ(const FLOATTYPE* qin,
+                                              FLOATTYPE* qout) {
+
+  this->splitStep(qin, qFull, this->wfac, this->k2);
+  this->splitStep(qin, qHalf, wfacHalf, k2Half);
+  this->splitStep(qHalf, qout, wfacHalf, k2Half);
+
+  FLOATTYPE third = 1.0/3.0;
+  for (size_t n=0; n<this->fftSize; ++n)
+    qout[n] = (4.0*qout[n] - qFull[n])*third;
+}
+
+// Instantiate classes (for flexible block model)
+template class PsFlexRQM4<float, 1, PsBlockTypes<float, 1>::flexQType >;
+template class PsFlexRQM4<float, 2, PsBlockTypes<float, 2>::flexQType >;
+template class PsFlexRQM4<float, 3, PsBlockTypes<float, 3>::flexQType >;
+
+template class PsFlexRQM4<double, 1, PsBlockTypes<double, 1>::flexQType >;
+template class PsFlexRQM4<double, 2, PsBlockTypes<double, 2>::flexQType >;
+template class PsFlexRQM4<double, 3, PsBlockTypes<double, 3>::flexQType >;
@@ -0,0 +1,118 @@
+/**
+ * @file    PsFlexRQM4.h
+ *
+ * @brief   Class for solving propagators for flexible Gaussian blocks
+ *          with the fourth-order (Richardson) pseudo-spectral algorithm
+ *
+ * @version $Id: PsFlexRQM4.h 8199 2007-09-05 05:07:11Z swsides $
+ *
+ * Copyright &copy; 2008-2020, Tech-X Corporation, Boulder, CO.
+ * All rights reserved.
+ */
+
+#ifndef PS_FLEX_RQM4_H
+#define PS_FLEX_RQM4_H
+
+// configure stuff
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+// pspolymer includes
+#include <PsFlexPseudoSpec.h>
+
+/**
+ * A PsFlexRQM4 object solves the flexible Gaussian propagator
+ * with the RQM4 scheme. Each contour step is the Richardson
+ * combination
+ *
+ * q(r,s+ds) = [ 4 q_{ds/2}(q_{ds/2}(q)) - q_{ds}(q) ] / 3
+ *
+ * of one full split-operator step and two half steps, which
+ * cancels the O(ds^3) local error of the split operator. The
+ * same free-energy error is reached with 3-4x fewer contour
+ * steps than flexPseudoSpec for three times the FFTs per step.
+ *
+ * @param FLOATTYPE numeric type of the data.
+ * @param NDIM dimensionality of the physical space
+ * @param QTYPE PsField type for the q(X) part of q(X,s)
+ */
+
+template <class FLOATTYPE, size_t NDIM, class QTYPE>
+class PsFlexRQM4 : public virtual PsFlexPseudoSpec<FLOATTYPE, NDIM, QTYPE> {
+
+  public:
+
+/**
+ * Constructor
+ */
+    PsFlexRQM4();
+
+/**
+ * Destructor
+ */
+    virtual ~PsFlexRQM4();
+
+/**
+ * Build the data, such as updaters, initial condition setters, ...
+ */
+    virtual void buildData();
+
+/**
+ * Build the solvers etc.
+ */
+    virtual void buildSolvers();
+
+/**
+ * Reset specific flexible block values before update calls,
+ * sets field factors for both full and half steps
+ */
+    virtual void reset();
+
+/**
+ * Rebuild the full and half-step Laplacian factors
+ */
+    virtual void rebuildKSpace();
+
+/**
+ * Pair solve is only written for the second-order step
+ *
+ * @return false
+ */
+    virtual bool canSolveQPair() {
+      return false;
+    }
+
+  protected:
+
+/**
+ * Advance a propagator one contour step ds with the RQM4 scheme
+ *
+ * @param qin  pointer to q(r,s)
+ * @param qout pointer to q(r,s+ds) (supplied by caller)
+ */
+    virtual void stepQ(const FLOATTYPE* qin, FLOATTYPE* qout);
+
+  private:
+
+    /** The field factor for half step ds/2 */
+    FLOATTYPE* wfacHalf;
+
+    /** The Laplacian factor for half step ds/2, kept by the FFT object */
+    FLOATTYPE* k2Half;
+
+    /** Result of one full step */
+    FLOATTYPE* qFull;
+
+    /** Result of first half step */
+    FLOATTYPE* qHalf;
+
+    /** Make private to prevent use */
+    PsFlexRQM4(const PsFlexRQM4<FLOATTYPE, NDIM, QTYPE>& psfb);
+
+    /** Make private to prevent use */
+    PsFlexRQM4<FLOATTYPE, NDIM, QTYPE>& operator=(
+        const PsFlexRQM4<FLOATTYPE, NDIM, QTYPE>& psfb);
+};
+
+#endif  // PS_FLEX_RQM4_H
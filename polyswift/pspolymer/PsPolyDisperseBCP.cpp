@@ -21,16 +21,24 @@
 #include <sstream>
 #include <iostream>
 #include <fstream>
+#include <algorithm>
 
 // Constructor
 template <class FLOATTYPE, size_t NDIM>
 PsPolyDisperseBCP<FLOATTYPE, NDIM>::PsPolyDisperseBCP() {
+  sharedPrefix = false;
+  splitQuadrature = false;
+  groupGridPtr = NULL;
+  groupCommPtr = NULL;
+  numGroups = 1;
+  myGroup = 0;
 }
 
 // Destructor
 template <class FLOATTYPE, size_t NDIM>
 PsPolyDisperseBCP<FLOATTYPE, NDIM>::~PsPolyDisperseBCP() {
   delete quadGL;
+  delete groupCommPtr;
 }
 
 //
@@ -90,6 +98,39 @@ void PsPolyDisperseBCP<FLOATTYPE, NDIM>::setAttrib(const TxHierAttribSetIntDbl&
     throw tde;
   }
 
+  // Solve longest polydisperse quadrature block only
+  if (tas.hasString("sharedPrefix")) {
+    std::string pStr = tas.getString("sharedPrefix");
+    if (pStr == "on") sharedPrefix = true;
+  }
+
+  // Solve the quadrature chains on groups of ranks, each
+  // group on a replicated grid
+  if (tas.hasString("splitQuadrature")) {
+    std::string sStr = tas.getString("splitQuadrature");
+    if (sStr == "on") splitQuadrature = true;
+  }
+
+  if (splitQuadrature) {
+    if (tas.hasString("groupGrid")) {
+      groupGridName = tas.getString("groupGrid");
+    }
+    else {
+      TxDebugExcept tde("PsPolyDisperseBCP::setAttrib");
+      tde << " groupGrid not set: name of replicated grid needed";
+      tde << " with splitQuadrature in <Polymer " << this->getName() << " >";
+      throw tde;
+    }
+
+    // Prefix blocks read the longest chain, which may be remote
+    if (sharedPrefix) {
+      TxDebugExcept tde("PsPolyDisperseBCP::setAttrib");
+      tde << " sharedPrefix can not be used with splitQuadrature";
+      tde << " in <Polymer " << this->getName() << " >";
+      throw tde;
+    }
+  }
+
   //
   // Build raw abscissas and weights
   // Loop through blocks 'global' polydispersity variables
@@ -150,6 +191,8 @@ void PsPolyDisperseBCP<FLOATTYPE, NDIM>::buildData() {
   PsPolymer<FLOATTYPE, NDIM>::buildData();
   this->dbprt("PsPolyDisperseBCP::buildData() ");
 
+  if (splitQuadrature) buildGroups();
+
   //
   // Loop on block groups and create PsBlockBase objects
   //
@@ -186,6 +229,12 @@ void PsPolyDisperseBCP<FLOATTYPE, NDIM>::buildData() {
       // Set name of container polymer in block before buildData
       blockPtr->setPolymerName(this->getName());
 
+      // Chain iq is solved by rank group iq % numGroups
+      if (splitQuadrature) {
+        blockPtr->setGroupGrid(groupGridPtr, groupCommPtr);
+        blockPtr->setRemote(iq % numGroups != myGroup);
+      }
+
       // Build data call for specific block
       // Sets size of q(X) so other parts of blocks can be built
       blockPtr->buildData();
@@ -273,6 +322,93 @@ void PsPolyDisperseBCP<FLOATTYPE, NDIM>::buildData() {
   }
 }
 
+template <class FLOATTYPE, size_t NDIM>
+void PsPolyDisperseBCP<FLOATTYPE, NDIM>::buildSolvers() {
+
+  // Scoping call to base class
+  PsBlockCopolymer<FLOATTYPE, NDIM>::buildSolvers();
+  this->dbprt("PsPolyDisperseBCP::buildSolvers() ");
+
+  if (sharedPrefix) buildSharedPrefix();
+}
+
+//
+// Quadrature blocks of the polydisperse block differ only in length
+// and see the same w-field. If the initial q at both ends is the same
+// for all of them (free ends, or junctions with equivalent free arms)
+// the propagators of a shorter block are the first slices of the
+// longest block's, so only the longest is solved
+//
+template <class FLOATTYPE, size_t NDIM>
+void PsPolyDisperseBCP<FLOATTYPE, NDIM>::buildSharedPrefix() {
+
+  for (size_t ig=0; ig<blockGroups.size(); ++ig) {
+
+    BlockGrp bG = blockGroups[ig];
+    if (bG.origName != polyBlockName) continue;
+
+    // Block indices of the group, find longest
+    std::vector<size_t> quadIndx;
+    for (size_t iq=0; iq<bG.quadBlkPtrs.size(); ++iq) {
+      for (size_t n=0; n<this->numBlocks; ++n)
+        if (this->blocks[n] == bG.quadBlkPtrs[iq]) quadIndx.push_back(n);
+    }
+
+    size_t longIndx = quadIndx[0];
+    for (size_t iq=1; iq<quadIndx.size(); ++iq) {
+      size_t n = quadIndx[iq];
+      if (this->blocks[n]->getLengthFrac() >
+          this->blocks[longIndx]->getLengthFrac()) longIndx = n;
+    }
+
+    for (size_t iq=0; iq<quadIndx.size(); ++iq) {
+
+      size_t n = quadIndx[iq];
+      if (n == longIndx) continue;
+      if (!hasSameJunction(n, longIndx, HEAD)) continue;
+      if (!hasSameJunction(n, longIndx, TAIL)) continue;
+
+      if (this->blocks[n]->setPrefixOf(this->blocks[longIndx])) {
+        this->prefixRep[n] = longIndx;
+        this->pprt("Block ", bG.quadNames[iq], " is a prefix of ",
+                   this->blocks[longIndx]->getName());
+      }
+    }
+  }
+}
+
+//
+// Junction blocks must match one-to-one, join at the same end type
+// and have a free other end so their solve towards the junction
+// does not depend on the quadrature block
+//
+template <class FLOATTYPE, size_t NDIM>
+bool PsPolyDisperseBCP<FLOATTYPE, NDIM>::hasSameJunction(size_t k, size_t l,
+                                                         BlockEndType end) {
+
+  std::vector<std::pair<size_t, BlockEndType> > kCntTo =
+    this->blocks[k]->getCntTo(end);
+  std::vector<std::pair<size_t, BlockEndType> > lCntTo =
+    this->blocks[l]->getCntTo(end);
+  if (kCntTo.size() != lCntTo.size()) return false;
+
+  for (size_t n=0; n<kCntTo.size(); ++n) {
+
+    PsBlockBase<FLOATTYPE, NDIM>* kJntPtr = this->blocks[kCntTo[n].first];
+    PsBlockBase<FLOATTYPE, NDIM>* lJntPtr = this->blocks[lCntTo[n].first];
+    BlockEndType jntEnd = kCntTo[n].second;
+
+    if (jntEnd != lCntTo[n].second) return false;
+    if (!kJntPtr->isEquivalentTo(lJntPtr)) return false;
+
+    BlockEndType freeEnd = kJntPtr->getOtherEnd(jntEnd);
+    if (kJntPtr->getCntTo(freeEnd).size() != 0) return false;
+    if (lJntPtr->getCntTo(freeEnd).size() != 0) return false;
+  }
+
+  return true;
+}
+
 //
 // Get the natural-log of the single-chain partition function
 // normalization value. For polydispserse BCP this is a weighted
@@ -316,11 +452,17 @@ void PsPolyDisperseBCP<FLOATTYPE, NDIM>::update(double t) {
   // Local block pointer
   //  PsBlockBase<FLOATTYPE, NDIM>* blockPtr;
 
+  // Blocks on the group grid see whole-grid w-fields
+  if (splitQuadrature) setGroupFields();
+
   // ResetsInitialize all blocks -- resets data/switches before update
   for (size_t i=0; i<this->numBlocks; ++i) {
     this->blocks[i]->reset();
   }
 
+  // Concurrent solves of ready block ends (if numThreads > 1)
+  this->updateBlocksParallel();
+
   /*
    * Continue looping over blocks until all propagators are
    * calculated. Driver for helper method, updateBlockQ, which
@@ -329,6 +471,7 @@ void PsPolyDisperseBCP<FLOATTYPE, NDIM>::update(double t) {
   while (!this->areAllBlocksUpdated() ) {
     for (size_t nblock=0; nblock<this->numBlocks; ++nblock) {
       // Series of "blockPtr->solveQ(end)"
+      this->updateBlockQPair(nblock);
       this->updateBlockQ(nblock,HEAD);
       this->updateBlockQ(nblock,TAIL);
     }
@@ -342,6 +485,7 @@ void PsPolyDisperseBCP<FLOATTYPE, NDIM>::update(double t) {
 
     BlockGrp bG = blockGroups[ig];
     for (size_t iq=0; iq<bG.quadBigQs.size(); ++iq) {
+      if (bG.quadBlkPtrs[iq]->isRemote()) continue;
       FLOATTYPE bigQ = bG.quadBlkPtrs[iq]->calcBigQ();
       bG.quadBigQs[iq] = bigQ;
     }
@@ -357,6 +501,7 @@ void PsPolyDisperseBCP<FLOATTYPE, NDIM>::update(double t) {
 
     BlockGrp bG = blockGroups[ig];
     for (size_t iq=0; iq<bG.quadBigQs.size(); ++iq) {
+      if (bG.quadBlkPtrs[iq]->isRemote()) continue;
       FLOATTYPE bigQ = bG.quadBigQs[iq];
       bG.quadBlkPtrs[iq]->setCalcQQTIntegral(bigQ);
     }
@@ -367,10 +512,151 @@ void PsPolyDisperseBCP<FLOATTYPE, NDIM>::update(double t) {
    * result. Calculates appropriate densities and
    * sets those values in the held PhysFields
    */
+  if (splitQuadrature) {
+    combineGroupDensities();
+    return;
+  }
+
   for (size_t i=0; i<this->numBlocks; ++i)
     this->blocks[i]->setPhysFields();
 }
 
+//
+// Quadrature chains are independent full chains that only meet in
+// the densities and the weighted sum of log(bigQ). Chain iq is solved
+// by the ranks of group iq % numGroups on a replicated grid, so the
+// groups work on different chains at the same time. Ranks of one
+// group solve the same chain on the whole grid.
+//
+template <class FLOATTYPE, size_t NDIM>
+void PsPolyDisperseBCP<FLOATTYPE, NDIM>::buildGroups() {
+
+  groupGridPtr =
+    PsNamedObject::getObject<PsGridBase<FLOATTYPE, NDIM> >(groupGridName);
+  if (!groupGridPtr || !groupGridPtr->getDecomp().isReplicated()) {
+    TxDebugExcept tde("PsPolyDisperseBCP::buildGroups: groupGrid ");
+    tde << groupGridName << " is not a grid with a replicated decomp";
+    tde << " in <Polymer " << this->getName() << " >";
+    throw tde;
+  }
+
+  // Fields are exchanged as x slabs in rank order
+  if (this->getGridBase().getDecomp().isTransposed()) {
+    TxDebugExcept tde("PsPolyDisperseBCP::buildGroups: splitQuadrature");
+    tde << " needs a simulation grid in x slabs";
+    tde << " in <Polymer " << this->getName() << " >";
+    throw tde;
+  }
+
+  // Group grid holds whole copies of the simulation grid fields
+  std::vector<size_t> groupCells = groupGridPtr->getNumCellsGlobal();
+  std::vector<size_t> simCells = this->getGridBase().getNumCellsGlobal();
+  if (groupCells != simCells) {
+    TxDebugExcept tde("PsPolyDisperseBCP::buildGroups: groupGrid ");
+    tde << groupGridName << " global size does not match the";
+    tde << " simulation grid in <Polymer " << this->getName() << " >";
+    throw tde;
+  }
+
+  size_t numRanks = this->getCommBase().getSize();
+  numGroups = std::min(numRanks, n_g);
+  myGroup = this->getCommBase().getRank() % numGroups;
+  groupCommPtr = this->getCommBase().split(myGroup);
+
+  this->pprt("Quadrature chains solved on rank groups: ", (int)numGroups);
+}
+
+//
+// Whole-grid copies of the w-fields, gathered from the simulation
+// grid slabs. All ranks gather the PhysFields in the same block order
+//
+template <class FLOATTYPE, size_t NDIM>
+void PsPolyDisperseBCP<FLOATTYPE, NDIM>::setGroupFields() {
+
+  PsCommBase<FLOATTYPE, NDIM>& comm = this->getCommBase();
+  size_t numRanks = comm.getSize();
+
+  // Constraint volume over the whole grid
+  PsPhysField<FLOATTYPE, NDIM>* wallPtr =
+    PsNamedObject::getObject<PsPhysField<FLOATTYPE, NDIM> >("defaultPressure");
+  FLOATTYPE wallVol = comm.allReduceSum(wallPtr->calcLocalVolume());
+
+  std::set<PsPhysField<FLOATTYPE, NDIM>*> gathered;
+  for (size_t n=0; n<this->numBlocks; ++n) {
+
+    PsPhysField<FLOATTYPE, NDIM>* physPtr =
+      this->blocks[n]->getMonoDensPhysField();
+    std::vector<FLOATTYPE>& wGroup = groupWFields[physPtr];
+
+    if (gathered.count(physPtr) == 0) {
+      gathered.insert(physPtr);
+      PsFieldBase<FLOATTYPE>& wField = physPtr->getConjgField();
+      FLOATTYPE* wData = wField.getDataPtr();
+
+      if (numRanks == 1) {
+        wGroup.assign(wData, wData + wField.getSize());
+      }
+      else {
+        FLOATTYPE* recvData;
+        size_t* recvSize;
+        size_t* displs;
+        comm.allGatherV(wData, wField.getSize(), recvData, recvSize, displs);
+        size_t totalSize = displs[numRanks-1] + recvSize[numRanks-1];
+        wGroup.assign(recvData, recvData + totalSize);
+        delete[] recvData;
+        delete[] recvSize;
+        delete[] displs;
+      }
+    }
+
+    this->blocks[n]->setGroupFields(&wGroup[0], wallVol);
+  }
+}
+
+//
+// Densities of all blocks and the chain bigQs are summed over all
+// ranks in one reduction, where only the first rank of the group
+// solving a chain contributes. Each rank then adds its slab of the
+// simulation grid to the PhysFields.
+//
+template <class FLOATTYPE, size_t NDIM>
+void PsPolyDisperseBCP<FLOATTYPE, NDIM>::combineGroupDensities() {
+
+  size_t numBlocks = this->numBlocks;
+  size_t groupSize = groupGridPtr->getTotalCellsGlobal();
+  size_t bufSize = numBlocks*groupSize + n_g;
+  groupDens.assign(bufSize, 0.0);
+  groupDensSum.resize(bufSize);
+
+  if (groupCommPtr->getRank() == 0) {
+    for (size_t n=0; n<numBlocks; ++n) {
+      if (this->blocks[n]->isRemote()) continue;
+      const FLOATTYPE* densData = this->blocks[n]->calcDensity();
+      std::copy(densData, densData + groupSize, &groupDens[n*groupSize]);
+    }
+    for (size_t iq=0; iq<n_g; ++iq) {
+      if (blockGroups[0].quadBlkPtrs[iq]->isRemote()) continue;
+      groupDens[numBlocks*groupSize + iq] = blockGroups[0].quadBigQs[iq];
+    }
+  }
+
+  this->getCommBase().allReduceSumVec(&groupDens[0], bufSize,
+                                      &groupDensSum[0]);
+
+  // Chain bigQs for getLogBigQ
+  for (size_t ig=0; ig<blockGroups.size(); ++ig) {
+    for (size_t iq=0; iq<n_g; ++iq)
+      blockGroups[ig].quadBigQs[iq] = groupDensSum[numBlocks*groupSize + iq];
+  }
+
+  // Local x slab of the simulation grid
+  PsGridBase<FLOATTYPE, NDIM>& grid = this->getGridBase();
+  size_t planeSize = groupSize/grid.getNumCellsGlobal()[0];
+  size_t offset = grid.getDecomp().getLocalToGlobalShifts()[0]*planeSize;
+  for (size_t n=0; n<numBlocks; ++n)
+    this->blocks[n]->addDensity(&groupDensSum[n*groupSize + offset]);
+}
+
           // *************************** //
           //   Private helper methods    //
           // *************************** //
@@ -15,6 +15,7 @@
 // std includes
 #include <vector>
 #include <map>
+#include <set>
 
 // configure stuff
 #ifdef HAVE_CONFIG_H
@@ -74,6 +75,13 @@ class PsPolyDisperseBCP : public PsBlockCopolymer<FLOATTYPE, NDIM> {
  */
     virtual void buildData();
 
+/**
+ * Builds block solvers, then with sharedPrefix = on makes the
+ * shorter quadrature blocks of the polydisperse block read their
+ * propagators off the longest one in the group
+ */
+    virtual void buildSolvers();
+
 /**
  * Update polydisperse copolymer
  * ...
@@ -91,6 +99,18 @@ class PsPolyDisperseBCP : public PsBlockCopolymer<FLOATTYPE, NDIM> {
  */
     virtual FLOATTYPE getLogBigQ();
 
+/**
+ * Box-length derivatives need the quadrature weights of each
+ * length group, not implemented
+ *
+ * @param cs true to calculate
+ */
+    virtual void setCalcStress(bool cs) {
+      TxDebugExcept tde("PsPolyDisperseBCP::setCalcStress not implemented");
+      tde << " for <Polymer " << this->getName() << " >";
+      throw tde;
+    }
+
   protected:
 
   private:
@@ -116,6 +136,73 @@ class PsPolyDisperseBCP : public PsBlockCopolymer<FLOATTYPE, NDIM> {
     /** vector of scaled lengths for polydisperse block */
     std::vector<FLOATTYPE> fmk_vec;
 
+    /** Flag for solving only the longest polydisperse quadrature block */
+    bool sharedPrefix;
+
+    /** Flag for solving the quadrature chains on groups of ranks */
+    bool splitQuadrature;
+
+    /** Name of replicated grid the groups solve on */
+    std::string groupGridName;
+
+    /** Replicated grid the groups solve on */
+    PsGridBase<FLOATTYPE, NDIM>* groupGridPtr;
+
+    /** Communicator of the group of this rank (owned) */
+    PsCommBase<FLOATTYPE, NDIM>* groupCommPtr;
+
+    /** Number of rank groups */
+    size_t numGroups;
+
+    /** Group of this rank */
+    size_t myGroup;
+
+    /** Whole-grid w-fields, for each monomer PhysField */
+    std::map<PsPhysField<FLOATTYPE, NDIM>*, std::vector<FLOATTYPE> > groupWFields;
+
+    /** Densities of all blocks and chain bigQs on this rank */
+    std::vector<FLOATTYPE> groupDens;
+
+    /** Densities of all blocks and chain bigQs summed over ranks */
+    std::vector<FLOATTYPE> groupDensSum;
+
+/**
+ * Split the simulation communicator into groups of ranks for
+ * the quadrature chains: helper method for buildData()
+ */
+    void buildGroups();
+
+/**
+ * Gather the whole-grid w-fields for the blocks on the group
+ * grid: helper method for update()
+ */
+    void setGroupFields();
+
+/**
+ * Sum the block densities and chain bigQs of all groups and add
+ * the local slab to the PhysFields: helper method for update()
+ */
+    void combineGroupDensities();
+
+/**
+ * Set the shorter polydisperse quadrature blocks as prefixes of
+ * the longest one where the initial q at both ends is the same for
+ * all of them: helper method for buildSolvers()
+ */
+    void buildSharedPrefix();
+
+/**
+ * Check that the blocks joined at an end of quadrature blocks
+ * k and l are equivalent and free at their other end, so the
+ * initial q at that end is the same for both blocks
+ *
+ * @param k   index of quadrature block
+ * @param l   index of other quadrature block
+ * @param end head or tail
+ * @return true if the initial q at end is the same
+ */
+    bool hasSameJunction(size_t k, size_t l, BlockEndType end);
+
 /**
  * Calculate average contribution to overall length fraction
  * Correct scaling factor for polydisperse block and monodisperse block
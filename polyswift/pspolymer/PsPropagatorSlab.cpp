@@ -0,0 +1,60 @@
+/**
+ * @file    PsPropagatorSlab.cpp
+ *
+ * @brief   Contiguous storage for the contour slices of q(X,s)
+ *
+ * @version $Id: PsPropagatorSlab.cpp 8199 2007-09-05 05:07:11Z swsides $
+ *
+ * Copyright &copy; 2012-2020, Tech-X Corporation, Boulder, CO.
+ * All rights reserved.
+ */
+
+// std includes
+#include <cstring>
+
+// pspolymer includes
+#include <PsPropagatorSlab.h>
+
+template <class FLOATTYPE>
+PsPropagatorSlab<FLOATTYPE>::PsPropagatorSlab() {
+  numSlices = 0;
+  sliceSize = 0;
+  stride = 0;
+  rawData = NULL;
+  slab = NULL;
+}
+
+template <class FLOATTYPE>
+PsPropagatorSlab<FLOATTYPE>::~PsPropagatorSlab() {
+  delete[] rawData;
+}
+
+template <class FLOATTYPE>
+void PsPropagatorSlab<FLOATTYPE>::resize(size_t nslices, size_t ssize) {
+
+  delete[] rawData;
+
+  numSlices = nslices;
+  sliceSize = ssize;
+
+  // Round slice length up so every slice starts aligned
+  size_t perAlign = alignBytes/sizeof(FLOATTYPE);
+  stride = ((sliceSize + perAlign - 1)/perAlign)*perAlign;
+
+  // Over-allocate and shift start to aligned address
+  size_t nbytes = numSlices*stride*sizeof(FLOATTYPE) + alignBytes;
+  rawData = new char[nbytes];
+  size_t addr = reinterpret_cast<size_t>(rawData);
+  size_t shift = (alignBytes - (addr % alignBytes)) % alignBytes;
+  slab = reinterpret_cast<FLOATTYPE*>(rawData + shift);
+
+  for (size_t n=0; n<numSlices*stride; ++n) slab[n] = 0.0;
+}
+
+template <class FLOATTYPE>
+void PsPropagatorSlab<FLOATTYPE>::setSlice(size_t s, const FLOATTYPE* data) {
+  std::memcpy(getSlice(s), data, sliceSize*sizeof(FLOATTYPE));
+}
+
+template class PsPropagatorSlab<float>;
+template class PsPropagatorSlab<double>;
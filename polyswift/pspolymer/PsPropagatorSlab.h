@@ -0,0 +1,124 @@
+/**
+ * @file    PsPropagatorSlab.h
+ *
+ * @brief   Contiguous storage for the contour slices of q(X,s)
+ *
+ * @version $Id: PsPropagatorSlab.h 8199 2007-09-05 05:07:11Z swsides $
+ *
+ * Copyright &copy; 2012-2020, Tech-X Corporation, Boulder, CO.
+ * All rights reserved.
+ */
+
+#ifndef PS_PROPAGATOR_SLAB_H
+#define PS_PROPAGATOR_SLAB_H
+
+// standard headers
+#include <cstddef>
+
+// configure stuff
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+/**
+ * A PsPropagatorSlab object holds all contour slices q(X,s_0..s_N)
+ * of one propagator in a single allocation. Each slice starts on
+ * an aligned boundary so solvers can write a contour step in place
+ * and integrators can read slices as plain views (no copies).
+ *
+ * @param FLOATTYPE numeric type of the data.
+ */
+template <class FLOATTYPE>
+class PsPropagatorSlab {
+
+  public:
+
+/**
+ * Constructor
+ */
+  PsPropagatorSlab();
+
+/**
+ * Destructor
+ */
+  virtual ~PsPropagatorSlab();
+
+/**
+ * Allocate the slab, previous contents are lost
+ *
+ * @param numSlices number of contour slices (blockSteps+1)
+ * @param sliceSize number of values in each slice
+ */
+  void resize(size_t numSlices, size_t sliceSize);
+
+/**
+ * Get pointer to contour slice
+ *
+ * @param s slice index
+ * @return pointer to first value of slice s
+ */
+  FLOATTYPE* getSlice(size_t s) {
+    return slab + s*stride;
+  }
+
+/**
+ * Get const pointer to contour slice
+ *
+ * @param s slice index
+ * @return pointer to first value of slice s
+ */
+  const FLOATTYPE* getSlice(size_t s) const {
+    return slab + s*stride;
+  }
+
+/**
+ * Copy values into a contour slice
+ *
+ * @param s    slice index
+ * @param data pointer to sliceSize values
+ */
+  void setSlice(size_t s, const FLOATTYPE* data);
+
+/**
+ * Get number of contour slices
+ */
+  size_t getNumSlices() const {
+    return numSlices;
+  }
+
+/**
+ * Get number of values in each slice
+ */
+  size_t getSliceSize() const {
+    return sliceSize;
+  }
+
+  private:
+
+    /** Alignment in bytes for the start of each slice */
+    static const size_t alignBytes = 64;
+
+    /** Number of contour slices */
+    size_t numSlices;
+
+    /** Number of values in each slice */
+    size_t sliceSize;
+
+    /** Distance between slice starts (sliceSize rounded up) */
+    size_t stride;
+
+    /** Raw allocation */
+    char* rawData;
+
+    /** Aligned start of slab within rawData */
+    FLOATTYPE* slab;
+
+    /** Make private to prevent use */
+    PsPropagatorSlab(const PsPropagatorSlab<FLOATTYPE>& pps);
+
+    /** Make private to prevent use */
+    PsPropagatorSlab<FLOATTYPE>& operator=(
+        const PsPropagatorSlab<FLOATTYPE>& pps);
+};
+
+#endif // PS_PROPAGATOR_SLAB_H
@@ -0,0 +1,178 @@
+/**
+ * @file    PsSpectralInterp.cpp
+ *
+ * @brief   Fourier interpolation of periodic grid data onto a finer grid
+ *
+ * @version $Id: PsSpectralInterp.cpp 6423 2007-01-11 20:32:39Z sizemore $
+ *
+ * Copyright &copy; 2007-2020, Tech-X Corporation, Boulder, CO.
+ * All rights reserved.
+ */
+
+// std includes
+#include <cmath>
+
+// psstd includes
+#include <PsSpectralInterp.h>
+
+template <class FLOATTYPE>
+PsSpectralInterp<FLOATTYPE>::PsSpectralInterp() {
+  for (size_t d=0; d<3; ++d) {
+    numCoarse[d] = 1;
+    numFine[d] = 1;
+  }
+}
+
+template <class FLOATTYPE>
+PsSpectralInterp<FLOATTYPE>::~PsSpectralInterp() {
+  for (size_t d=0; d<3; ++d) interpMat[d].clear();
+  workX.clear();
+  workY.clear();
+}
+
+template <class FLOATTYPE>
+void PsSpectralInterp<FLOATTYPE>::setDims(
+    const std::vector<size_t>& coarseDims,
+    const std::vector<size_t>& fineDims,
+    const std::vector<size_t>& fineBeg,
+    const std::vector<size_t>& fineLen) {
+
+  for (size_t d=0; d<3; ++d) {
+
+    size_t nc = (d < coarseDims.size()) ? coarseDims[d] : 1;
+    size_t nf = (d < fineDims.size())   ? fineDims[d]   : 1;
+    size_t nb = (d < fineBeg.size())    ? fineBeg[d]    : 0;
+    size_t nl = (d < fineLen.size())    ? fineLen[d]    : 1;
+
+    if ( (nc == 0) || (nf % nc != 0) || (nb + nl > nf) ) {
+      TxDebugExcept tde("PsSpectralInterp::setDims: bad sizes in direction ");
+      tde << d << "\n coarse cells = " << nc << "\n fine cells = " << nf;
+      tde << "\n local begin = " << nb << "\n local length = " << nl;
+      throw tde;
+    }
+
+    numCoarse[d] = nc;
+    numFine[d] = nl;
+    buildMatrix(d, nc, nf, nb);
+  }
+
+  workX.assign(numFine[0]*numCoarse[1]*numCoarse[2], 0.0);
+  workY.assign(numFine[0]*numFine[1]*numCoarse[2], 0.0);
+}
+
+//
+// Three directional passes: x, then y, then z
+//
+template <class FLOATTYPE>
+void PsSpectralInterp<FLOATTYPE>::interpolate(const FLOATTYPE* coarse,
+    FLOATTYPE* fine) {
+
+  size_t ncx = numCoarse[0], ncy = numCoarse[1], ncz = numCoarse[2];
+  size_t nfx = numFine[0],   nfy = numFine[1],   nfz = numFine[2];
+  const FLOATTYPE* mx = &interpMat[0][0];
+  const FLOATTYPE* my = &interpMat[1][0];
+  const FLOATTYPE* mz = &interpMat[2][0];
+
+  // x: (ncx, ncy, ncz) -> (nfx, ncy, ncz)
+  size_t nyz = ncy*ncz;
+  for (size_t i=0; i<nfx; ++i) {
+    FLOATTYPE* out = &workX[i*nyz];
+    for (size_t l=0; l<nyz; ++l) out[l] = 0.0;
+    for (size_t ic=0; ic<ncx; ++ic) {
+      FLOATTYPE m = mx[i*ncx + ic];
+      const FLOATTYPE* in = coarse + ic*nyz;
+      for (size_t l=0; l<nyz; ++l) out[l] += m*in[l];
+    }
+  }
+
+  // y: (nfx, ncy, ncz) -> (nfx, nfy, ncz)
+  for (size_t i=0; i<nfx; ++i) {
+    for (size_t j=0; j<nfy; ++j) {
+      FLOATTYPE* out = &workY[(i*nfy + j)*ncz];
+      for (size_t k=0; k<ncz; ++k) out[k] = 0.0;
+      for (size_t jc=0; jc<ncy; ++jc) {
+        FLOATTYPE m = my[j*ncy + jc];
+        const FLOATTYPE* in = &workX[(i*ncy + jc)*ncz];
+        for (size_t k=0; k<ncz; ++k) out[k] += m*in[k];
+      }
+    }
+  }
+
+  // z: (nfx, nfy, ncz) -> (nfx, nfy, nfz)
+  for (size_t n=0; n<nfx*nfy; ++n) {
+    const FLOATTYPE* in = &workY[n*ncz];
+    FLOATTYPE* out = fine + n*nfz;
+    for (size_t k=0; k<nfz; ++k) {
+      FLOATTYPE sum = 0.0;
+      for (size_t kc=0; kc<ncz; ++kc) sum += mz[k*ncz + kc]*in[kc];
+      out[k] = sum;
+    }
+  }
+}
+
+//
+// Trigonometric interpolant of data at the grid nodes x_n = n/N (the
+// points a DFT of length N samples), with theta = x_fine - x_coarse
+// in units of the box length
+//   M = (1/nc) [ 1 + 2 sum_{k=1}^{K} cos(2 pi k theta) + N(theta) ]
+// K = nc/2-1 and N = cos(pi nc theta) (Nyquist mode split evenly
+// between +-nc/2 as in zero-padding) for even nc, K = (nc-1)/2 and
+// N = 0 for odd nc. Equal sizes give the identity.
+//
+// Every ratio-th fine node is a coarse node, where M is the unit
+// row. Those rows are checked against the kernel and then set
+// exactly so that refining returns the coarse values there.
+//
+template <class FLOATTYPE>
+void PsSpectralInterp<FLOATTYPE>::buildMatrix(size_t dir, size_t nc,
+    size_t nf, size_t beg) {
+
+  size_t nl = numFine[dir];
+  interpMat[dir].assign(nl*nc, 0.0);
+
+  if (nc == nf) {
+    for (size_t j=0; j<nl; ++j) interpMat[dir][j*nc + beg + j] = 1.0;
+    return;
+  }
+
+  size_t ratio = nf/nc;
+  bool evenNc = (nc % 2 == 0);
+  size_t kmax = evenNc ? nc/2 - 1 : (nc - 1)/2;
+  double twoPi = 2.0*M_PI;
+  double tol = 1.0e-10*(double)nc;
+
+  for (size_t j=0; j<nl; ++j) {
+    double xf = (double)(beg + j)/(double)nf;
+    bool onCoarse = ((beg + j) % ratio == 0);
+    size_t ic = (beg + j)/ratio;
+    double maxErr = 0.0;
+
+    for (size_t i=0; i<nc; ++i) {
+      double theta = xf - (double)i/(double)nc;
+      double sum = 1.0;
+      for (size_t k=1; k<=kmax; ++k) sum += 2.0*std::cos(twoPi*k*theta);
+      if (evenNc) sum += std::cos(M_PI*nc*theta);
+      sum /= (double)nc;
+      interpMat[dir][j*nc + i] = (FLOATTYPE) sum;
+      if (onCoarse) {
+        double err = std::fabs(sum - ((i == ic) ? 1.0 : 0.0));
+        if (err > maxErr) maxErr = err;
+      }
+    }
+
+    if (onCoarse) {
+      if (maxErr > tol) {
+        TxDebugExcept tde("PsSpectralInterp::buildMatrix: fine node ");
+        tde << beg + j << " in direction " << dir;
+        tde << " does not reproduce coarse node " << ic;
+        tde << " (error = " << maxErr << ")";
+        throw tde;
+      }
+      for (size_t i=0; i<nc; ++i) interpMat[dir][j*nc + i] = 0.0;
+      interpMat[dir][j*nc + ic] = 1.0;
+    }
+  }
+}
+
+template class PsSpectralInterp<float>;
+template class PsSpectralInterp<double>;
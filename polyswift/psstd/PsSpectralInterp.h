@@ -0,0 +1,111 @@
+/**
+ * @file    PsSpectralInterp.h
+ *
+ * @brief   Fourier interpolation of periodic grid data onto a finer grid
+ *
+ * @version $Id: PsSpectralInterp.h 6423 2007-01-11 20:32:39Z sizemore $
+ *
+ * Copyright &copy; 2007-2020, Tech-X Corporation, Boulder, CO.
+ * All rights reserved.
+ */
+
+#ifndef PS_SPECTRAL_INTERP_H
+#define PS_SPECTRAL_INTERP_H
+
+// configure stuff
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+// standard includes
+#include <vector>
+#include <cstddef>
+
+// txbase includes
+#include <TxDebugExcept.h>
+
+/**
+ * A PsSpectralInterp object maps periodic data on a coarse grid to a
+ * finer grid whose size is a multiple of the coarse size. Data sits
+ * at the grid nodes x_n = n/N, as sampled by the FFTs. The result is
+ * the trigonometric interpolant of the coarse data, which is the same
+ * as zero-padding the coarse spectrum and transforming back on the
+ * fine grid, so all coarse modes are kept exactly, no new modes are
+ * added and every ratio-th fine node returns the coarse value.
+ *
+ * The interpolant is separable and is applied one direction at a time
+ * with small dense matrices, so only a slab of the fine grid (as held
+ * by one rank) need be formed and no FFT object on the coarse grid is
+ * needed. Data is row-major in (x, y, z); directions with one cell
+ * are passed through.
+ *
+ * @param FLOATTYPE numeric type of the data.
+ */
+template <class FLOATTYPE>
+class PsSpectralInterp {
+
+  public:
+
+/**
+ * Constructor
+ */
+    PsSpectralInterp();
+
+/**
+ * Destructor
+ */
+    virtual ~PsSpectralInterp();
+
+/**
+ * Set the grid sizes and build the interpolation matrices
+ *
+ * @param coarseDims global cells of coarse data (x, y, z)
+ * @param fineDims   global cells of fine grid (x, y, z)
+ * @param fineBeg    first fine cell held locally (x, y, z)
+ * @param fineLen    number of fine cells held locally (x, y, z)
+ */
+    void setDims(const std::vector<size_t>& coarseDims,
+                 const std::vector<size_t>& fineDims,
+                 const std::vector<size_t>& fineBeg,
+                 const std::vector<size_t>& fineLen);
+
+/**
+ * Interpolate the full coarse data to the local part of the fine grid
+ *
+ * @param coarse coarse data, all coarseDims cells
+ * @param fine   local fine data, fineLen cells
+ */
+    void interpolate(const FLOATTYPE* coarse, FLOATTYPE* fine);
+
+  private:
+
+    /** Coarse and local fine sizes by direction */
+    size_t numCoarse[3];
+    size_t numFine[3];
+
+    /** Interpolation matrices (numFine x numCoarse) by direction */
+    std::vector<FLOATTYPE> interpMat[3];
+
+    /** Work space between directional passes */
+    std::vector<FLOATTYPE> workX;
+    std::vector<FLOATTYPE> workY;
+
+    /**
+     * Build the matrix for one direction
+     *
+     * @param dir  direction index
+     * @param nc   global coarse cells
+     * @param nf   global fine cells
+     * @param beg  first local fine cell
+     */
+    void buildMatrix(size_t dir, size_t nc, size_t nf, size_t beg);
+
+    /** Constructor private to prevent use */
+    PsSpectralInterp(const PsSpectralInterp<FLOATTYPE>& psi);
+
+    /** Assignment private to prevent use */
+    PsSpectralInterp<FLOATTYPE>& operator=(
+        const PsSpectralInterp<FLOATTYPE>& psi);
+};
+
+#endif // PS_SPECTRAL_INTERP_H
@@ -0,0 +1,129 @@
+/**
+ * @file    PsThreadPool.cpp
+ *
+ * @brief   Fixed pool of worker threads for running lists of tasks
+ *
+ * @version $Id: PsThreadPool.cpp 6423 2007-01-11 20:32:39Z sizemore $
+ *
+ * Copyright &copy; 2007-2020, Tech-X Corporation, Boulder, CO.
+ * All rights reserved.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#ifdef HAVE_OPENMP
+#include <omp.h>
+#endif
+
+// psstd includes
+#include <PsThreadPool.h>
+
+PsThreadPool::PsThreadPool() {
+  taskList = NULL;
+  nextTask = 0;
+  numDone = 0;
+  generation = 0;
+  stopping = false;
+}
+
+PsThreadPool::~PsThreadPool() {
+  stopWorkers();
+}
+
+void PsThreadPool::setNumThreads(size_t nthreads) {
+
+  stopWorkers();
+  if (nthreads < 1) nthreads = 1;
+
+  stopping = false;
+  for (size_t n=1; n<nthreads; ++n)
+    workers.push_back(std::thread(&PsThreadPool::workerLoop, this));
+}
+
+void PsThreadPool::run(std::vector<std::function<void()> >& tasks) {
+
+  if (tasks.size() == 0) return;
+
+  std::unique_lock<std::mutex> lock(poolMutex);
+  taskList = &tasks;
+  nextTask = 0;
+  numDone = 0;
+  firstError = std::exception_ptr();
+  generation++;
+  startCond.notify_all();
+
+  // Caller works too, then waits for tasks claimed by workers.
+  // Tasks already share the cores so their field loops are serial
+#ifdef HAVE_OPENMP
+  int ompThreads = omp_get_max_threads();
+  omp_set_num_threads(1);
+  drainTasks(lock);
+  omp_set_num_threads(ompThreads);
+#else
+  drainTasks(lock);
+#endif
+  while (numDone < tasks.size()) doneCond.wait(lock);
+
+  taskList = NULL;
+  std::exception_ptr err = firstError;
+  lock.unlock();
+
+  if (err) std::rethrow_exception(err);
+}
+
+void PsThreadPool::workerLoop() {
+
+#ifdef HAVE_OPENMP
+  omp_set_num_threads(1);
+#endif
+
+  std::unique_lock<std::mutex> lock(poolMutex);
+  size_t seenGeneration = generation;
+
+  while (true) {
+    while (!stopping && generation == seenGeneration) startCond.wait(lock);
+    if (stopping) return;
+    seenGeneration = generation;
+    drainTasks(lock);
+  }
+}
+
+//
+// Lock is released while a task runs
+//
+void PsThreadPool::drainTasks(std::unique_lock<std::mutex>& lock) {
+
+  while (taskList && nextTask < taskList->size()) {
+
+    std::function<void()>& task = (*taskList)[nextTask];
+    nextTask++;
+
+    lock.unlock();
+    std::exception_ptr err;
+    try {
+      task();
+    }
+    catch (...) {
+      err = std::current_exception();
+    }
+    lock.lock();
+
+    if (err && !firstError) firstError = err;
+    numDone++;
+    if (numDone == taskList->size()) doneCond.notify_all();
+  }
+}
+
+void PsThreadPool::stopWorkers() {
+
+  {
+    std::unique_lock<std::mutex> lock(poolMutex);
+    stopping = true;
+    startCond.notify_all();
+  }
+
+  for (size_t n=0; n<workers.size(); ++n) workers[n].join();
+  workers.clear();
+}
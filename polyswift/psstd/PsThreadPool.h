@@ -0,0 +1,120 @@
+/**
+ * @file    PsThreadPool.h
+ *
+ * @brief   Fixed pool of worker threads for running lists of tasks
+ *
+ * @version $Id: PsThreadPool.h 6423 2007-01-11 20:32:39Z sizemore $
+ *
+ * Copyright &copy; 2007-2020, Tech-X Corporation, Boulder, CO.
+ * All rights reserved.
+ */
+
+#ifndef PS_THREAD_POOL_H
+#define PS_THREAD_POOL_H
+
+// configure stuff
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+// standard includes
+#include <vector>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+
+/**
+ * A PsThreadPool keeps numThreads-1 worker threads alive between
+ * calls. run() hands a list of independent tasks to the workers and
+ * the calling thread, each thread taking the next unclaimed task
+ * until the list is empty, and returns when all tasks are done.
+ * The first exception thrown by a task is rethrown by run().
+ * With OpenMP, tasks run their parallel loops on one thread so the
+ * pool threads do not oversubscribe the cores.
+ */
+class PsThreadPool {
+
+  public:
+
+/**
+ * Constructor, no workers until setNumThreads
+ */
+    PsThreadPool();
+
+/**
+ * Destructor, joins workers
+ */
+    virtual ~PsThreadPool();
+
+/**
+ * Set total number of threads (including caller of run)
+ *
+ * @param nthreads number of threads
+ */
+    void setNumThreads(size_t nthreads);
+
+/**
+ * Get total number of threads (including caller of run)
+ */
+    size_t getNumThreads() const {
+      return workers.size() + 1;
+    }
+
+/**
+ * Run all tasks and wait for them to finish
+ *
+ * @param tasks list of independent tasks
+ */
+    void run(std::vector<std::function<void()> >& tasks);
+
+  private:
+
+    /** Worker threads */
+    std::vector<std::thread> workers;
+
+    /** Lock for all members below */
+    std::mutex poolMutex;
+
+    /** Signals workers that a task list (or stop) is posted */
+    std::condition_variable startCond;
+
+    /** Signals run() that the last task finished */
+    std::condition_variable doneCond;
+
+    /** Current task list (not owned) */
+    std::vector<std::function<void()> >* taskList;
+
+    /** Index of next unclaimed task */
+    size_t nextTask;
+
+    /** Number of finished tasks */
+    size_t numDone;
+
+    /** Count of posted task lists, wakes sleeping workers */
+    size_t generation;
+
+    /** Flag to end worker loops */
+    bool stopping;
+
+    /** First exception thrown by a task */
+    std::exception_ptr firstError;
+
+    /** Worker thread main loop */
+    void workerLoop();
+
+    /** Claim and run tasks until list is empty, lock held on entry */
+    void drainTasks(std::unique_lock<std::mutex>& lock);
+
+    /** Join and remove all workers */
+    void stopWorkers();
+
+    /** Make private to prevent use */
+    PsThreadPool(const PsThreadPool& ptp);
+
+    /** Make private to prevent use */
+    PsThreadPool& operator=(const PsThreadPool& ptp);
+};
+
+#endif // PS_THREAD_POOL_H
@@ -49,6 +49,10 @@ PsDomain<FLOATTYPE, NDIM>::PsDomain() : PsDomainBase() {
   #endif
 
   dbStatus = PSDB_OFF;
+  tolerance = 0.0;
+  minSteps = 0;
+  numSweepPoints = 0;
+  sweepStartStep = 0;
 }
 
 // destructor
@@ -110,7 +114,42 @@ void PsDomain<FLOATTYPE, NDIM>::setAttrib(const TxHierAttribSetIntDbl& tha,
       std::cout << "nsteps = " << nsteps << std::endl;
     }
   }
-  PsDynObjBase::setNsteps(nsteps);
+
+  // Parameter sweep: nsteps is the limit for each point so
+  // updaters default to applying through all points
+  std::vector<std::string> sweepNames = domainSettings.getNamesOfType("Sweep");
+  if (sweepNames.size() > 1) {
+    TxDebugExcept tde("PsDomain::setAttrib: only one <Sweep> block allowed");
+    throw tde;
+  }
+  if (sweepNames.size() == 1) {
+    TxHierAttribSetIntDbl sweepAttrib =
+      domainSettings.getAttrib(sweepNames[0]);
+    if (!sweepAttrib.hasStrVec("objects") || !sweepAttrib.hasStrVec("params")
+        || !sweepAttrib.hasPrmVec("values")) {
+      TxDebugExcept tde("PsDomain::setAttrib: objects, params and values");
+      tde << " must be set in <Sweep " << sweepNames[0] << " >";
+      throw tde;
+    }
+    sweepObjects = sweepAttrib.getStrVec("objects");
+    sweepParams  = sweepAttrib.getStrVec("params");
+    sweepValues  = sweepAttrib.getPrmVec("values");
+    size_t nobj = sweepObjects.size();
+    if (nobj == 0 || sweepParams.size() != nobj ||
+        sweepValues.size() % nobj != 0) {
+      TxDebugExcept tde("PsDomain::setAttrib: need one param per object and");
+      tde << " a multiple of " << nobj << " values";
+      tde << " in <Sweep " << sweepNames[0] << " >";
+      throw tde;
+    }
+    numSweepPoints = sweepValues.size()/nobj;
+  }
+  if (numSweepPoints > 0) {
+    PsDynObjBase::setNsteps(nsteps*numSweepPoints);
+  }
+  else {
+    PsDynObjBase::setNsteps(nsteps);
+  }
 
   // Number of steps between "big" data output dumps
   if (domainSettings.hasOption("dumpPeriodicity") ) {
@@ -121,6 +160,31 @@ void PsDomain<FLOATTYPE, NDIM>::setAttrib(const TxHierAttribSetIntDbl& tha,
     }
   }
 
+  // Convergence control for early termination
+  if (domainSettings.hasParam("tolerance") ) {
+    tolerance = domainSettings.getParam("tolerance");
+    if (dbStatus==PSDB_ON) {
+      std::cout << "tolerance = " << tolerance << std::endl;
+    }
+  }
+  if (domainSettings.hasOption("minSteps") ) {
+    minSteps = domainSettings.getOption("minSteps");
+  }
+
+  // Restart from a coarser run: grid refinement and its base name
+  if (domainSettings.hasOption("restoreRefine") ) {
+    int refine = domainSettings.getOption("restoreRefine");
+    if (refine < 1) {
+      TxDebugExcept tde("PsDomain::setAttrib: restoreRefine must be >= 1");
+      throw tde;
+    }
+    PsDynObjBase::setRestoreRefine((size_t)refine);
+  }
+  restoreFrom = baseName;
+  if (domainSettings.hasString("restoreFrom") ) {
+    restoreFrom = domainSettings.getString("restoreFrom");
+  }
+
   // Seed (global for now)
   if (domainSettings.hasOption("randomSeed") ) {
     randomSeed = domainSettings.getOption("randomSeed");
@@ -313,6 +377,9 @@ void PsDomain<FLOATTYPE, NDIM>::restore() {
   int tstep = (int)tt;
   txIoPtr->setDumpNo(tstep);
 
+// Dumps may come from another (coarser) run
+  txIoPtr->setBaseName(restoreFrom);
+
 // Restore all total physical fields from "Entities"
 // (ie monomer densities, charge densities, stress etc...)
   physFieldHldr.restore(txIoPtr);
@@ -320,6 +387,9 @@ void PsDomain<FLOATTYPE, NDIM>::restore() {
 // Restore boundaries
   bndryHldr.restore(txIoPtr);
 
+// Following dumps go to this run
+  txIoPtr->setBaseName(baseName);
+
 // Bump the sequence once (keep this in new txbasIO)
   bumpDumpNum();
   txIoPtr->setDumpNo(seqNumber);
@@ -395,6 +465,76 @@ void PsDomain<FLOATTYPE, NDIM>::dump() {
   txIoPtr->setDumpNo(seqNumber);
 }
 
+//
+// Residuals are reduced by the updaters so all ranks agree
+//
+template <class FLOATTYPE, size_t NDIM>
+bool PsDomain<FLOATTYPE, NDIM>::isConverged() {
+
+  if (tolerance <= 0.0) return false;
+  if (PsDynObjBase::getCurrDomainStep() < sweepStartStep + minSteps)
+    return false;
+
+  double res = getResidual();
+  return (res > 0.0) && (res < tolerance);
+}
+
+template <class FLOATTYPE, size_t NDIM>
+double PsDomain<FLOATTYPE, NDIM>::getResidual() {
+  return (double)effHamilHldr.getResidual();
+}
+
+//
+// Objects take the new values before the next update, fields
+// carry over so each point starts from the last one, updater
+// histories are dropped
+//
+template <class FLOATTYPE, size_t NDIM>
+void PsDomain<FLOATTYPE, NDIM>::setSweepPoint(size_t n) {
+
+  if (n >= numSweepPoints) {
+    TxDebugExcept tde("PsDomain::setSweepPoint: sweep point ");
+    tde << n << " >= number of points " << numSweepPoints;
+    throw tde;
+  }
+
+  size_t nobj = sweepObjects.size();
+  for (size_t i=0; i<nobj; ++i) {
+    PsDynObj<FLOATTYPE, NDIM>* objPtr =
+      PsNamedObject::getObject<PsDynObj<FLOATTYPE, NDIM> >(sweepObjects[i]);
+    FLOATTYPE val = (FLOATTYPE)sweepValues[n*nobj + i];
+    objPtr->setSweepParam(sweepParams[i], val);
+
+    if (thisRank == 0) {
+      std::cout << "Sweep point " << n << ": " << sweepObjects[i] << "."
+                << sweepParams[i] << " = " << val << std::endl;
+    }
+  }
+
+  // Updater histories belong to the previous point
+  effHamilHldr.resetHistory();
+
+  // Convergence counts steps from the start of this point
+  sweepStartStep = PsDynObjBase::getCurrDomainStep();
+}
+
+//
+// The FFT objects keep the grid of the source domain, so the
+// cell sizes of this domain must not change (no box relaxation)
+//
+template <class FLOATTYPE, size_t NDIM>
+void PsDomain<FLOATTYPE, NDIM>::shareFFTs(PsDomainBase* src) {
+
+  PsDomain<FLOATTYPE, NDIM>* srcDomain =
+    dynamic_cast<PsDomain<FLOATTYPE, NDIM>*>(src);
+  if (!srcDomain || (srcDomain == this)) {
+    TxDebugExcept tde("PsDomain::shareFFTs: source is not another");
+    tde << " domain of the same type";
+    throw tde;
+  }
+  fftHldr.shareFFTs(srcDomain->fftHldr);
+}
+
 //
 // Instantiate the templates
 //
@@ -115,6 +115,38 @@ class PsDomain : public PsDomainBase {
  */
     virtual void dump();
 
+/**
+ * Check if the last update met the convergence tolerance
+ * (only after minSteps and when tolerance is set)
+ */
+    virtual bool isConverged();
+
+/**
+ * Get largest updater residual from the last update
+ */
+    virtual double getResidual();
+
+/**
+ * Get number of points in the parameter sweep, 0 if no sweep
+ */
+    virtual size_t getNumSweepPoints() {
+      return numSweepPoints;
+    }
+
+/**
+ * Set the swept parameters of one point on all objects
+ *
+ * @param n index of the sweep point
+ */
+    virtual void setSweepPoint(size_t n);
+
+/**
+ * Use the FFT objects of another PsDomain of the same type
+ *
+ * @param src domain owning the FFT objects
+ */
+    virtual void shareFFTs(PsDomainBase* src);
+
   protected:
 
     /** Local debug flag */
@@ -165,6 +197,27 @@ class PsDomain : public PsDomainBase {
     /** Number of steps between "big" data output dumps */
     size_t dumpPeriodicity;
 
+    /** Residual below which the run stops, not used if <= 0 */
+    double tolerance;
+
+    /** Domain step before which the run never stops early */
+    size_t minSteps;
+
+    /** Object names of swept parameters */
+    std::vector<std::string> sweepObjects;
+
+    /** Names of swept parameters, one per sweep object */
+    std::vector<std::string> sweepParams;
+
+    /** Swept values, one row of sweepObjects.size() per point */
+    std::vector<double> sweepValues;
+
+    /** Number of points in the parameter sweep */
+    size_t numSweepPoints;
+
+    /** Domain step at start of the current sweep point */
+    size_t sweepStartStep;
+
     /** The current time step */
     size_t currentStep;
 
@@ -194,6 +247,9 @@ class PsDomain : public PsDomainBase {
 /// Base name for run
     std::string baseName;
 
+/// Base name of run whose dumps are read on restore
+    std::string restoreFrom;
+
 /// Process rank of domain
     int thisRank;
 
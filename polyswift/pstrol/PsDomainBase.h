@@ -83,6 +83,50 @@ class PsDomainBase : public PsNamedObject , public PsDynObjBase {
  */
     virtual void restore() = 0;
 
+/**
+ * Check if the last update met the convergence tolerance.
+ * Never converged by default, ie. the run takes all nsteps
+ */
+    virtual bool isConverged() {
+      return false;
+    }
+
+/**
+ * Get normalized residual from the last update
+ */
+    virtual double getResidual() {
+      return 0.0;
+    }
+
+/**
+ * Get number of points in the parameter sweep, 0 if no sweep
+ */
+    virtual size_t getNumSweepPoints() {
+      return 0;
+    }
+
+/**
+ * Set the parameters of one sweep point, the fields are
+ * kept from the previous point
+ *
+ * @param n index of the sweep point
+ */
+    virtual void setSweepPoint(size_t n) {
+      TxDebugExcept tde("PsDomainBase::setSweepPoint: no parameter sweep");
+      throw tde;
+    }
+
+/**
+ * Use the FFT objects, and so the plans and k-space lists, of another
+ * domain built from the same input. Must be called before buildData
+ *
+ * @param src domain owning the FFT objects
+ */
+    virtual void shareFFTs(PsDomainBase* src) {
+      TxDebugExcept tde("PsDomainBase::shareFFTs: no FFT objects");
+      throw tde;
+    }
+
 // Prevent use of copy constructor and assignment
     PsDomainBase(const PsDomainBase&) = delete;
     PsDomainBase& operator=(const PsDomainBase&) = delete;